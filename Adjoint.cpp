@@ -0,0 +1,453 @@
+/**********************************************************************************************************************
+ * Reverse mode algorithmic differentiation: an operation tape and an adjoint number type that records onto it
+ *********************************************************************************************************************/
+
+#include <cmath>
+
+#include <boost/math/distributions/normal.hpp>
+
+#include "Adjoint.hpp"
+
+thread_local Tape* Tape::current = nullptr;
+
+/**
+ * Initialize a new, empty Tape. The tape does not record until it is activated
+ * @throws OutOfMemoryError Indicates insufficient memory for this new Tape
+ */
+Tape::Tape() : nodes(), adjoints() {}
+
+/**
+ * Initialize a new Tape whose data members are a deep copy of the source
+ * @param source A Tape whose data members will be deeply copied
+ * @throws OutOfMemoryError Indicates insufficient memory for this new Tape
+ */
+Tape::Tape(const Tape &source) : nodes(source.nodes), adjoints(source.adjoints) {}
+
+/**
+ * Destroy this Tape. If it is active on this thread then recording stops
+ */
+Tape::~Tape() {
+    if (current == this) { current = nullptr; }
+}
+
+/**
+ * Deeply copy the source data members into this Tape
+ * @param source A Tape whose data members will be deeply copied
+ * @return This Tape whose data members are a deep copy of the source data members
+ */
+Tape& Tape::operator=(const Tape &source) {
+    // Avoid self assign
+    if (this == &source) { return *this; }
+
+    nodes = source.nodes;
+    adjoints = source.adjoints;
+
+    return *this;
+}
+
+/* ********************************************************************************************************************
+ * Activation
+ *********************************************************************************************************************/
+
+/**
+ * Tape that records operations on the calling thread
+ * @return The active tape, or nullptr if no tape is active
+ */
+Tape* Tape::active() { return current; }
+
+/**
+ * Record every subsequent Adjoint operation on the calling thread onto this tape
+ */
+void Tape::activate() { current = this; }
+
+/**
+ * Stop recording on the calling thread
+ */
+void Tape::deactivate() { current = nullptr; }
+
+/* ********************************************************************************************************************
+ * Recording
+ *********************************************************************************************************************/
+
+/**
+ * Record an independent variable
+ * @return Position of the new node
+ */
+std::size_t Tape::push() {
+    nodes.push_back({{0.0, 0.0}, {0, 0}, 0});
+    return nodes.size() - 1;
+}
+
+/**
+ * Record an operation with one parent
+ * @param parent Position of the operand
+ * @param partial Derivative of the result with respect to the operand
+ * @return Position of the new node
+ */
+std::size_t Tape::push(std::size_t parent, double partial) {
+    nodes.push_back({{partial, 0.0}, {static_cast<std::uint32_t>(parent), 0}, 1});
+    return nodes.size() - 1;
+}
+
+/**
+ * Record an operation with two parents
+ * @param parent0 Position of the first operand
+ * @param partial0 Derivative of the result with respect to the first operand
+ * @param parent1 Position of the second operand
+ * @param partial1 Derivative of the result with respect to the second operand
+ * @return Position of the new node
+ */
+std::size_t Tape::push(std::size_t parent0, double partial0, std::size_t parent1, double partial1) {
+    nodes.push_back({{partial0, partial1},
+                     {static_cast<std::uint32_t>(parent0), static_cast<std::uint32_t>(parent1)}, 2});
+    return nodes.size() - 1;
+}
+
+/* ********************************************************************************************************************
+ * Reverse sweep
+ *********************************************************************************************************************/
+
+/**
+ * Set the adjoint of every recorded node to zero. Call before seeding the outputs of a new sweep
+ */
+void Tape::clearAdjoints() { adjoints.assign(nodes.size(), 0.0); }
+
+/**
+ * Adjoint of a recorded node
+ * @param node Position of the node
+ * @return A reference to the adjoint. Write to it to seed an output and read it after propagate for an input
+ */
+double& Tape::adjoint(std::size_t node) { return adjoints[node]; }
+
+/**
+ * Accumulate the adjoints of every node from the last recorded node back to the first
+ * @note Outputs of independent computations can be seeded together. Their adjoints never mix because they share no
+ * nodes, so one sweep yields the sensitivities of every output to its own inputs
+ */
+void Tape::propagate() {
+    adjoints.resize(nodes.size(), 0.0);
+
+    for (std::size_t i = nodes.size(); i-- > 0;) {
+        double a = adjoints[i];
+        if (a == 0.0) { continue; }
+
+        const Node &n = nodes[i];
+        for (std::uint32_t k = 0; k < n.arity; ++k) {
+            adjoints[n.parent[k]] += n.partial[k] * a;
+        }
+    }
+}
+
+/* ********************************************************************************************************************
+ * Capacity
+ *********************************************************************************************************************/
+
+/**
+ * Number of recorded nodes
+ * @return The size of the tape
+ */
+std::size_t Tape::size() const { return nodes.size(); }
+
+/**
+ * Reserve space for a number of nodes so that recording does not allocate
+ * @param n Number of nodes
+ */
+void Tape::reserve(std::size_t n) {
+    nodes.reserve(n);
+    adjoints.reserve(n);
+}
+
+/**
+ * Discard every recorded node but keep the arena so that the next batch records without allocating
+ */
+void Tape::reset() {
+    nodes.clear();
+    adjoints.clear();
+}
+
+/* ********************************************************************************************************************
+ * Adjoint
+ *********************************************************************************************************************/
+
+/*
+ * Initialize a new Adjoint from a value and a tape position
+ * @param value_ Value
+ * @param node_ Position on the active tape
+ */
+Adjoint::Adjoint(double value_, std::size_t node_) : v(value_), node(node_) {}
+
+/**
+ * Initialize a new Adjoint constant equal to zero
+ */
+Adjoint::Adjoint() : v(0.0), node(constant) {}
+
+/**
+ * Initialize a new Adjoint constant. Constants are not recorded and have no sensitivities
+ * @param value_ Value
+ */
+Adjoint::Adjoint(double value_) : v(value_), node(constant) {}
+
+/**
+ * Initialize a new Adjoint that refers to the same tape node as the source
+ * @param source An Adjoint whose data members will be copied
+ */
+Adjoint::Adjoint(const Adjoint &source) : v(source.v), node(source.node) {}
+
+/**
+ * Destroy this Adjoint. Its tape node remains until the tape is reset
+ */
+Adjoint::~Adjoint() {}
+
+/**
+ * Copy the source data members into this Adjoint
+ * @param source An Adjoint whose data members will be copied
+ * @return This Adjoint
+ */
+Adjoint& Adjoint::operator=(const Adjoint &source) {
+    // Avoid self assign
+    if (this == &source) { return *this; }
+
+    v = source.v;
+    node = source.node;
+
+    return *this;
+}
+
+/**
+ * Add and assign
+ * @param rhs Right hand side
+ * @return This Adjoint
+ */
+Adjoint& Adjoint::operator+=(const Adjoint &rhs) { return *this = *this + rhs; }
+
+/**
+ * Subtract and assign
+ * @param rhs Right hand side
+ * @return This Adjoint
+ */
+Adjoint& Adjoint::operator-=(const Adjoint &rhs) { return *this = *this - rhs; }
+
+/**
+ * Multiply and assign
+ * @param rhs Right hand side
+ * @return This Adjoint
+ */
+Adjoint& Adjoint::operator*=(const Adjoint &rhs) { return *this = *this * rhs; }
+
+/**
+ * Divide and assign
+ * @param rhs Right hand side
+ * @return This Adjoint
+ */
+Adjoint& Adjoint::operator/=(const Adjoint &rhs) { return *this = *this / rhs; }
+
+/**
+ * Record an independent variable on the tape that is active on the calling thread
+ * @param value_ Value of the input
+ * @return The input. Its adjoint holds the sensitivity of the seeded outputs after a reverse sweep
+ */
+Adjoint Adjoint::variable(double value_) { return Adjoint(value_, Tape::active()->push()); }
+
+/**
+ * Value of this Adjoint
+ * @return The value
+ */
+double Adjoint::value() const { return v; }
+
+/**
+ * Adjoint of this number on the active tape
+ * @return A reference to the adjoint
+ */
+double& Adjoint::adjoint() const { return Tape::active()->adjoint(node); }
+
+/**
+ * Test whether this Adjoint is a constant that was never recorded
+ * @return True if this Adjoint has no tape node
+ */
+bool Adjoint::isConstant() const { return node == constant; }
+
+/* ********************************************************************************************************************
+ * Arithmetic
+ *********************************************************************************************************************/
+
+/**
+ * Sum of two numbers
+ * @param x Left operand
+ * @param y Right operand
+ * @return x + y
+ */
+Adjoint operator+(const Adjoint &x, const Adjoint &y) {
+    double value = x.v + y.v;
+    if (x.node == Adjoint::constant) {
+        return y.node == Adjoint::constant ? Adjoint(value) : Adjoint(value, Tape::active()->push(y.node, 1.0));
+    }
+    if (y.node == Adjoint::constant) { return Adjoint(value, Tape::active()->push(x.node, 1.0)); }
+    return Adjoint(value, Tape::active()->push(x.node, 1.0, y.node, 1.0));
+}
+
+/**
+ * Difference of two numbers
+ * @param x Left operand
+ * @param y Right operand
+ * @return x - y
+ */
+Adjoint operator-(const Adjoint &x, const Adjoint &y) {
+    double value = x.v - y.v;
+    if (x.node == Adjoint::constant) {
+        return y.node == Adjoint::constant ? Adjoint(value) : Adjoint(value, Tape::active()->push(y.node, -1.0));
+    }
+    if (y.node == Adjoint::constant) { return Adjoint(value, Tape::active()->push(x.node, 1.0)); }
+    return Adjoint(value, Tape::active()->push(x.node, 1.0, y.node, -1.0));
+}
+
+/**
+ * Product of two numbers
+ * @param x Left operand
+ * @param y Right operand
+ * @return x * y
+ */
+Adjoint operator*(const Adjoint &x, const Adjoint &y) {
+    double value = x.v * y.v;
+    if (x.node == Adjoint::constant) {
+        return y.node == Adjoint::constant ? Adjoint(value) : Adjoint(value, Tape::active()->push(y.node, x.v));
+    }
+    if (y.node == Adjoint::constant) { return Adjoint(value, Tape::active()->push(x.node, y.v)); }
+    return Adjoint(value, Tape::active()->push(x.node, y.v, y.node, x.v));
+}
+
+/**
+ * Quotient of two numbers
+ * @param x Numerator
+ * @param y Denominator
+ * @return x / y
+ */
+Adjoint operator/(const Adjoint &x, const Adjoint &y) {
+    double value = x.v / y.v;
+    if (x.node == Adjoint::constant) {
+        return y.node == Adjoint::constant ? Adjoint(value)
+                                           : Adjoint(value, Tape::active()->push(y.node, -value / y.v));
+    }
+    if (y.node == Adjoint::constant) { return Adjoint(value, Tape::active()->push(x.node, 1.0 / y.v)); }
+    return Adjoint(value, Tape::active()->push(x.node, 1.0 / y.v, y.node, -value / y.v));
+}
+
+/**
+ * Negation
+ * @param x Operand
+ * @return -x
+ */
+Adjoint operator-(const Adjoint &x) {
+    return x.node == Adjoint::constant ? Adjoint(-x.v) : Adjoint(-x.v, Tape::active()->push(x.node, -1.0));
+}
+
+/* ********************************************************************************************************************
+ * Elementary functions
+ *********************************************************************************************************************/
+
+/**
+ * Exponential function
+ * @param x Operand
+ * @return e^x
+ */
+Adjoint exp(const Adjoint &x) {
+    double value = std::exp(x.v);
+    return x.node == Adjoint::constant ? Adjoint(value) : Adjoint(value, Tape::active()->push(x.node, value));
+}
+
+/**
+ * Natural logarithm
+ * @param x Operand
+ * @return ln(x)
+ */
+Adjoint log(const Adjoint &x) {
+    double value = std::log(x.v);
+    return x.node == Adjoint::constant ? Adjoint(value) : Adjoint(value, Tape::active()->push(x.node, 1.0 / x.v));
+}
+
+/**
+ * Square root
+ * @param x Operand
+ * @return sqrt(x)
+ */
+Adjoint sqrt(const Adjoint &x) {
+    double value = std::sqrt(x.v);
+    return x.node == Adjoint::constant ? Adjoint(value)
+                                       : Adjoint(value, Tape::active()->push(x.node, 0.5 / value));
+}
+
+/**
+ * Power function
+ * @param x Base. Must be positive when the exponent is recorded
+ * @param y Exponent
+ * @return x^y
+ */
+Adjoint pow(const Adjoint &x, const Adjoint &y) {
+    double value = std::pow(x.v, y.v);
+    if (x.node == Adjoint::constant) {
+        return y.node == Adjoint::constant ? Adjoint(value)
+                                           : Adjoint(value, Tape::active()->push(y.node, value * std::log(x.v)));
+    }
+    double dx = y.v * std::pow(x.v, y.v - 1.0);
+    if (y.node == Adjoint::constant) { return Adjoint(value, Tape::active()->push(x.node, dx)); }
+    return Adjoint(value, Tape::active()->push(x.node, dx, y.node, value * std::log(x.v)));
+}
+
+/**
+ * Standard normal cumulative distribution function
+ * @param x Operand
+ * @return N(x)
+ */
+Adjoint CDF(const Adjoint &x) {
+    boost::math::normal norm;
+    double value = boost::math::cdf(norm, x.v);
+    return x.node == Adjoint::constant ? Adjoint(value)
+                                       : Adjoint(value, Tape::active()->push(x.node, boost::math::pdf(norm, x.v)));
+}
+
+/**
+ * Standard normal probability density function
+ * @param x Operand
+ * @return n(x)
+ */
+Adjoint PDF(const Adjoint &x) {
+    boost::math::normal norm;
+    double value = boost::math::pdf(norm, x.v);
+    return x.node == Adjoint::constant ? Adjoint(value)
+                                       : Adjoint(value, Tape::active()->push(x.node, -x.v * value));
+}
+
+/* ********************************************************************************************************************
+ * Comparisons on values
+ *********************************************************************************************************************/
+
+/**
+ * Equality of values
+ * @param x Left operand
+ * @param y Right operand
+ * @return True if the values are equal
+ */
+bool operator==(const Adjoint &x, const Adjoint &y) { return x.v == y.v; }
+
+/**
+ * Inequality of values
+ * @param x Left operand
+ * @param y Right operand
+ * @return True if the values differ
+ */
+bool operator!=(const Adjoint &x, const Adjoint &y) { return x.v != y.v; }
+
+/**
+ * Ordering of values
+ * @param x Left operand
+ * @param y Right operand
+ * @return True if the value of x is less than the value of y
+ */
+bool operator<(const Adjoint &x, const Adjoint &y) { return x.v < y.v; }
+
+/**
+ * Ordering of values
+ * @param x Left operand
+ * @param y Right operand
+ * @return True if the value of x is greater than the value of y
+ */
+bool operator>(const Adjoint &x, const Adjoint &y) { return x.v > y.v; }
@@ -0,0 +1,115 @@
+/**********************************************************************************************************************
+ * Reverse mode algorithmic differentiation: an operation tape and an adjoint number type that records onto it
+ *
+ * @note Every arithmetic operation on Adjoint numbers appends one node with its local partial derivatives to the tape
+ * that is active on the calling thread. A single reverse sweep over the tape then accumulates the sensitivities of an
+ * output to every input. The nodes live in a contiguous arena that keeps its capacity when the tape is reset, so a tape
+ * reused across batches stops allocating once it has grown to the size of the largest batch
+ *********************************************************************************************************************/
+
+#ifndef ADJOINT_HPP
+#define ADJOINT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Tape {
+private:
+    // One recorded operation: up to two parents and the partial derivative with respect to each of them
+    struct Node {
+        double partial[2];
+        std::uint32_t parent[2];
+        std::uint32_t arity;
+    };
+
+    std::vector<Node> nodes;                     // Arena of recorded operations
+    std::vector<double> adjoints;                // One adjoint per node
+
+    static thread_local Tape* current;           // Tape that records operations on this thread
+
+public:
+    // Constructors and destructors
+    Tape();
+    Tape(const Tape& source);
+    virtual ~Tape();
+
+    // Operator overloading
+    Tape& operator=(const Tape& source);
+
+    // Activation
+    static Tape* active();
+    void activate();
+    static void deactivate();
+
+    // Recording
+    std::size_t push();
+    std::size_t push(std::size_t parent, double partial);
+    std::size_t push(std::size_t parent0, double partial0, std::size_t parent1, double partial1);
+
+    // Reverse sweep
+    void clearAdjoints();
+    double& adjoint(std::size_t node);
+    void propagate();
+
+    // Capacity
+    std::size_t size() const;
+    void reserve(std::size_t n);
+    void reset();
+};
+
+// Adjoint is a value type with no virtual functions so that it stays two words wide
+class Adjoint {
+private:
+    double v;                                    // Value
+    std::size_t node;                            // Position on the active tape, or constant
+
+    Adjoint(double value_, std::size_t node_);
+
+public:
+    static constexpr std::size_t constant = static_cast<std::size_t>(-1);
+
+    // Constructors and destructors
+    Adjoint();
+    Adjoint(double value_);
+    Adjoint(const Adjoint& source);
+    ~Adjoint();
+
+    // Operator overloading
+    Adjoint& operator=(const Adjoint& source);
+    Adjoint& operator+=(const Adjoint& rhs);
+    Adjoint& operator-=(const Adjoint& rhs);
+    Adjoint& operator*=(const Adjoint& rhs);
+    Adjoint& operator/=(const Adjoint& rhs);
+
+    // Record an independent variable on the active tape
+    static Adjoint variable(double value_);
+
+    // Accessors
+    double value() const;
+    double& adjoint() const;
+    bool isConstant() const;
+
+    // Arithmetic
+    friend Adjoint operator+(const Adjoint& x, const Adjoint& y);
+    friend Adjoint operator-(const Adjoint& x, const Adjoint& y);
+    friend Adjoint operator*(const Adjoint& x, const Adjoint& y);
+    friend Adjoint operator/(const Adjoint& x, const Adjoint& y);
+    friend Adjoint operator-(const Adjoint& x);
+
+    // Elementary functions
+    friend Adjoint exp(const Adjoint& x);
+    friend Adjoint log(const Adjoint& x);
+    friend Adjoint sqrt(const Adjoint& x);
+    friend Adjoint pow(const Adjoint& x, const Adjoint& y);
+    friend Adjoint CDF(const Adjoint& x);
+    friend Adjoint PDF(const Adjoint& x);
+
+    // Comparisons on values
+    friend bool operator==(const Adjoint& x, const Adjoint& y);
+    friend bool operator!=(const Adjoint& x, const Adjoint& y);
+    friend bool operator<(const Adjoint& x, const Adjoint& y);
+    friend bool operator>(const Adjoint& x, const Adjoint& y);
+};
+
+#endif // ADJOINT_HPP
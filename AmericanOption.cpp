@@ -7,6 +7,9 @@
 #ifndef AMERICANOPTION_CPP
 #define AMERICANOPTION_CPP
 
+#include <algorithm>
+#include <cmath>
+
 #include "AmericanOption.hpp"
 
 /**
@@ -118,10 +121,15 @@ void AmericanOption<Mesher_, Matrix_, Output_>::price(double start, double stop,
 
     std::vector<double> mesh = Mesher_::xarr(start, stop, step);     // Generate the mesh points for the matrix
 
-    std::vector<std::vector<double>> matrix = Matrix_::matrix(mesh, property, sig, r, S, K, b);
+    // Price the mesh with the invariants of the sweep hoisted
+    std::vector<double> calls, puts;
+    sweep(mesh, property, sig, r, S, K, b, calls, puts);
 
     // Create and fill containers with option data
-    std::vector<std::vector<double>> prices = price(matrix);
+    std::vector<std::vector<double>> prices;
+    for (std::size_t i = 0; i < calls.size(); ++i) {
+        prices.push_back({calls[i], puts[i]});
+    }
 
     // Send data to an output file
     Output_::csv(mesh, prices);
@@ -185,35 +193,396 @@ AmericanOption<Mesher_, Matrix_, Output_>::price(double sig_, double r_, double
 
     std::vector<std::vector<double>> prices;
 
-    double sig2 = sig_ * sig_;
-    double fac = b_ / sig2 - 0.5;
-    fac *= fac;
-    double y1 = 0.5 - b_ / sig2 + sqrt(fac + 2.0 * r_ / sig2);
-    double y2 = 0.5 - b_ / sig2 - sqrt(fac + 2.0 * r_ / sig2);
-
     // Temp variables create a row for each Call and Put
     double call, put;
+    price(sig_, r_, S_, K_, b_, call, put);
+
+    prices.push_back({call, put});
+    return prices;
+}
+
+/**
+ * Allocation free perpetual American pricing kernel shared by the single option, matrix, and batch pricing functions
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param sig_ Volatility
+ * @param r_ Risk-free rate
+ * @param S_ Spot price
+ * @param K_ Strike price
+ * @param b_ Cost of carry
+ * @param call Receives the Call price
+ * @param put Receives the Put price
+ */
+template<typename Mesher_, typename Matrix_, typename Output_>
+void AmericanOption<Mesher_, Matrix_, Output_>::price(double sig_, double r_, double S_, double K_, double b_,
+        double &call, double &put) {
+    price<double>(sig_, r_, S_, K_, b_, call, put);
+}
+
+/**
+ * Perpetual American pricing kernel generic in the numeric type
+ * @note Instantiated with double by the pricing functions, with Adjoint by sensitivities, and with HyperDual by greeks
+ * and derivatives. Elementary functions are found by argument dependent lookup
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @tparam Real Numeric type
+ * @param sig_ Volatility
+ * @param r_ Risk-free rate
+ * @param S_ Spot price
+ * @param K_ Strike price
+ * @param b_ Cost of carry
+ * @param call Receives the Call price
+ * @param put Receives the Put price
+ */
+template<typename Mesher_, typename Matrix_, typename Output_>
+template<typename Real>
+void AmericanOption<Mesher_, Matrix_, Output_>::price(const Real &sig_, const Real &r_, const Real &S_, const Real &K_,
+        const Real &b_, Real &call, Real &put) {
+    using std::pow;
+
+    Real y1, y2;
+    exponents(sig_, r_, b_, y1, y2);
 
     // Call price
-    if (1.0 == y1) {
+    if (Real(1.0) == y1) {
         call = S_;
     } else {
-        double fac2 = ((y1 - 1.0) * S_) / (y1 * K_);
-        double c = K_ * pow(fac2, y1) / (y1 - 1.0);
+        Real fac2 = ((y1 - Real(1.0)) * S_) / (y1 * K_);
+        Real c = K_ * pow(fac2, y1) / (y1 - Real(1.0));
         call = c;
     }
 
     // Put price
-    if (0.0 == y2) {
+    if (Real(0.0) == y2) {
         put = S_;
     } else {
-        double fac2 = ((y2 - 1.0) * S_) / (y2 * K_);
-        double p = K_ * pow(fac2, y2) / (1.0 - y2);
+        Real fac2 = ((y2 - Real(1.0)) * S_) / (y2 * K_);
+        Real p = K_ * pow(fac2, y2) / (Real(1.0) - y2);
         put = p;
     }
+}
 
-    prices.push_back({call, put});
-    return prices;
+/**
+ * Price a sweep of one property, e.g. the rows of Matrix::matrix(mesh, property, sig, r, S, K, b)
+ * @note The exponents y1 and y2 do not depend on the spot or strike, so a spot or strike sweep finds them once and
+ * writes each price as K / (y - 1) e^(y (log S - log(y K / (y - 1)))), which costs one log and two exponentials per row.
+ * Volatility, risk-free rate, and cost of carry sweeps change the exponents and are priced row by row from the matrix
+ * with the generic kernel
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @tparam Allocator Allocator of the mesh and result vectors, e.g. std::pmr::polymorphic_allocator over an Arena
+ * @param mesh Values of the swept property
+ * @param property The swept property (e.g. sig, r, S, K, b)
+ * @param sig_ Volatility
+ * @param r_ Risk-free rate
+ * @param S_ Spot price
+ * @param K_ Strike price
+ * @param b_ Cost of carry
+ * @param calls Receives one Call price per mesh point. Resized to the size of the mesh
+ * @param puts Receives one Put price per mesh point. Resized to the size of the mesh
+ */
+template<typename Mesher_, typename Matrix_, typename Output_>
+template<typename Allocator>
+void AmericanOption<Mesher_, Matrix_, Output_>::sweep(const std::vector<double, Allocator> &mesh,
+        const std::string &property, double sig_, double r_, double S_, double K_, double b_,
+        std::vector<double, Allocator> &calls, std::vector<double, Allocator> &puts) {
+
+    typename Matrix_::Property swept = Matrix_::property(property);
+
+    if (swept != Matrix_::Property::Spot && swept != Matrix_::Property::Strike) {
+        std::vector<std::vector<double>> matrix = Matrix_::matrix(std::vector<double>(mesh.begin(), mesh.end()),
+                                                                  property, sig_, r_, S_, K_, b_);
+        calls.resize(matrix.size());
+        puts.resize(matrix.size());
+        for (std::size_t i = 0; i < matrix.size(); ++i) {
+            const std::vector<double> &row = matrix[i];
+            price(row[0], row[1], row[2], row[3], row[4], calls[i], puts[i]);
+        }
+        return;
+    }
+
+    std::size_t n = mesh.size();
+    calls.resize(n);
+    puts.resize(n);
+
+    double y1, y2;
+    exponents(sig_, r_, b_, y1, y2);
+
+    // Log of the exercise boundary without its strike, and the price scale without its strike
+    double callBoundary = std::log(y1 / (y1 - 1.0)), callScale = 1.0 / (y1 - 1.0);
+    double putBoundary = std::log(y2 / (y2 - 1.0)), putScale = 1.0 / (1.0 - y2);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        double S = swept == Matrix_::Property::Spot ? mesh[i] : S_;
+        double K = swept == Matrix_::Property::Strike ? mesh[i] : K_;
+        double moneyness = std::log(S / K);
+
+        calls[i] = 1.0 == y1 ? S : K * callScale * std::exp(y1 * (moneyness - callBoundary));
+        puts[i] = 0.0 == y2 ? S : K * putScale * std::exp(y2 * (moneyness - putBoundary));
+    }
+}
+
+/**
+ * Roots of the characteristic equation for the perpetual American option
+ * @note The roots do not depend on the spot or strike price, so a change in spot only rescales the Call and Put prices
+ * by (S'/S)^y1 and (S'/S)^y2 respectively
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param sig_ Volatility
+ * @param r_ Risk-free rate
+ * @param b_ Cost of carry
+ * @param y1 Receives the Call exponent
+ * @param y2 Receives the Put exponent
+ */
+template<typename Mesher_, typename Matrix_, typename Output_>
+void AmericanOption<Mesher_, Matrix_, Output_>::exponents(double sig_, double r_, double b_, double &y1, double &y2) {
+    exponents<double>(sig_, r_, b_, y1, y2);
+}
+
+/**
+ * Roots of the characteristic equation for the perpetual American option, generic in the numeric type
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @tparam Real Numeric type
+ * @param sig_ Volatility
+ * @param r_ Risk-free rate
+ * @param b_ Cost of carry
+ * @param y1 Receives the Call exponent
+ * @param y2 Receives the Put exponent
+ */
+template<typename Mesher_, typename Matrix_, typename Output_>
+template<typename Real>
+void AmericanOption<Mesher_, Matrix_, Output_>::exponents(const Real &sig_, const Real &r_, const Real &b_, Real &y1,
+        Real &y2) {
+    using std::sqrt;
+
+    Real sig2 = sig_ * sig_;
+    Real fac = b_ / sig2 - Real(0.5);
+    fac *= fac;
+    y1 = Real(0.5) - b_ / sig2 + sqrt(fac + Real(2.0) * r_ / sig2);
+    y2 = Real(0.5) - b_ / sig2 - sqrt(fac + Real(2.0) * r_ / sig2);
+}
+
+/**
+ * Price every row in a batch of options without allocating per row
+ * @note The expiry column of the batch is ignored because the expiry of a perpetual American option is infinite
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @tparam Real Numeric type of the batch columns (double or float)
+ * @tparam Allocator Allocator of the result vectors, e.g. std::pmr::polymorphic_allocator over an Arena
+ * @param batch Contiguous columns of option parameters (T, sig, r, S, K, b)
+ * @param calls Receives one Call price per row. Resized to the size of the batch
+ * @param puts Receives one Put price per row. Resized to the size of the batch
+ */
+template<typename Mesher_, typename Matrix_, typename Output_>
+template<typename Real, typename Allocator>
+void AmericanOption<Mesher_, Matrix_, Output_>::price(const BasicOptionBatch<Real> &batch,
+        std::vector<Real, Allocator> &calls, std::vector<Real, Allocator> &puts) {
+
+    std::size_t n = batch.size();
+    calls.resize(n);
+    puts.resize(n);
+
+    const Real *sig_ = batch.vol().data(), *r_ = batch.riskFree().data();
+    const Real *S_ = batch.spot().data(), *K_ = batch.strike().data(), *b_ = batch.carry().data();
+
+    for (std::size_t i = 0; i < n; ++i) {
+        price(sig_[i], r_[i], S_[i], K_[i], b_[i], calls[i], puts[i]);
+    }
+}
+
+/**
+ * Price every contract in a book of compact contract records
+ * @note The expiry of each record is ignored because the expiry of a perpetual American option is infinite
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param contracts Option parameters, one record per contract
+ * @param calls Receives one Call price per contract. Resized to the size of the book
+ * @param puts Receives one Put price per contract. Resized to the size of the book
+ */
+template<typename Mesher_, typename Matrix_, typename Output_>
+void AmericanOption<Mesher_, Matrix_, Output_>::price(const std::vector<Contract> &contracts, std::vector<double> &calls,
+        std::vector<double> &puts) {
+
+    std::size_t n = contracts.size();
+    calls.resize(n);
+    puts.resize(n);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const Contract &c = contracts[i];
+        price(c.sig, c.r, c.S, c.K, c.b, calls[i], puts[i]);
+    }
+}
+
+/**
+ * Prices and the sensitivities to every input of every row in a batch of options by adjoint differentiation
+ * @note Rows are recorded in blocks on a thread local tape whose arena is reset, not reallocated, between blocks. One
+ * reverse sweep per leg yields the sensitivities of every row in the block. The expiry column is ignored and its
+ * sensitivity is zero
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param batch Contiguous columns of option parameters (T, sig, r, S, K, b)
+ * @param calls Receives one Call price per row. Resized to the size of the batch
+ * @param puts Receives one Put price per row. Resized to the size of the batch
+ * @param callSensitivities Receives dC/dT, dC/dsig, dC/dr, dC/dS, dC/dK, and dC/db in the columns that hold T, sig, r,
+ * S, K, and b. Resized to the size of the batch
+ * @param putSensitivities Receives the Put sensitivities in the same layout
+ */
+template<typename Mesher_, typename Matrix_, typename Output_>
+void AmericanOption<Mesher_, Matrix_, Output_>::sensitivities(const OptionBatch &batch, std::vector<double> &calls,
+        std::vector<double> &puts, OptionBatch &callSensitivities, OptionBatch &putSensitivities) {
+
+    const std::size_t block = 128;
+    thread_local Tape tape;
+    thread_local std::vector<Adjoint> inputs(5 * block), outputs(2 * block);
+
+    std::size_t n = batch.size();
+    calls.resize(n);
+    puts.resize(n);
+    callSensitivities.resize(n);
+    putSensitivities.resize(n);
+    std::fill(callSensitivities.expiry().begin(), callSensitivities.expiry().end(), 0.0);
+    std::fill(putSensitivities.expiry().begin(), putSensitivities.expiry().end(), 0.0);
+
+    const std::vector<double> *columns[5] = {&batch.vol(), &batch.riskFree(), &batch.spot(), &batch.strike(),
+                                             &batch.carry()};
+    std::vector<double> *callColumns[5] = {&callSensitivities.vol(), &callSensitivities.riskFree(),
+                                           &callSensitivities.spot(), &callSensitivities.strike(),
+                                           &callSensitivities.carry()};
+    std::vector<double> *putColumns[5] = {&putSensitivities.vol(), &putSensitivities.riskFree(),
+                                          &putSensitivities.spot(), &putSensitivities.strike(),
+                                          &putSensitivities.carry()};
+
+    Tape *previous = Tape::active();
+    tape.activate();
+
+    for (std::size_t first = 0; first < n; first += block) {
+        std::size_t last = std::min(n, first + block);
+        tape.reset();
+
+        // Forward sweep records every row of the block
+        for (std::size_t i = first; i < last; ++i) {
+            Adjoint *x = &inputs[5 * (i - first)];
+            for (std::size_t k = 0; k < 5; ++k) {
+                x[k] = Adjoint::variable((*columns[k])[i]);
+            }
+            Adjoint &call = outputs[2 * (i - first)], &put = outputs[2 * (i - first) + 1];
+            price(x[0], x[1], x[2], x[3], x[4], call, put);
+            calls[i] = call.value();
+            puts[i] = put.value();
+        }
+
+        // One reverse sweep per leg
+        for (std::size_t leg = 0; leg < 2; ++leg) {
+            std::vector<double> **target = leg == 0 ? callColumns : putColumns;
+
+            tape.clearAdjoints();
+            for (std::size_t i = first; i < last; ++i) {
+                outputs[2 * (i - first) + leg].adjoint() = 1.0;
+            }
+            tape.propagate();
+
+            for (std::size_t i = first; i < last; ++i) {
+                const Adjoint *x = &inputs[5 * (i - first)];
+                for (std::size_t k = 0; k < 5; ++k) {
+                    (*target[k])[i] = x[k].adjoint();
+                }
+            }
+        }
+    }
+
+    if (previous) { previous->activate(); } else { Tape::deactivate(); }
+}
+
+/* ********************************************************************************************************************
+ * Exact sensitivities
+ *********************************************************************************************************************/
+
+/**
+ * Exact Call and Put Delta and Gamma
+ * @note The spot price is seeded along both hyper-dual directions, so one evaluation of the pricing kernel gives Delta
+ * and Gamma with no difference parameter
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param sig_ Volatility
+ * @param r_ Risk-free rate
+ * @param S_ Spot price
+ * @param K_ Strike price
+ * @param b_ Cost of carry
+ * @param callDelta Receives the Call Delta
+ * @param putDelta Receives the Put Delta
+ * @param callGamma Receives the Call Gamma
+ * @param putGamma Receives the Put Gamma
+ */
+template<typename Mesher_, typename Matrix_, typename Output_>
+void AmericanOption<Mesher_, Matrix_, Output_>::greeks(double sig_, double r_, double S_, double K_, double b_,
+        double &callDelta, double &putDelta, double &callGamma, double &putGamma) {
+
+    HyperDual call, put;
+    price(HyperDual(sig_), HyperDual(r_), HyperDual(S_, 1.0, 1.0, 0.0), HyperDual(K_), HyperDual(b_), call, put);
+
+    callDelta = call.first();
+    putDelta = put.first();
+    callGamma = call.cross();
+    putGamma = put.cross();
+}
+
+/**
+ * Exact first and second order sensitivities with respect to any two option parameters
+ * @note The pricing kernel is evaluated once on hyper-dual numbers. For example i = j = 2 gives Delta and Gamma and
+ * i = 2, j = 0 gives Delta, Vega, and Vanna
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param option Option parameters sig, r, S, K, b
+ * @param i Position of the first parameter in the option
+ * @param j Position of the second parameter in the option
+ * @param call Receives the Call price, dC/di, dC/dj, and d2C/didj
+ * @param put Receives the Put price, dP/di, dP/dj, and d2P/didj
+ */
+template<typename Mesher_, typename Matrix_, typename Output_>
+void AmericanOption<Mesher_, Matrix_, Output_>::derivatives(const std::vector<double> &option, std::size_t i,
+        std::size_t j, std::vector<double> &call, std::vector<double> &put) {
+
+    HyperDual x[5];
+    for (std::size_t k = 0; k < 5; ++k) {
+        x[k] = HyperDual(option[k], k == i ? 1.0 : 0.0, k == j ? 1.0 : 0.0, 0.0);
+    }
+
+    HyperDual c, p;
+    price(x[0], x[1], x[2], x[3], x[4], c, p);
+
+    call = {c.value(), c.first(), c.second(), c.cross()};
+    put = {p.value(), p.first(), p.second(), p.cross()};
 }
 
 /* ********************************************************************************************************************
@@ -10,8 +10,12 @@
 #define AMERICANOPTION_HPP
 
 #include "vector"
+#include "Adjoint.hpp"
+#include "Contract.hpp"
+#include "HyperDual.hpp"
 #include "Mesher.hpp"
 #include "Matrix.hpp"
+#include "OptionBatch.hpp"
 #include "Output.hpp"
 
 template<typename Mesher_, typename Matrix_, typename Output_>
@@ -42,6 +46,39 @@ public:
     void price(double start, double stop, double step, const std::string& property) const;
     static std::vector<std::vector<double>> price(const std::vector<std::vector<double> >& matrix);
 
+    // Allocation free pricing kernel and batch pricing over contiguous columns of option data
+    static void price(double sig_, double r_, double S_, double K_, double b_, double& call, double& put);
+    static void exponents(double sig_, double r_, double b_, double& y1, double& y2);
+    template<typename Real, typename Allocator>
+    static void price(const BasicOptionBatch<Real>& batch, std::vector<Real, Allocator>& calls,
+                      std::vector<Real, Allocator>& puts);
+
+    // Prices of a book of compact contract records. The expiry of each record is ignored
+    static void price(const std::vector<Contract>& contracts, std::vector<double>& calls, std::vector<double>& puts);
+
+    // Prices along a mesh of one property from a kernel specialized on that property, with its invariants hoisted
+    template<typename Allocator>
+    static void sweep(const std::vector<double, Allocator>& mesh, const std::string& property, double sig_, double r_,
+                      double S_, double K_, double b_, std::vector<double, Allocator>& calls,
+                      std::vector<double, Allocator>& puts);
+
+    // Pricing kernel generic in the numeric type (e.g. double, float, or Adjoint)
+    template<typename Real>
+    static void price(const Real& sig_, const Real& r_, const Real& S_, const Real& K_, const Real& b_, Real& call,
+                      Real& put);
+    template<typename Real>
+    static void exponents(const Real& sig_, const Real& r_, const Real& b_, Real& y1, Real& y2);
+
+    // Prices and every first order sensitivity of a batch from one reverse sweep per leg
+    static void sensitivities(const OptionBatch& batch, std::vector<double>& calls, std::vector<double>& puts,
+                              OptionBatch& callSensitivities, OptionBatch& putSensitivities);
+
+    // Exact Greeks and sensitivities from one hyper-dual evaluation of the pricing kernel
+    static void greeks(double sig_, double r_, double S_, double K_, double b_, double& callDelta, double& putDelta,
+                       double& callGamma, double& putGamma);
+    static void derivatives(const std::vector<double>& option, std::size_t i, std::size_t j, std::vector<double>& call,
+                            std::vector<double>& put);
+
     // Accessors
     double vol() const;
     double riskFree() const;
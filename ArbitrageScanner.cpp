@@ -0,0 +1,329 @@
+/**********************************************************************************************************************
+ * Static arbitrage scanner for snapshots of Call and Put quotes across strikes and expiries of one underlying
+ *********************************************************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+#include "ArbitrageScanner.hpp"
+
+/**
+ * Initialize a new ArbitrageScanner with a tolerance of 1e-5
+ * @throws OutOfMemoryError Indicates insufficient memory for this new ArbitrageScanner
+ */
+ArbitrageScanner::ArbitrageScanner() : ArbitrageScanner(1e-5) {}
+
+/**
+ * Initialize a new ArbitrageScanner whose tolerance and violations are a copy of the source
+ * @param source An ArbitrageScanner whose data members will be copied
+ * @throws OutOfMemoryError Indicates insufficient memory for this new ArbitrageScanner
+ */
+ArbitrageScanner::ArbitrageScanner(const ArbitrageScanner &source) : tol(source.tol), found(source.found), keys(),
+order(), slice(), starts(), T(), K(), C(), P(), forward(), discount(), amount() {}
+
+/**
+ * Initialize a new ArbitrageScanner with the specified tolerance
+ * @param tolerance_ Largest violation that is ignored, in price units, e.g. half a tick
+ * @throws OutOfMemoryError Indicates insufficient memory for this new ArbitrageScanner
+ */
+ArbitrageScanner::ArbitrageScanner(double tolerance_) : tol(tolerance_), found(), keys(), order(), slice(), starts(),
+T(), K(), C(), P(), forward(), discount(), amount() {}
+
+/**
+ * Destroy this ArbitrageScanner
+ */
+ArbitrageScanner::~ArbitrageScanner() {}
+
+/**
+ * Copy the source tolerance and violations into this ArbitrageScanner
+ * @note Scratch columns are not copied. They are rebuilt by the next scan
+ * @param source An ArbitrageScanner whose data members will be copied
+ * @return This ArbitrageScanner whose data members are a copy of the source data members
+ */
+ArbitrageScanner& ArbitrageScanner::operator=(const ArbitrageScanner &source) {
+    // Avoid self assign
+    if (this == &source) { return *this; }
+
+    tol = source.tol;
+    found = source.found;
+
+    return *this;
+}
+
+/* ********************************************************************************************************************
+ * Scanning
+ *********************************************************************************************************************/
+
+/**
+ * Check every static arbitrage constraint on a snapshot of quotes
+ * @note The expiries are checked independently for bounds, parity, vertical spreads, and butterfly spreads, and each
+ * pair of adjacent expiries for calendar spreads. Violations are reported by check, and in expiry and strike order
+ * within a check
+ * @param quotes Call and Put quotes of one underlying. The T, K, call, and put columns must have the same size
+ * @return The number of violations, which are available from violations() until the next scan
+ * @throws std::invalid_argument If the T, K, call, and put columns differ in size
+ */
+std::size_t ArbitrageScanner::scan(const Quotes &quotes) {
+    std::size_t n = quotes.T.size();
+    if (quotes.K.size() != n || quotes.call.size() != n || quotes.put.size() != n) {
+        throw std::invalid_argument("ArbitrageScanner quotes need one expiry, strike, Call, and Put per row");
+    }
+
+    found.clear();
+    sort(quotes);
+
+    bounds();
+    parity();
+    vertical();
+    butterfly();
+    calendar();
+
+    return found.size();
+}
+
+/*
+ * Copy the snapshot into the scratch columns in expiry and strike order, together with the terms of each expiry
+ * @param quotes Call and Put quotes of one underlying
+ */
+void ArbitrageScanner::sort(const Quotes &quotes) {
+    std::size_t n = quotes.T.size();
+
+    order.resize(n);
+    std::iota(order.begin(), order.end(), std::size_t(0));
+
+    // Feeds usually publish chains in order, which saves the sort
+    bool sorted = true;
+    for (std::size_t i = 1; i < n && sorted; ++i) {
+        sorted = quotes.T[i - 1] < quotes.T[i] || (quotes.T[i - 1] == quotes.T[i] && quotes.K[i - 1] <= quotes.K[i]);
+    }
+
+    // Sorting the keys with their rows keeps the comparisons in contiguous memory
+    if (!sorted) {
+        keys.resize(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            keys[i] = Key{quotes.T[i], quotes.K[i], i};
+        }
+        std::sort(keys.begin(), keys.end(), [](const Key &x, const Key &y) {
+            return x.T < y.T || (x.T == y.T && x.K < y.K);
+        });
+        for (std::size_t i = 0; i < n; ++i) {
+            order[i] = keys[i].row;
+        }
+    }
+
+    T.resize(n);
+    K.resize(n);
+    C.resize(n);
+    P.resize(n);
+    forward.resize(n);
+    discount.resize(n);
+    slice.resize(n);
+    amount.resize(n);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        std::size_t row = order[i];
+        T[i] = quotes.T[row];
+        K[i] = quotes.K[row];
+        C[i] = quotes.call[row];
+        P[i] = quotes.put[row];
+    }
+
+    // The discount factors only change with the expiry
+    starts.clear();
+    for (std::size_t i = 0; i < n; ++i) {
+        if (i == 0 || T[i] != T[i - 1]) {
+            starts.push_back(i);
+        }
+    }
+    starts.push_back(n);
+
+    for (std::size_t s = 0; s + 1 < starts.size(); ++s) {
+        double t = T[starts[s]];
+        double F = quotes.S * std::exp((quotes.b - quotes.r) * t), D = std::exp(-quotes.r * t);
+        std::fill(forward.begin() + starts[s], forward.begin() + starts[s + 1], F);
+        std::fill(discount.begin() + starts[s], discount.begin() + starts[s + 1], D);
+        std::fill(slice.begin() + starts[s], slice.begin() + starts[s + 1], static_cast<std::uint32_t>(s));
+    }
+}
+
+/*
+ * Keep the rows of the current pass whose violation exceeds the tolerance
+ * @note Violations are rare, so the branch is well predicted. A NaN amount fails the comparison and is skipped
+ * @param check The constraint of the current pass
+ * @param put True if the pass checked the Put quotes
+ * @param rows Number of rows of the current pass
+ * @param span Number of neighboring strikes in each constraint, which must share an expiry
+ */
+void ArbitrageScanner::collect(Check check, bool put, std::size_t rows, std::size_t span) {
+    const std::size_t none = Violation::none;
+
+    for (std::size_t i = 0; i < rows; ++i) {
+        if (amount[i] > tol && slice[i] == slice[i + span - 1]) {
+            found.push_back(Violation{check, put, order[i], span > 1 ? order[i + 1] : none,
+                                      span > 2 ? order[i + 2] : none, amount[i]});
+        }
+    }
+}
+
+/*
+ * Check that every price lies between its discounted intrinsic value and its upper bound
+ */
+void ArbitrageScanner::bounds() {
+    std::size_t n = T.size();
+    const double *F = forward.data(), *D = discount.data(), *K_ = K.data(), *C_ = C.data(), *P_ = P.data();
+    double *a = amount.data();
+
+    for (std::size_t i = 0; i < n; ++i) {
+        double strike = K_[i] * D[i];
+        a[i] = std::max(std::max(F[i] - strike, 0.0) - C_[i], C_[i] - F[i]);
+    }
+    collect(Check::Bounds, false, n, 1);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        double strike = K_[i] * D[i];
+        a[i] = std::max(std::max(strike - F[i], 0.0) - P_[i], P_[i] - strike);
+    }
+    collect(Check::Bounds, true, n, 1);
+}
+
+/*
+ * Check Put-Call parity, C - P = S e^((b-r)T) - K e^(-rT), for every strike quoted on both legs
+ */
+void ArbitrageScanner::parity() {
+    std::size_t n = T.size();
+    const double *F = forward.data(), *D = discount.data(), *K_ = K.data(), *C_ = C.data(), *P_ = P.data();
+    double *a = amount.data();
+
+    for (std::size_t i = 0; i < n; ++i) {
+        a[i] = std::abs(C_[i] - P_[i] - (F[i] - K_[i] * D[i]));
+    }
+    collect(Check::Parity, false, n, 1);
+}
+
+/*
+ * Check every pair of neighboring strikes. Calls must not rise with the strike and Puts must not fall, and neither may
+ * change by more than the discounted change in strike
+ */
+void ArbitrageScanner::vertical() {
+    std::size_t n = T.size();
+    if (n < 2) { return; }
+
+    const double *D = discount.data(), *K_ = K.data(), *C_ = C.data(), *P_ = P.data();
+    double *a = amount.data();
+
+    for (std::size_t i = 0; i + 1 < n; ++i) {
+        double width = D[i] * (K_[i + 1] - K_[i]);
+        a[i] = std::max(C_[i + 1] - C_[i], C_[i] - C_[i + 1] - width);
+    }
+    collect(Check::Vertical, false, n - 1, 2);
+
+    for (std::size_t i = 0; i + 1 < n; ++i) {
+        double width = D[i] * (K_[i + 1] - K_[i]);
+        a[i] = std::max(P_[i] - P_[i + 1], P_[i + 1] - P_[i] - width);
+    }
+    collect(Check::Vertical, true, n - 1, 2);
+}
+
+/*
+ * Check every triple of neighboring strikes. The middle price must not exceed the line through its neighbors
+ * @note The amount is the excess of the middle price over the line. Repeated strikes give 0 / 0, which is skipped
+ */
+void ArbitrageScanner::butterfly() {
+    std::size_t n = T.size();
+    if (n < 3) { return; }
+
+    const double *K_ = K.data(), *C_ = C.data(), *P_ = P.data();
+    double *a = amount.data();
+
+    for (std::size_t i = 0; i + 2 < n; ++i) {
+        double lower = K_[i + 1] - K_[i], upper = K_[i + 2] - K_[i + 1];
+        a[i] = ((lower + upper) * C_[i + 1] - upper * C_[i] - lower * C_[i + 2]) / (lower + upper);
+    }
+    collect(Check::Butterfly, false, n - 2, 3);
+
+    for (std::size_t i = 0; i + 2 < n; ++i) {
+        double lower = K_[i + 1] - K_[i], upper = K_[i + 2] - K_[i + 1];
+        a[i] = ((lower + upper) * P_[i + 1] - upper * P_[i] - lower * P_[i + 2]) / (lower + upper);
+    }
+    collect(Check::Butterfly, true, n - 2, 3);
+}
+
+/*
+ * Check every quote against the next expiry at the same forward moneyness
+ * @note Strikes are expressed as K e^(-rT) / (S e^((b-r)T)), the strike over the forward, and prices of the later
+ * expiry are scaled by the ratio of the two values of S e^((b-r)T), so the amount is in price units of the earlier
+ * expiry. Both expiries are sorted by strike, so the neighbors of a quote in the later expiry are found by one merge
+ * over the two expiries. Quotes outside the strikes of the later expiry are not checked
+ */
+void ArbitrageScanner::calendar() {
+    std::size_t n = T.size();
+    const double *F = forward.data(), *D = discount.data(), *K_ = K.data();
+
+    // Forward moneyness of every row
+    double *m = amount.data();
+    for (std::size_t i = 0; i < n; ++i) {
+        m[i] = K_[i] * D[i] / F[i];
+    }
+
+    for (std::size_t s = 0; s + 2 < starts.size(); ++s) {
+        std::size_t j = starts[s + 1], last = starts[s + 2];
+        double ratio = F[starts[s]] / F[j];
+
+        for (std::size_t i = starts[s]; i < starts[s + 1]; ++i) {
+            while (j + 2 < last && m[j + 1] < m[i]) { ++j; }
+            if (j + 1 >= last || m[i] < m[j] || m[i] > m[j + 1]) { continue; }
+
+            double width = m[j + 1] - m[j];
+            double w = width > 0.0 ? (m[i] - m[j]) / width : 0.0;
+
+            double call = C[i] - ratio * ((1.0 - w) * C[j] + w * C[j + 1]);
+            double put = P[i] - ratio * ((1.0 - w) * P[j] + w * P[j + 1]);
+
+            if (call > tol) {
+                found.push_back(Violation{Check::Calendar, false, order[i], order[j], order[j + 1], call});
+            }
+            if (put > tol) {
+                found.push_back(Violation{Check::Calendar, true, order[i], order[j], order[j + 1], put});
+            }
+        }
+    }
+}
+
+/* ********************************************************************************************************************
+ * Accessors
+ *********************************************************************************************************************/
+
+/**
+ * Violations of the last snapshot
+ * @return Every violation that exceeded the tolerance, in the order they were found
+ */
+const std::vector<ArbitrageScanner::Violation>& ArbitrageScanner::violations() const { return found; }
+
+/**
+ * Number of violations of one constraint in the last snapshot
+ * @param check The constraint
+ * @return The number of violations of that constraint on either leg
+ */
+std::size_t ArbitrageScanner::count(Check check) const {
+    return static_cast<std::size_t>(std::count_if(found.begin(), found.end(), [check](const Violation &v) {
+        return v.check == check;
+    }));
+}
+
+/**
+ * Accessor that retrieves the tolerance of this ArbitrageScanner
+ * @return Largest violation that is ignored, in price units
+ */
+double ArbitrageScanner::tolerance() const { return tol; }
+
+/* ********************************************************************************************************************
+ * Mutators
+ *********************************************************************************************************************/
+
+/**
+ * Mutator that sets the tolerance of this ArbitrageScanner
+ * @param tolerance_ Largest violation that is ignored, in price units, e.g. half a tick
+ */
+void ArbitrageScanner::tolerance(double tolerance_) { tol = tolerance_; }
@@ -0,0 +1,102 @@
+/**********************************************************************************************************************
+ * Static arbitrage scanner for snapshots of Call and Put quotes across strikes and expiries of one underlying
+ *
+ * @note Quotes are sorted by expiry and strike, or left in place if they arrive sorted, and copied into contiguous
+ * columns together with the discounted forward and discount factor of their expiry. Each check is then a branch free
+ * pass over the sorted columns that writes the size of the violation of every quote, or of every pair or triple of
+ * neighboring strikes, followed by a compaction pass that keeps the few that exceed the tolerance:
+ * - Bounds: with F = S e^((b-r)T) and D = e^(-rT), max(F - K D, 0) <= C <= F and max(K D - F, 0) <= P <= K D
+ * - Parity: C - P = F - K D
+ * - Vertical spreads: Calls fall and Puts rise with the strike, by at most e^(-rT) per unit of strike
+ * - Butterfly spreads: Calls and Puts are convex in the strike
+ * - Calendar spreads: at a fixed forward moneyness K D / F, prices as a fraction of F do not fall with the expiry. The
+ * later expiry is interpolated linearly between its neighboring strikes, which can only overstate a convex price, so
+ * every reported calendar violation is a real one
+ * A NaN marks a missing quote and is skipped by every check that uses it. Scratch columns keep their capacity between
+ * snapshots, so a scanner that is reused across snapshots of similar size allocates only for its violations
+ *********************************************************************************************************************/
+
+#ifndef ARBITRAGESCANNER_HPP
+#define ARBITRAGESCANNER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class ArbitrageScanner {
+public:
+    enum class Check : unsigned char { Bounds, Parity, Vertical, Butterfly, Calendar };
+
+    // Call and Put quotes of one underlying, one row per strike and expiry
+    struct Quotes {
+        double S;                                // Spot price
+        double r;                                // Risk-free interest rate
+        double b;                                // Cost of carry
+        std::vector<double> T;                   // Expiry of each row
+        std::vector<double> K;                   // Strike of each row
+        std::vector<double> call;                // Call price of each row, or NaN if not quoted
+        std::vector<double> put;                 // Put price of each row, or NaN if not quoted
+    };
+
+    // One violated constraint. Quotes are rows of the snapshot as it was passed in
+    struct Violation {
+        static constexpr std::size_t none = static_cast<std::size_t>(-1);
+
+        Check check;
+        bool put;                                // Violated by the Put quotes, or by the Call quotes
+        std::size_t first, second, third;        // Rows involved, in strike order, or none
+        double amount;                           // Size of the violation in price units
+    };
+
+private:
+    // Sort key of one row of a snapshot
+    struct Key {
+        double T, K;
+        std::size_t row;
+    };
+
+    double tol;                                  // Largest violation that is ignored, in price units
+    std::vector<Violation> found;                // Violations of the last snapshot
+
+    // Scratch columns of the last snapshot in expiry and strike order
+    std::vector<Key> keys;                       // Expiry and strike of each row, sorted if the snapshot is not
+    std::vector<std::size_t> order;              // Row of the snapshot
+    std::vector<std::uint32_t> slice;            // Index of the expiry
+    std::vector<std::size_t> starts;             // First row of each expiry, and one past the last row
+    std::vector<double> T, K, C, P;
+    std::vector<double> forward;                 // S e^((b-r)T)
+    std::vector<double> discount;                // e^(-rT)
+    std::vector<double> amount;                  // Size of the violation of each row in the current pass
+
+    // Helper functions
+    void sort(const Quotes& quotes);
+    void collect(Check check, bool put, std::size_t rows, std::size_t span);
+    void bounds();
+    void parity();
+    void vertical();
+    void butterfly();
+    void calendar();
+
+public:
+    // Constructors and destructors
+    ArbitrageScanner();
+    ArbitrageScanner(const ArbitrageScanner& source);
+    explicit ArbitrageScanner(double tolerance_);
+    virtual ~ArbitrageScanner();
+
+    // Operator overloading
+    ArbitrageScanner& operator=(const ArbitrageScanner& source);
+
+    // Check every constraint on a snapshot and return the number of violations
+    std::size_t scan(const Quotes& quotes);
+
+    // Accessors
+    const std::vector<Violation>& violations() const;
+    std::size_t count(Check check) const;
+    double tolerance() const;
+
+    // Mutators
+    void tolerance(double tolerance_);
+};
+
+#endif // ARBITRAGESCANNER_HPP
@@ -0,0 +1,122 @@
+/**********************************************************************************************************************
+ * Monotonic arena of 64-byte aligned memory for batch results and temporary buffers
+ *********************************************************************************************************************/
+
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+
+#include "Arena.hpp"
+
+/**
+ * Initialize a new empty Arena
+ * @param blockSize_ Smallest block requested from the heap. Larger requests get a block of their own size
+ * @throws OutOfMemoryError Indicates insufficient memory for this new Arena
+ */
+Arena::Arena(std::size_t blockSize_) : blocks(), current(0), offset(0), blockSize(std::max(blockSize_, alignment)),
+requested(0), heapAllocations(0) {}
+
+/**
+ * Destroy this Arena and return its blocks to the heap
+ */
+Arena::~Arena() {
+    release();
+}
+
+/* ********************************************************************************************************************
+ * Allocation
+ *********************************************************************************************************************/
+
+/*
+ * Hand out the next aligned range of the current block, moving on to a later block or a new one if it does not fit
+ * @param bytes Size of the request
+ * @param align Alignment of the request. Every range is 64-byte aligned, which serves any alignment up to 64
+ * @return Start of the range
+ * @throws std::invalid_argument If the alignment is larger than 64 bytes, which a recycled block cannot guarantee
+ */
+void* Arena::do_allocate(std::size_t bytes, std::size_t align) {
+    if (align > alignment) { throw std::invalid_argument("Arena allocations are aligned to at most 64 bytes"); }
+
+    for (; current < blocks.size(); ++current, offset = 0) {
+        std::size_t start = (offset + alignment - 1) / alignment * alignment;
+        if (start + bytes <= blocks[current].size) {
+            offset = start + bytes;
+            requested += bytes;
+            return blocks[current].data + start;
+        }
+    }
+
+    // Blocks are 64-byte aligned, so the new block serves the request from its start
+    std::size_t size = std::max(blockSize, (bytes + alignment - 1) / alignment * alignment);
+    char *data = static_cast<char *>(::operator new(size, std::align_val_t(alignment)));
+    blocks.push_back(Block{data, size});
+    ++heapAllocations;
+
+    current = blocks.size() - 1;
+    offset = bytes;
+    requested += bytes;
+    return data;
+}
+
+/*
+ * Memory is only reclaimed by reset or release
+ */
+void Arena::do_deallocate(void *, std::size_t, std::size_t) {}
+
+/*
+ * Memory from one Arena can only be returned to that Arena
+ * @param other Another memory resource
+ * @return True if other is this Arena
+ */
+bool Arena::do_is_equal(const std::pmr::memory_resource &other) const noexcept {
+    return this == &other;
+}
+
+/**
+ * Rewind to the start of the first block. Every block is kept for the next run
+ * @note Containers that still hold memory from this Arena must not be used after a reset
+ */
+void Arena::reset() {
+    current = 0;
+    offset = 0;
+    requested = 0;
+}
+
+/**
+ * Return every block to the heap
+ */
+void Arena::release() {
+    for (const Block &block : blocks) {
+        ::operator delete(block.data, std::align_val_t(alignment));
+    }
+    blocks.clear();
+    reset();
+}
+
+/* ********************************************************************************************************************
+ * Statistics
+ *********************************************************************************************************************/
+
+/**
+ * Total size of the blocks held by this Arena
+ * @return Bytes held, whether in use or not
+ */
+std::size_t Arena::capacity() const {
+    std::size_t total = 0;
+    for (const Block &block : blocks) {
+        total += block.size;
+    }
+    return total;
+}
+
+/**
+ * Memory handed out since the last reset
+ * @return Bytes requested, not counting alignment padding
+ */
+std::size_t Arena::used() const { return requested; }
+
+/**
+ * Number of blocks requested from the heap since this Arena was constructed
+ * @return The heap allocation count. It stays constant once repeated runs reach a steady state
+ */
+std::size_t Arena::allocations() const { return heapAllocations; }
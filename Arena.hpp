@@ -0,0 +1,60 @@
+/**********************************************************************************************************************
+ * Monotonic arena of 64-byte aligned memory for batch results and temporary buffers
+ *
+ * @note An Arena is a std::pmr::memory_resource, so std::pmr::vector and any container with a polymorphic allocator can
+ * draw from it. An allocation bumps a cursor through the current block and a deallocation does nothing. reset() rewinds
+ * the cursor and keeps every block, so a repeated sweep whose buffers fit in the blocks of its first run makes no heap
+ * allocations at all. Every allocation is aligned to a cache line, which is also the width of an AVX-512 register.
+ * Requests for a stricter alignment throw, since a recycled block only guarantees 64 bytes
+ *********************************************************************************************************************/
+
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+class Arena : public std::pmr::memory_resource {
+public:
+    static constexpr std::size_t alignment = 64;
+
+private:
+    struct Block {
+        char* data;
+        std::size_t size;
+    };
+
+    std::vector<Block> blocks;                   // Blocks kept across resets
+    std::size_t current;                         // Block being filled
+    std::size_t offset;                          // Bytes used in the current block
+    std::size_t blockSize;                       // Smallest block requested from the heap
+    std::size_t requested;                       // Bytes handed out since the last reset
+    std::size_t heapAllocations;                 // Blocks requested from the heap since construction
+
+protected:
+    // std::pmr::memory_resource interface
+    void* do_allocate(std::size_t bytes, std::size_t align) override;
+    void do_deallocate(void* p, std::size_t bytes, std::size_t align) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+public:
+    // Constructors and destructors
+    explicit Arena(std::size_t blockSize_ = 1 << 20);
+    Arena(const Arena& source) = delete;
+    virtual ~Arena();
+
+    // Operator overloading
+    Arena& operator=(const Arena& source) = delete;
+
+    // Rewind to the first block and keep every block, or return every block to the heap
+    void reset();
+    void release();
+
+    // Statistics
+    std::size_t capacity() const;
+    std::size_t used() const;
+    std::size_t allocations() const;
+};
+
+#endif // ARENA_HPP
@@ -0,0 +1,383 @@
+/**********************************************************************************************************************
+ * Correlated multi-asset Monte Carlo for European basket, spread, best-of, and worst-of options
+ *********************************************************************************************************************/
+
+#ifndef BASKETENGINE_CPP
+#define BASKETENGINE_CPP
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "BasketEngine.hpp"
+#include "Cholesky.hpp"
+#include "Parallel.hpp"
+
+/**
+ * Initialize a new BasketEngine on two uncorrelated assets
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @throws OutOfMemoryError Indicates insufficient memory for this new BasketEngine
+ */
+template<typename RNG_>
+BasketEngine<RNG_>::BasketEngine() : spots(2, 100.0), vols(2, 0.2), carries(2, 0.0),
+correlation({{1.0, 0.0}, {0.0, 1.0}}), cholesky({1.0, 0.0, 0.0, 1.0}), r(0.0), T(1.0), paths(100000), block(0),
+seed(1), standardError(0.0), reduction(1.0) {}
+
+/**
+ * Initialize a new BasketEngine whose data members are a deep copy of the source
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @param source A BasketEngine whose data members will be deeply copied
+ * @throws OutOfMemoryError Indicates insufficient memory for this new BasketEngine
+ */
+template<typename RNG_>
+BasketEngine<RNG_>::BasketEngine(const BasketEngine<RNG_> &source) : spots(source.spots), vols(source.vols),
+carries(source.carries), correlation(source.correlation), cholesky(source.cholesky), r(source.r), T(source.T),
+paths(source.paths), block(source.block), seed(source.seed), standardError(source.standardError),
+reduction(source.reduction) {}
+
+/**
+ * Initialize a new BasketEngine with the specified market data
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @param spots_ Spot price of each asset
+ * @param vols_ Volatility of each asset
+ * @param carries_ Cost of carry of each asset
+ * @param correlation_ Correlation matrix of the assets
+ * @param r_ Risk-free interest rate
+ * @param T_ Expiry time/maturity
+ * @throws std::invalid_argument If there are no assets, the volatilities, carries, or correlation matrix do not have
+ * one entry per asset, or the correlation matrix is not positive definite
+ */
+template<typename RNG_>
+BasketEngine<RNG_>::BasketEngine(const std::vector<double> &spots_, const std::vector<double> &vols_,
+        const std::vector<double> &carries_, const std::vector<std::vector<double>> &correlation_, double r_,
+        double T_) : BasketEngine() {
+
+    std::size_t m = spots_.size();
+    bool square = correlation_.size() == m;
+    for (const auto &row : correlation_) { square = square && row.size() == m; }
+    if (m == 0 || vols_.size() != m || carries_.size() != m || !square) {
+        throw std::invalid_argument("A basket needs one volatility, carry, and correlation row and column per asset");
+    }
+
+    spots = spots_;
+    vols = vols_;
+    carries = carries_;
+    correlation = correlation_;
+    cholesky = Cholesky::packed(correlation);
+    r = r_;
+    T = T_;
+}
+
+/**
+ * Destroy this BasketEngine
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ */
+template<typename RNG_>
+BasketEngine<RNG_>::~BasketEngine() {}
+
+/**
+ * Deeply copy the source data members into this BasketEngine
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @param source A BasketEngine whose data members will be deeply copied
+ * @return This BasketEngine whose data members are a deep copy of the source data members
+ */
+template<typename RNG_>
+BasketEngine<RNG_>& BasketEngine<RNG_>::operator=(const BasketEngine<RNG_> &source) {
+    // Avoid self assign
+    if (this == &source) { return *this; }
+
+    spots = source.spots;
+    vols = source.vols;
+    carries = source.carries;
+    correlation = source.correlation;
+    cholesky = source.cholesky;
+    r = source.r;
+    T = source.T;
+    paths = source.paths;
+    block = source.block;
+    seed = source.seed;
+    standardError = source.standardError;
+    reduction = source.reduction;
+
+    return *this;
+}
+
+/* ********************************************************************************************************************
+ * Path generation
+ *********************************************************************************************************************/
+
+/**
+ * Number of blocks of paths
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @return The number of blocks that generate(j, x, S) accepts
+ */
+template<typename RNG_>
+std::size_t BasketEngine<RNG_>::blocks() const {
+    std::size_t B = width();
+    return (paths + B - 1) / B;
+}
+
+/**
+ * Correlated normals and terminal spots of one block of paths
+ * @note The variates are correlated in place from the last asset to the first, since row a of the result only needs
+ * rows 0 to a of the independent variates. Every inner loop runs over the contiguous paths of one asset
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @param j Block index in [0, blocks()). Block j is seeded with seed + j
+ * @param x Receives the correlated standard normals, asset-major: x[a * count + p]
+ * @param S Receives the terminal spots in the same layout
+ */
+template<typename RNG_>
+void BasketEngine<RNG_>::generate(std::size_t j, std::vector<double> &x, std::vector<double> &S) const {
+
+    std::size_t m = spots.size(), B = width();
+    std::size_t p0 = j * B, count = std::min(paths, p0 + B) - p0;
+
+    x.resize(m * count);
+    S.resize(m * count);
+    RNG_::MersenneTwister(x, seed + static_cast<unsigned int>(j));
+
+    for (std::size_t a = m; a-- > 0;) {
+        double *xa = x.data() + a * count;
+        const double *La = cholesky.data() + a * m;
+
+        for (std::size_t p = 0; p < count; ++p) { xa[p] *= La[a]; }
+        for (std::size_t v = 0; v < a; ++v) {
+            const double *zv = x.data() + v * count;
+            double l = La[v];
+            for (std::size_t p = 0; p < count; ++p) { xa[p] += l * zv[p]; }
+        }
+    }
+
+    for (std::size_t a = 0; a < m; ++a) {
+        double scale = vols[a] * sqrt(T);
+        double forward = spots[a] * exp((carries[a] - 0.5 * vols[a] * vols[a]) * T);
+        const double *xa = x.data() + a * count;
+        double *Sa = S.data() + a * count;
+        for (std::size_t p = 0; p < count; ++p) { Sa[p] = forward * exp(scale * xa[p]); }
+    }
+}
+
+/* ********************************************************************************************************************
+ * Core pricing functionality
+ *********************************************************************************************************************/
+
+/**
+ * Price of a Call or Put on a function of the assets at expiry
+ * @note Basket: sum of w_a S_a. Spread: S_0 - S_1, with Kirk's approximation as a control variate. BestOf and WorstOf:
+ * the largest and smallest S_a. Blocks are partitioned across threads and the sums of every block are reduced in block
+ * order, so the result does not depend on the number of threads
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @param payoff Basket, Spread, BestOf, or WorstOf
+ * @param type Call or Put
+ * @param K_ Strike price
+ * @param weights Basket weights. Empty for an equally weighted basket. Ignored by the other payoffs
+ * @return The price estimate. Its standard error is available from error()
+ * @throws std::invalid_argument If a spread is requested on fewer than two assets, or the weights are neither empty nor
+ * one per asset
+ */
+template<typename RNG_>
+double BasketEngine<RNG_>::price(Payoff payoff, Portfolio::OptionType type, double K_,
+                                 const std::vector<double> &weights) {
+
+    std::size_t m = spots.size(), n = blocks();
+    if (payoff == Payoff::Spread && m < 2) { throw std::invalid_argument("A spread needs two assets"); }
+    if (!weights.empty() && weights.size() != assets()) {
+        throw std::invalid_argument("A basket needs one weight per asset");
+    }
+
+    std::vector<double> w = weights;
+    if (w.empty()) { w.assign(m, 1.0 / static_cast<double>(m)); }
+
+    bool call = type == Portfolio::OptionType::Call;
+    double discount = exp(-r * T);
+
+    // Kirk's lognormal proxy of S_0 / (S_1 + K), driven by the same draws as the spread. Its discounted payoff has the
+    // expectation of Kirk's price, so the proxy is a control variate with a known mean
+    bool control = payoff == Payoff::Spread;
+    double kirkCall = 0.0, kirkPut = 0.0, kirkVol = 0.0, shift = 0.0, ratio = 0.0, level = 0.0;
+    if (control) {
+        double F1 = spots[0] * exp(carries[0] * T), F2 = spots[1] * exp(carries[1] * T);
+        shift = F2 / (F2 + K_);
+        kirkVol = sqrt(vols[0] * vols[0] - 2.0 * correlation[0][1] * vols[0] * vols[1] * shift
+                       + vols[1] * vols[1] * shift * shift);
+        ratio = F1 / (F2 + K_) * exp(-0.5 * kirkVol * kirkVol * T);
+        level = discount * (F2 + K_);
+        control = F2 + K_ > 0.0 && kirkVol > 0.0;
+        kirk(T, r, spots[0], spots[1], K_, vols[0], vols[1], correlation[0][1], carries[0], carries[1], kirkCall,
+             kirkPut);
+    }
+
+    // Sums of y, y^2, c, c^2, and y c over every block, where y is the discounted payoff and c the control
+    std::vector<double> sums(n * 5, 0.0);
+
+    Parallel::forRange(n, [&](std::size_t, std::size_t first, std::size_t last) {
+        std::vector<double> x, S, u;
+        for (std::size_t j = first; j < last; ++j) {
+            generate(j, x, S);
+            std::size_t count = S.size() / m;
+
+            // Reduce the assets of every path to one underlying value
+            u.assign(S.begin(), S.begin() + count);
+            if (payoff == Payoff::Basket) {
+                for (std::size_t p = 0; p < count; ++p) { u[p] *= w[0]; }
+            }
+            for (std::size_t a = 1; a < m; ++a) {
+                const double *Sa = S.data() + a * count;
+                if (payoff == Payoff::Basket) {
+                    for (std::size_t p = 0; p < count; ++p) { u[p] += w[a] * Sa[p]; }
+                } else if (payoff == Payoff::Spread) {
+                    if (a > 1) { break; }
+                    for (std::size_t p = 0; p < count; ++p) { u[p] -= Sa[p]; }
+                } else if (payoff == Payoff::BestOf) {
+                    for (std::size_t p = 0; p < count; ++p) { u[p] = std::max(u[p], Sa[p]); }
+                } else {
+                    for (std::size_t p = 0; p < count; ++p) { u[p] = std::min(u[p], Sa[p]); }
+                }
+            }
+
+            double *sum = sums.data() + j * 5;
+            for (std::size_t p = 0; p < count; ++p) {
+                double y = discount * (call ? std::max(u[p] - K_, 0.0) : std::max(K_ - u[p], 0.0));
+                sum[0] += y;
+                sum[1] += y * y;
+            }
+
+            if (control) {
+                const double *x0 = x.data(), *x1 = x.data() + count;
+                double a0 = vols[0] * sqrt(T), a1 = vols[1] * shift * sqrt(T);
+                for (std::size_t p = 0; p < count; ++p) {
+                    double Z = ratio * exp(a0 * x0[p] - a1 * x1[p]);
+                    double c = level * (call ? std::max(Z - 1.0, 0.0) : std::max(1.0 - Z, 0.0));
+                    double y = discount * (call ? std::max(u[p] - K_, 0.0) : std::max(K_ - u[p], 0.0));
+                    sum[2] += c;
+                    sum[3] += c * c;
+                    sum[4] += y * c;
+                }
+            }
+        }
+    }, 1);
+
+    // Reduce in block order so that the estimate does not depend on the number of threads
+    double total[5] = {0.0, 0.0, 0.0, 0.0, 0.0};
+    for (std::size_t j = 0; j < n; ++j) {
+        for (std::size_t i = 0; i < 5; ++i) {
+            total[i] += sums[j * 5 + i];
+        }
+    }
+
+    double N = static_cast<double>(paths);
+    double meanY = total[0] / N, varY = std::max(total[1] / N - meanY * meanY, 0.0);
+    double value = meanY, variance = varY;
+
+    if (control) {
+        double meanC = total[2] / N, varC = total[3] / N - meanC * meanC, cov = total[4] / N - meanY * meanC;
+        if (varC > 0.0) {
+            double beta = cov / varC;
+            value = meanY - beta * (meanC - (call ? kirkCall : kirkPut));
+            variance = std::max(varY - cov * beta, 0.0);
+        }
+    }
+
+    standardError = sqrt(variance / N);
+    reduction = variance > 0.0 ? varY / variance : 1.0;
+
+    return value;
+}
+
+/**
+ * Kirk's approximation of a spread option on S1 - S2
+ * @note S2 + K is treated as lognormal, so S1 / (S2 + K) is lognormal and the option is priced with Black's formula
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @param T_ Expiry time/maturity
+ * @param r_ Risk-free interest rate
+ * @param S1 Spot price of the long asset
+ * @param S2 Spot price of the short asset
+ * @param K_ Strike price
+ * @param sig1 Volatility of the long asset
+ * @param sig2 Volatility of the short asset
+ * @param rho Correlation of the assets
+ * @param b1 Cost of carry of the long asset
+ * @param b2 Cost of carry of the short asset
+ * @param call Receives the Call price
+ * @param put Receives the Put price
+ */
+template<typename RNG_>
+void BasketEngine<RNG_>::kirk(double T_, double r_, double S1, double S2, double K_, double sig1, double sig2,
+                              double rho, double b1, double b2, double &call, double &put) {
+
+    double F1 = S1 * exp(b1 * T_), F2 = S2 * exp(b2 * T_) + K_;
+    double w = (F2 - K_) / F2;
+    double sig = sqrt(sig1 * sig1 - 2.0 * rho * sig1 * sig2 * w + sig2 * sig2 * w * w);
+    double discount = exp(-r_ * T_);
+
+    double d1 = (log(F1 / F2) + 0.5 * sig * sig * T_) / (sig * sqrt(T_));
+    double d2 = d1 - sig * sqrt(T_);
+
+    call = discount * (F1 * RNG_::CDF(d1) - F2 * RNG_::CDF(d2));
+    put = discount * (F2 * RNG_::CDF(-d2) - F1 * RNG_::CDF(-d1));
+}
+
+/* ********************************************************************************************************************
+ * Helper function
+ *********************************************************************************************************************/
+
+/*
+ * Number of paths per block
+ * @note Automatic blocks hold 8192 doubles per buffer whatever the number of assets, i.e. 64KB for the variates and
+ * 64KB for the spots, so a block stays in L2 while it is correlated and reduced
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @return The block size
+ */
+template<typename RNG_>
+std::size_t BasketEngine<RNG_>::width() const {
+    if (block > 0) { return block; }
+    return std::max<std::size_t>(64, 8192 / std::max<std::size_t>(spots.size(), 1));
+}
+
+/* ********************************************************************************************************************
+ * Accessors
+ *********************************************************************************************************************/
+
+/**
+ * Number of assets
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @return The number of underlyings simulated on each path
+ */
+template<typename RNG_>
+std::size_t BasketEngine<RNG_>::assets() const { return spots.size(); }
+
+/**
+ * Standard error of the last price estimate
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @return The standard deviation of the (controlled) discounted payoff over the square root of the number of paths
+ */
+template<typename RNG_>
+double BasketEngine<RNG_>::error() const { return standardError; }
+
+/**
+ * Variance reduction of the last price estimate
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @return The variance of the plain estimate over that of the controlled one. One without a control variate
+ */
+template<typename RNG_>
+double BasketEngine<RNG_>::efficiency() const { return reduction; }
+
+/* ********************************************************************************************************************
+ * Mutators
+ *********************************************************************************************************************/
+
+/**
+ * Set the number of paths and the seed
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @param paths_ Number of paths
+ * @param block_ Number of paths generated together. Zero sizes the blocks to the cache
+ * @param seed_ Seed of the first block of paths
+ */
+template<typename RNG_>
+void BasketEngine<RNG_>::simulation(std::size_t paths_, std::size_t block_, unsigned int seed_) {
+    paths = paths_;
+    block = block_;
+    seed = seed_;
+}
+
+#endif
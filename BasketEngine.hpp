@@ -0,0 +1,83 @@
+/**********************************************************************************************************************
+ * Correlated multi-asset Monte Carlo for European basket, spread, best-of, and worst-of options
+ *
+ * @note A host class for the RNG policy. Paths are generated in blocks stored asset-major, so each asset is one
+ * contiguous row of the block and correlating the variates, mapping them to spots, and reducing them to a payoff are
+ * all loops over contiguous paths. The block holds a fixed number of doubles whatever the number of assets, so the
+ * working set stays in cache as the basket grows. Spread options use Kirk's approximation as a control variate whose
+ * simulated counterpart shares the draws of every path
+ *********************************************************************************************************************/
+
+#ifndef BASKETENGINE_HPP
+#define BASKETENGINE_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "Portfolio.hpp"
+
+template<typename RNG_>
+class BasketEngine {
+public:
+    enum class Payoff : unsigned char { Basket, Spread, BestOf, WorstOf };
+
+private:
+    // Market data of the underlyings
+    std::vector<double> spots;                   // Spot price of each asset
+    std::vector<double> vols;                    // Volatility of each asset
+    std::vector<double> carries;                 // Cost of carry of each asset
+    std::vector<std::vector<double>> correlation; // Correlation matrix of the assets
+    std::vector<double> cholesky;                // Lower Cholesky factor of the correlation matrix, packed row-major
+    double r;                                    // Risk-free interest rate
+    double T;                                    // Expiry time/maturity
+
+    // Simulation settings
+    std::size_t paths;                           // Number of paths
+    std::size_t block;                           // Number of paths generated together. Zero sizes blocks to the cache
+    unsigned int seed;                           // Seed of the first block of paths
+
+    // Results of the last run
+    double standardError;                        // Standard error of the price estimate
+    double reduction;                            // Variance of the plain estimate over that of the controlled one
+
+    // Helper function
+    std::size_t width() const;
+
+public:
+    // Constructors and destructors
+    BasketEngine();
+    BasketEngine(const BasketEngine& source);
+    BasketEngine(const std::vector<double>& spots_, const std::vector<double>& vols_,
+                 const std::vector<double>& carries_, const std::vector<std::vector<double>>& correlation_, double r_,
+                 double T_);
+    virtual ~BasketEngine();
+
+    // Operator overloading
+    BasketEngine& operator=(const BasketEngine& source);
+
+    // Correlated normals and terminal spots of one block of paths, one row of paths per asset
+    std::size_t blocks() const;
+    void generate(std::size_t j, std::vector<double>& x, std::vector<double>& S) const;
+
+    // Price of a Call or Put on the basket, spread, best-of, or worst-of the assets
+    double price(Payoff payoff, Portfolio::OptionType type, double K_,
+                 const std::vector<double>& weights = std::vector<double>());
+
+    // Kirk's approximation of a spread option on S1 - S2
+    static void kirk(double T_, double r_, double S1, double S2, double K_, double sig1, double sig2, double rho,
+                     double b1, double b2, double& call, double& put);
+
+    // Accessors
+    std::size_t assets() const;
+    double error() const;
+    double efficiency() const;
+
+    // Mutators
+    void simulation(std::size_t paths_, std::size_t block_, unsigned int seed_);
+};
+
+#ifndef BASKETENGINE_CPP
+#include "BasketEngine.cpp"
+
+#endif // BASKETENGINE_CPP
+#endif // BASKETENGINE_HPP
@@ -0,0 +1,550 @@
+/**********************************************************************************************************************
+ * Fang-Oosterlee COS pricing application for European options under characteristic function models
+ *********************************************************************************************************************/
+
+#ifndef COSPRICER_CPP
+#define COSPRICER_CPP
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+#include "COSPricer.hpp"
+
+/**
+ * Initialize a new COS pricer with a default constructed model and an at the money one year option
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ */
+template<typename Model_, typename Mesher_, typename Matrix_, typename Output_>
+COSPricer<Model_, Mesher_, Matrix_, Output_>::COSPricer() : Mesher_(), Matrix_(), Output_(), model(), terms(256),
+        L(10.0), T(1.0), r(0.05), S(100.0), K(100.0), b(0.05) {}
+
+/**
+ * Initialize a new COS pricer whose data members are a copy of the source
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param source A COS pricer whose data members will be copied
+ */
+template<typename Model_, typename Mesher_, typename Matrix_, typename Output_>
+COSPricer<Model_, Mesher_, Matrix_, Output_>::COSPricer(const COSPricer<Model_, Mesher_, Matrix_, Output_> &source) :
+        Mesher_(source), Matrix_(source), Output_(source), model(source.model), terms(source.terms), L(source.L),
+        T(source.T), r(source.r), S(source.S), K(source.K), b(source.b) {}
+
+/**
+ * Initialize a new COS pricer
+ * @note 256 terms price Heston, Merton, and Black-Scholes to about 1e-8 from a week to several years of expiry.
+ * Variance Gamma has a density with a cusp at short expiries and needs more terms there
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param model_ Model of the log return
+ * @param T_ Expiry
+ * @param r_ Risk-free rate
+ * @param S_ Spot price
+ * @param K_ Strike price
+ * @param b_ Cost of carry
+ * @param terms_ Number of cosine terms
+ * @param L_ Width of the truncation interval in standard deviations of the log return
+ */
+template<typename Model_, typename Mesher_, typename Matrix_, typename Output_>
+COSPricer<Model_, Mesher_, Matrix_, Output_>::COSPricer(const Model_ &model_, double T_, double r_, double S_,
+        double K_, double b_, std::size_t terms_, double L_) : Mesher_(), Matrix_(), Output_(), model(model_),
+        terms(terms_), L(L_), T(T_), r(r_), S(S_), K(K_), b(b_) {}
+
+/**
+ * Destroy this COS pricer
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ */
+template<typename Model_, typename Mesher_, typename Matrix_, typename Output_>
+COSPricer<Model_, Mesher_, Matrix_, Output_>::~COSPricer() {}
+
+/**
+ * Copy the source data members into this COS pricer
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param source A COS pricer whose data members will be copied
+ * @return This COS pricer
+ */
+template<typename Model_, typename Mesher_, typename Matrix_, typename Output_>
+COSPricer<Model_, Mesher_, Matrix_, Output_>& COSPricer<Model_, Mesher_, Matrix_, Output_>
+        ::operator=(const COSPricer<Model_, Mesher_, Matrix_, Output_> &source) {
+    // Avoid self assign
+    if (this == &source) { return *this; }
+
+    Mesher_::operator=(source);
+    Matrix_::operator=(source);
+    Output_::operator=(source);
+
+    model = source.model;
+    terms = source.terms;
+    L = source.L;
+    T = source.T;
+    r = source.r;
+    S = source.S;
+    K = source.K;
+    b = source.b;
+
+    return *this;
+}
+
+/* ********************************************************************************************************************
+ * Core pricing functions
+ *********************************************************************************************************************/
+
+/**
+ * Core pricing functionality for this option
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @return A matrix with one row of Call and Put prices
+ */
+template<typename Model_, typename Mesher_, typename Matrix_, typename Output_>
+std::vector<std::vector<double>> COSPricer<Model_, Mesher_, Matrix_, Output_>::price() const {
+    std::vector<double> calls, puts;
+    price(T, r, S, b, std::vector<double>(1, K), calls, puts);
+    return {{calls[0], puts[0]}};
+}
+
+/**
+ * Price this option over a monotonically increasing option property and send the prices to a file
+ * @note A strike sweep shares one expiry, so the whole sweep costs one set of characteristic function evaluations
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param start Start point of interval
+ * @param stop End point of interval
+ * @param step The step size within the interval
+ * @param property The option parameter which will be monotonically increased by the Mesher
+ */
+template<typename Model_, typename Mesher_, typename Matrix_, typename Output_>
+void COSPricer<Model_, Mesher_, Matrix_, Output_>::price(double start, double stop, double step,
+        const std::string &property) const {
+
+    std::vector<double> mesh = Mesher_::xarr(start, stop, step);     // Generate the mesh points for the matrix
+
+    // The model supplies the volatility, so the volatility column of the matrix is unused
+    std::vector<std::vector<double>> matrix = Matrix_::matrix(mesh, property, T, 0.0, r, S, K, b);
+
+    // Create and fill containers with option data
+    std::vector<std::vector<double>> prices = price(matrix);
+
+    // Send data to an output file
+    Output_::csv(mesh, prices);
+}
+
+/**
+ * Call and Put prices for a matrix of option parameters
+ * @note Consecutive rows that share T, r, S, and b are priced together as one strike strip. The volatility column is
+ * ignored because the model supplies the dynamics
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param matrix A matrix of option parameters where each row has T, sig, r, S, K, b
+ * @return A matrix with one row of Call and Put prices per row of the input matrix
+ */
+template<typename Model_, typename Mesher_, typename Matrix_, typename Output_>
+std::vector<std::vector<double>>
+COSPricer<Model_, Mesher_, Matrix_, Output_>::price(const std::vector<std::vector<double>> &matrix) const {
+
+    std::vector<std::vector<double>> prices;
+    prices.reserve(matrix.size());
+
+    std::vector<double> strikes, calls, puts;
+    std::size_t first = 0;
+    while (first < matrix.size()) {
+        const std::vector<double> &row = matrix[first];
+
+        std::size_t last = first;
+        strikes.clear();
+        while (last < matrix.size() && matrix[last][0] == row[0] && matrix[last][2] == row[2]
+               && matrix[last][3] == row[3] && matrix[last][5] == row[5]) {
+            strikes.push_back(matrix[last][4]);
+            ++last;
+        }
+
+        price(row[0], row[2], row[3], row[5], strikes, calls, puts);
+        for (std::size_t j = 0; j < strikes.size(); ++j) {
+            prices.push_back({calls[j], puts[j]});
+        }
+        first = last;
+    }
+    return prices;
+}
+
+/**
+ * Call and Put prices for every strike of one expiry
+ * @note Puts are expanded directly because their payoff is bounded, which keeps the truncation error small. Calls
+ * follow from put-call parity
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param T_ Expiry
+ * @param r_ Risk-free rate
+ * @param S_ Spot price
+ * @param b_ Cost of carry
+ * @param strikes Strike prices in any order
+ * @param calls Receives one Call price per strike
+ * @param puts Receives one Put price per strike
+ */
+template<typename Model_, typename Mesher_, typename Matrix_, typename Output_>
+void COSPricer<Model_, Mesher_, Matrix_, Output_>::price(double T_, double r_, double S_, double b_,
+        const std::vector<double> &strikes, std::vector<double> &calls, std::vector<double> &puts) const {
+
+    double lower, upper;
+    truncation(T_, r_, b_, lower, upper);
+
+    std::vector<double> F, V;
+    coefficients(T_, r_, b_, lower, upper, F);
+    payoffs(S_, lower, upper, terms, strikes, V);
+
+    double discount = std::exp(-r_ * T_);
+    expansion(F, V, discount, puts);
+
+    double forward = S_ * std::exp((b_ - r_) * T_);
+    calls.resize(strikes.size());
+    for (std::size_t j = 0; j < strikes.size(); ++j) {
+        calls[j] = puts[j] + forward - strikes[j] * discount;
+    }
+}
+
+/* ********************************************************************************************************************
+ * Building blocks of the expansion
+ *********************************************************************************************************************/
+
+/**
+ * Truncation interval of the log return ln(S_T / S)
+ * @note [c1 - L sqrt(c2 + sqrt(c4)), c1 + L sqrt(c2 + sqrt(c4))] as proposed by Fang and Oosterlee. The cumulants are
+ * central differences of the cumulant generating function ln E[e^(s X)] = ln phi(-i s) at s = 0
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param T_ Expiry
+ * @param r_ Risk-free rate
+ * @param b_ Cost of carry
+ * @param lower Receives the lower end of the interval
+ * @param upper Receives the upper end of the interval
+ */
+template<typename Model_, typename Mesher_, typename Matrix_, typename Output_>
+void COSPricer<Model_, Mesher_, Matrix_, Output_>::truncation(double T_, double r_, double b_, double &lower,
+        double &upper) const {
+
+    const double h = 0.01;
+    auto cumulant = [&](double s) {
+        return std::log(std::real(model.characteristic(std::complex<double>(0.0, -s), T_, r_, b_)));
+    };
+
+    double kp1 = cumulant(h), km1 = cumulant(-h), kp2 = cumulant(2.0 * h), km2 = cumulant(-2.0 * h);
+
+    double c1 = (kp1 - km1) / (2.0 * h);
+    double c2 = std::max((kp1 + km1) / (h * h), 0.0);
+    double c4 = std::max((kp2 - 4.0 * kp1 - 4.0 * km1 + km2) / (h * h * h * h), 0.0);
+
+    double width = L * std::sqrt(c2 + std::sqrt(c4));
+    lower = c1 - width;
+    upper = c1 + width;
+}
+
+/**
+ * Cosine coefficients of the density of the log return
+ * @note F_k = 2 / (upper - lower) Re[phi(k pi / (upper - lower)) e^(-i k pi lower / (upper - lower))], with the first
+ * term halved. They depend on the expiry but not on the strike
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param T_ Expiry
+ * @param r_ Risk-free rate
+ * @param b_ Cost of carry
+ * @param lower Lower end of the truncation interval
+ * @param upper Upper end of the truncation interval
+ * @param F Receives one coefficient per term
+ */
+template<typename Model_, typename Mesher_, typename Matrix_, typename Output_>
+void COSPricer<Model_, Mesher_, Matrix_, Output_>::coefficients(double T_, double r_, double b_, double lower,
+        double upper, std::vector<double> &F) const {
+
+    double width = upper - lower;
+    F.resize(terms);
+    for (std::size_t k = 0; k < terms; ++k) {
+        double omega = static_cast<double>(k) * M_PI / width;
+        std::complex<double> phi = model.characteristic(std::complex<double>(omega, 0.0), T_, r_, b_);
+        F[k] = 2.0 / width * std::real(phi * std::polar(1.0, -omega * lower));
+    }
+    F[0] *= 0.5;
+}
+
+/**
+ * Cosine integrals of the Put payoff for every strike
+ * @note For a strike with x = ln(S / K) the payoff K (1 - e^y)^+ in y = ln(S_T / K) is integrated over [x + lower,
+ * min(0, x + upper)]. Strikes are the inner loop and the cosines advance from one term to the next by a rotation, so
+ * each term is a branch free pass over contiguous per strike state that the compiler can vectorize
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param S_ Spot price
+ * @param lower Lower end of the truncation interval of the log return
+ * @param upper Upper end of the truncation interval of the log return
+ * @param terms_ Number of cosine terms
+ * @param strikes Strike prices
+ * @param V Receives terms_ rows of one integral per strike
+ */
+template<typename Model_, typename Mesher_, typename Matrix_, typename Output_>
+void COSPricer<Model_, Mesher_, Matrix_, Output_>::payoffs(double S_, double lower, double upper, std::size_t terms_,
+        const std::vector<double> &strikes, std::vector<double> &V) {
+
+    std::size_t m = strikes.size();
+    double width = upper - lower;
+    V.resize(terms_ * m);
+
+    // Per strike state: payoff interval [A, d], e^A, e^d, and the rotation by pi (d - A) / width
+    std::vector<double> span(m), expA(m), expD(m), weight(m), rotCos(m), rotSin(m), cosine(m), sine(m);
+    for (std::size_t j = 0; j < m; ++j) {
+        double x = std::log(S_ / strikes[j]);
+        double A = x + lower, d = std::min(0.0, x + upper);
+
+        // The payoff vanishes on the whole interval when it lies above the strike
+        bool live = A < d;
+        span[j] = live ? d - A : 0.0;
+        expA[j] = std::exp(A);
+        expD[j] = std::exp(d);
+        weight[j] = live ? strikes[j] : 0.0;
+        rotCos[j] = std::cos(M_PI * span[j] / width);
+        rotSin[j] = std::sin(M_PI * span[j] / width);
+        cosine[j] = 1.0;
+        sine[j] = 0.0;
+    }
+
+    // k = 0: chi = e^d - e^A and psi = d - A
+    for (std::size_t j = 0; j < m; ++j) {
+        V[j] = weight[j] * (span[j] - (expD[j] - expA[j]));
+    }
+
+    for (std::size_t k = 1; k < terms_; ++k) {
+        double omega = static_cast<double>(k) * M_PI / width;
+        double scale = 1.0 / (1.0 + omega * omega);
+        double *row = V.data() + k * m;
+
+        for (std::size_t j = 0; j < m; ++j) {
+            double c = cosine[j] * rotCos[j] - sine[j] * rotSin[j];
+            double s = sine[j] * rotCos[j] + cosine[j] * rotSin[j];
+            cosine[j] = c;
+            sine[j] = s;
+
+            double chi = scale * (c * expD[j] - expA[j] + omega * s * expD[j]);
+            double psi = s / omega;
+            row[j] = weight[j] * (psi - chi);
+        }
+    }
+}
+
+/**
+ * Sum the cosine expansion for every strike
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param F Density coefficients, one per term
+ * @param V Payoff integrals, one row per term and one column per strike
+ * @param discount Discount factor e^(-r T)
+ * @param prices Receives one price per strike
+ */
+template<typename Model_, typename Mesher_, typename Matrix_, typename Output_>
+void COSPricer<Model_, Mesher_, Matrix_, Output_>::expansion(const std::vector<double> &F, const std::vector<double> &V,
+        double discount, std::vector<double> &prices) {
+
+    std::size_t m = F.empty() ? 0 : V.size() / F.size();
+    prices.assign(m, 0.0);
+
+    for (std::size_t k = 0; k < F.size(); ++k) {
+        double f = F[k];
+        const double *row = V.data() + k * m;
+        for (std::size_t j = 0; j < m; ++j) {
+            prices[j] += f * row[j];
+        }
+    }
+
+    for (double &price : prices) {
+        price *= discount;
+    }
+}
+
+/* ********************************************************************************************************************
+ * Accessors
+ *********************************************************************************************************************/
+
+/**
+ * Model of the log return
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @return The model whose characteristic function is expanded
+ */
+template<typename Model_, typename Mesher_, typename Matrix_, typename Output_>
+const Model_& COSPricer<Model_, Mesher_, Matrix_, Output_>::process() const { return model; }
+
+/**
+ * Number of cosine terms
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @return The number of terms in the expansion
+ */
+template<typename Model_, typename Mesher_, typename Matrix_, typename Output_>
+std::size_t COSPricer<Model_, Mesher_, Matrix_, Output_>::size() const { return terms; }
+
+/**
+ * Expiry
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @return The expiry of this option
+ */
+template<typename Model_, typename Mesher_, typename Matrix_, typename Output_>
+double COSPricer<Model_, Mesher_, Matrix_, Output_>::expiry() const { return T; }
+
+/**
+ * Risk-free rate
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @return The risk-free rate of this option
+ */
+template<typename Model_, typename Mesher_, typename Matrix_, typename Output_>
+double COSPricer<Model_, Mesher_, Matrix_, Output_>::riskFree() const { return r; }
+
+/**
+ * Spot price
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @return The spot price of this option
+ */
+template<typename Model_, typename Mesher_, typename Matrix_, typename Output_>
+double COSPricer<Model_, Mesher_, Matrix_, Output_>::spot() const { return S; }
+
+/**
+ * Strike price
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @return The strike price of this option
+ */
+template<typename Model_, typename Mesher_, typename Matrix_, typename Output_>
+double COSPricer<Model_, Mesher_, Matrix_, Output_>::strike() const { return K; }
+
+/**
+ * Cost of carry
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @return The cost of carry of this option
+ */
+template<typename Model_, typename Mesher_, typename Matrix_, typename Output_>
+double COSPricer<Model_, Mesher_, Matrix_, Output_>::carry() const { return b; }
+
+/* ********************************************************************************************************************
+ * Mutators
+ *********************************************************************************************************************/
+
+/**
+ * Replace the model of the log return
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param model_ Model of the log return
+ */
+template<typename Model_, typename Mesher_, typename Matrix_, typename Output_>
+void COSPricer<Model_, Mesher_, Matrix_, Output_>::process(const Model_ &model_) { model = model_; }
+
+/**
+ * Set the option data of this pricer
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param T_ Expiry
+ * @param r_ Risk-free rate
+ * @param S_ Spot price
+ * @param K_ Strike price
+ * @param b_ Cost of carry
+ */
+template<typename Model_, typename Mesher_, typename Matrix_, typename Output_>
+void COSPricer<Model_, Mesher_, Matrix_, Output_>::setOptionData(double T_, double r_, double S_, double K_,
+        double b_) {
+    T = T_;
+    r = r_;
+    S = S_;
+    K = K_;
+    b = b_;
+}
+
+#endif
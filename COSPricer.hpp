@@ -0,0 +1,84 @@
+/**********************************************************************************************************************
+ * Fang-Oosterlee COS pricing application for European options under characteristic function models
+ *
+ * @note The density of the log return is expanded in a cosine series on a truncated interval whose coefficients come
+ * straight from the characteristic function. The coefficients depend on the expiry but not on the strike, so every
+ * strike of an expiry reuses one set of characteristic function evaluations. The payoff side is a matrix of cosine
+ * integrals with one column per strike, and pricing a strip is one pass over that matrix. The truncation interval is
+ * set from the first, second, and fourth cumulants, taken by finite differences of the cumulant generating function,
+ * so that any model in CharacteristicFunction.hpp (or any class with the same characteristic member) can be plugged in
+ *********************************************************************************************************************/
+
+#ifndef COSPRICER_HPP
+#define COSPRICER_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "CharacteristicFunction.hpp"
+#include "Mesher.hpp"
+#include "Matrix.hpp"
+#include "Output.hpp"
+
+template<typename Model_, typename Mesher_, typename Matrix_, typename Output_>
+class COSPricer : public Mesher_, public Matrix_, public Output_ {
+private:
+    Model_ model;                                // Provides characteristic(u, T, r, b) of the log return
+    std::size_t terms;                           // Number of cosine terms
+    double L;                                    // Width of the truncation interval in standard deviations
+
+    // Required option data
+    double T;                                    // Expiry time/maturity
+    double r;                                    // Risk-free interest rate
+    double S;                                    // Spot price
+    double K;                                    // Strike price
+    double b;                                    // Cost of carry
+
+public:
+    // Constructors and destructors
+    COSPricer();
+    COSPricer(const COSPricer& source);
+    COSPricer(const Model_& model_, double T_, double r_, double S_, double K_, double b_, std::size_t terms_ = 256,
+              double L_ = 10.0);
+    virtual ~COSPricer();
+
+    // Operator overloading
+    COSPricer& operator=(const COSPricer& source);
+
+    // Core pricing functionality
+    std::vector<std::vector<double>> price() const;
+    void price(double start, double stop, double step, const std::string& property) const;
+    std::vector<std::vector<double>> price(const std::vector<std::vector<double>>& matrix) const;
+
+    // Call and Put prices for every strike of one expiry
+    void price(double T_, double r_, double S_, double b_, const std::vector<double>& strikes,
+               std::vector<double>& calls, std::vector<double>& puts) const;
+
+    // Building blocks of the expansion, exposed so that calibration can cache the strike side across iterations
+    void truncation(double T_, double r_, double b_, double& lower, double& upper) const;
+    void coefficients(double T_, double r_, double b_, double lower, double upper, std::vector<double>& F) const;
+    static void payoffs(double S_, double lower, double upper, std::size_t terms_, const std::vector<double>& strikes,
+                        std::vector<double>& V);
+    static void expansion(const std::vector<double>& F, const std::vector<double>& V, double discount,
+                          std::vector<double>& prices);
+
+    // Accessors
+    const Model_& process() const;
+    std::size_t size() const;
+    double expiry() const;
+    double riskFree() const;
+    double spot() const;
+    double strike() const;
+    double carry() const;
+
+    // Mutators
+    void process(const Model_& model_);
+    void setOptionData(double T_, double r_, double S_, double K_, double b_);
+};
+
+#ifndef COSPRICER_CPP
+#include "COSPricer.cpp"
+
+#endif // COSPRICER_CPP
+#endif // COSPRICER_HPP
@@ -0,0 +1,333 @@
+/**********************************************************************************************************************
+ * Carr-Madan FFT engine that prices a full strike strip of European options in one transform
+ *********************************************************************************************************************/
+
+#ifndef CARRMADAN_CPP
+#define CARRMADAN_CPP
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "CarrMadan.hpp"
+
+/**
+ * Initialize a new Carr-Madan engine with a default constructed model
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ */
+template<typename Model_>
+CarrMadan<Model_>::CarrMadan() : model(), alpha(1.5), points(4096), eta(0.25) {}
+
+/**
+ * Initialize a new Carr-Madan engine whose data members are a copy of the source
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ * @param source An engine whose data members will be copied
+ */
+template<typename Model_>
+CarrMadan<Model_>::CarrMadan(const CarrMadan<Model_> &source) : model(source.model), alpha(source.alpha),
+points(source.points), eta(source.eta) {}
+
+/**
+ * Initialize a new Carr-Madan engine
+ * @note Integration runs over [0, N eta), so N eta must be large enough for the characteristic function to have decayed.
+ * The defaults integrate to 1024, which is ample for the models in CharacteristicFunction.hpp down to a week of expiry
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ * @param model_ Model of the log return
+ * @param alpha_ Damping exponent of the Call price. Values between 1 and 2 suit most models
+ * @param points_ Number of integration points and strikes. Must be a power of two of at least 8, which leaves room
+ * for the interpolation stencil of price(T, r, S, b, strikes)
+ * @param eta_ Spacing of the integration grid
+ * @throws std::invalid_argument If the number of points is less than 8 or not a power of two
+ */
+template<typename Model_>
+CarrMadan<Model_>::CarrMadan(const Model_ &model_, double alpha_, std::size_t points_, double eta_) : model(model_),
+alpha(alpha_), points(points_), eta(eta_) {
+    if (points < 8 || FFT::size(points) != points) {
+        throw std::invalid_argument("CarrMadan needs a power of two of at least 8 points");
+    }
+}
+
+/**
+ * Destroy this Carr-Madan engine
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ */
+template<typename Model_>
+CarrMadan<Model_>::~CarrMadan() {}
+
+/**
+ * Copy the source data members into this engine
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ * @param source An engine whose data members will be copied
+ * @return This engine
+ */
+template<typename Model_>
+CarrMadan<Model_>& CarrMadan<Model_>::operator=(const CarrMadan<Model_> &source) {
+    // Avoid self assign
+    if (this == &source) { return *this; }
+
+    model = source.model;
+    alpha = source.alpha;
+    points = source.points;
+    eta = source.eta;
+
+    return *this;
+}
+
+/* ********************************************************************************************************************
+ * Strike strips
+ *********************************************************************************************************************/
+
+/**
+ * Call prices on the natural FFT strike grid
+ * @note The log strike spacing is 2 pi / (N eta) and the grid is centred on the log forward
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ * @param T_ Expiry
+ * @param r_ Risk-free rate
+ * @param S_ Spot price
+ * @param b_ Cost of carry
+ * @param strikes Receives N strikes in increasing order
+ * @param prices Receives the Call price at each strike
+ */
+template<typename Model_>
+void CarrMadan<Model_>::strip(double T_, double r_, double S_, double b_, std::vector<double> &strikes,
+                              std::vector<double> &prices) const {
+
+    double lambda = 2.0 * M_PI / (static_cast<double>(points) * eta);
+    double k0 = std::log(S_) + b_ * T_ - 0.5 * lambda * static_cast<double>(points);
+
+    std::vector<std::complex<double>> x;
+    integrand(T_, r_, S_, b_, k0, x);
+    FFT::transform(x);
+
+    calls(x, k0, lambda, strikes, prices);
+}
+
+/**
+ * Call prices on N strikes evenly spaced in log strike over [kMin, kMax]
+ * @note The fractional FFT decouples the strike spacing from the integration spacing, so the whole resolution of the
+ * transform lands on the strikes of interest instead of mostly on strikes far from the money
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ * @param T_ Expiry
+ * @param r_ Risk-free rate
+ * @param S_ Spot price
+ * @param b_ Cost of carry
+ * @param kMin Lowest strike
+ * @param kMax Highest strike
+ * @param strikes Receives N strikes in increasing order
+ * @param prices Receives the Call price at each strike
+ */
+template<typename Model_>
+void CarrMadan<Model_>::strip(double T_, double r_, double S_, double b_, double kMin, double kMax,
+                              std::vector<double> &strikes, std::vector<double> &prices) const {
+
+    double k0 = std::log(kMin);
+    double lambda = (std::log(kMax) - k0) / static_cast<double>(points - 1);
+
+    std::vector<std::complex<double>> x, y;
+    integrand(T_, r_, S_, b_, k0, x);
+    FFT::fractional(x, eta * lambda / (2.0 * M_PI), y);
+
+    calls(y, k0, lambda, strikes, prices);
+}
+
+/* ********************************************************************************************************************
+ * Pricing
+ *********************************************************************************************************************/
+
+/**
+ * Call and Put prices at arbitrary strikes
+ * @note One fractional transform covers the range of the strikes and each price is interpolated with a cubic through
+ * the four nearest strikes of the strip. Puts follow from put-call parity
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ * @param T_ Expiry
+ * @param r_ Risk-free rate
+ * @param S_ Spot price
+ * @param b_ Cost of carry
+ * @param strikes Strike prices in any order
+ * @return A matrix with one row of Call and Put prices per strike
+ */
+template<typename Model_>
+std::vector<std::vector<double>> CarrMadan<Model_>::price(double T_, double r_, double S_, double b_,
+                                                          const std::vector<double> &strikes) const {
+
+    std::vector<std::vector<double>> prices;
+    if (strikes.empty()) { return prices; }
+
+    auto range = std::minmax_element(strikes.begin(), strikes.end());
+    double kMin = std::log(*range.first), kMax = std::log(*range.second);
+
+    // Leave one strike of the strip below and two above the range for the interpolation stencil
+    double lambda = std::max((kMax - kMin) / static_cast<double>(points - 4), 1e-6);
+    double k0 = kMin - lambda;
+
+    std::vector<std::complex<double>> x, y;
+    integrand(T_, r_, S_, b_, k0, x);
+    FFT::fractional(x, eta * lambda / (2.0 * M_PI), y);
+
+    std::vector<double> grid, stripCalls;
+    calls(y, k0, lambda, grid, stripCalls);
+
+    double carry = S_ * std::exp((b_ - r_) * T_);
+    double discount = std::exp(-r_ * T_);
+
+    prices.reserve(strikes.size());
+    for (double K : strikes) {
+        double call = interpolate(stripCalls, (std::log(K) - k0) / lambda);
+        prices.push_back({call, call - carry + K * discount});
+    }
+    return prices;
+}
+
+/**
+ * Call and Put prices for a matrix of option parameters
+ * @note Consecutive rows that share T, r, S, and b (e.g. a strike sweep from Matrix::matrix(mesh, "K", ...)) are
+ * priced by one transform. The volatility column is ignored because the model supplies the dynamics
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ * @param matrix A matrix of option parameters where each row has T, sig, r, S, K, b
+ * @return A matrix with one row of Call and Put prices per row of the input matrix
+ */
+template<typename Model_>
+std::vector<std::vector<double>> CarrMadan<Model_>::price(const std::vector<std::vector<double>> &matrix) const {
+
+    std::vector<std::vector<double>> prices;
+    prices.reserve(matrix.size());
+
+    std::size_t first = 0;
+    while (first < matrix.size()) {
+        const std::vector<double> &row = matrix[first];
+
+        std::size_t last = first;
+        std::vector<double> strikes;
+        while (last < matrix.size() && matrix[last][0] == row[0] && matrix[last][2] == row[2]
+               && matrix[last][3] == row[3] && matrix[last][5] == row[5]) {
+            strikes.push_back(matrix[last][4]);
+            ++last;
+        }
+
+        std::vector<std::vector<double>> group = price(row[0], row[2], row[3], row[5], strikes);
+        prices.insert(prices.end(), group.begin(), group.end());
+        first = last;
+    }
+    return prices;
+}
+
+/* ********************************************************************************************************************
+ * Helper functions
+ *********************************************************************************************************************/
+
+/*
+ * Damped, discounted, Simpson weighted transform of the Call price at each integration point, shifted to k0
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ * @param T_ Expiry
+ * @param r_ Risk-free rate
+ * @param S_ Spot price
+ * @param b_ Cost of carry
+ * @param k0 First log strike of the strip
+ * @param x Receives N points ready for transformation
+ */
+template<typename Model_>
+void CarrMadan<Model_>::integrand(double T_, double r_, double S_, double b_, double k0,
+                                  std::vector<std::complex<double>> &x) const {
+
+    const std::complex<double> i(0.0, 1.0);
+    double logSpot = std::log(S_);
+    double discount = std::exp(-r_ * T_);
+
+    x.resize(points);
+    for (std::size_t j = 0; j < points; ++j) {
+        double v = eta * static_cast<double>(j);
+        std::complex<double> u(v, -(alpha + 1.0));
+
+        // psi(v) = e^(-rT) phi(v - (alpha + 1) i) / (alpha^2 + alpha - v^2 + i (2 alpha + 1) v)
+        std::complex<double> phi = std::exp(i * u * logSpot) * model.characteristic(u, T_, r_, b_);
+        std::complex<double> psi = discount * phi / std::complex<double>(alpha * alpha + alpha - v * v,
+                                                                          (2.0 * alpha + 1.0) * v);
+
+        // Simpson's rule weights 1/3, 4/3, 2/3, 4/3, ...
+        double weight = j == 0 ? 1.0 / 3.0 : (j % 2 == 1 ? 4.0 / 3.0 : 2.0 / 3.0);
+        x[j] = std::exp(-i * v * k0) * psi * (eta * weight);
+    }
+}
+
+/*
+ * Undamp the transformed points into Call prices
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ * @param y Transformed points
+ * @param k0 First log strike
+ * @param lambda Log strike spacing
+ * @param strikes Receives the strikes
+ * @param prices Receives the Call price at each strike
+ */
+template<typename Model_>
+void CarrMadan<Model_>::calls(const std::vector<std::complex<double>> &y, double k0, double lambda,
+                              std::vector<double> &strikes, std::vector<double> &prices) const {
+
+    strikes.resize(y.size());
+    prices.resize(y.size());
+    for (std::size_t u = 0; u < y.size(); ++u) {
+        double k = k0 + lambda * static_cast<double>(u);
+        strikes[u] = std::exp(k);
+        prices[u] = std::exp(-alpha * k) / M_PI * y[u].real();
+    }
+}
+
+/*
+ * Cubic Lagrange interpolation through the four strip points around a fractional position
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ * @param prices Prices on a uniform grid
+ * @param position Fractional index into the grid
+ * @return The interpolated price
+ */
+template<typename Model_>
+double CarrMadan<Model_>::interpolate(const std::vector<double> &prices, double position) {
+
+    double base = std::floor(position);
+    std::size_t j = static_cast<std::size_t>(std::min(std::max(base, 1.0), static_cast<double>(prices.size() - 3)));
+    double t = position - static_cast<double>(j);
+
+    // Lagrange basis on the nodes -1, 0, 1, 2
+    double w0 = -t * (t - 1.0) * (t - 2.0) / 6.0;
+    double w1 = (t + 1.0) * (t - 1.0) * (t - 2.0) / 2.0;
+    double w2 = -(t + 1.0) * t * (t - 2.0) / 2.0;
+    double w3 = (t + 1.0) * t * (t - 1.0) / 6.0;
+
+    return w0 * prices[j - 1] + w1 * prices[j] + w2 * prices[j + 1] + w3 * prices[j + 2];
+}
+
+/* ********************************************************************************************************************
+ * Accessors
+ *********************************************************************************************************************/
+
+/**
+ * Model of the log return
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ * @return The model whose characteristic function is transformed
+ */
+template<typename Model_>
+const Model_& CarrMadan<Model_>::process() const { return model; }
+
+/**
+ * Damping exponent
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ * @return alpha
+ */
+template<typename Model_>
+double CarrMadan<Model_>::damping() const { return alpha; }
+
+/**
+ * Number of integration points and strikes in a strip
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ * @return N
+ */
+template<typename Model_>
+std::size_t CarrMadan<Model_>::size() const { return points; }
+
+/**
+ * Spacing of the integration grid
+ * @tparam Model_ Provides characteristic(u, T, r, b) of the log return
+ * @return eta
+ */
+template<typename Model_>
+double CarrMadan<Model_>::spacing() const { return eta; }
+
+#endif
@@ -0,0 +1,72 @@
+/**********************************************************************************************************************
+ * Carr-Madan FFT engine that prices a full strike strip of European options in one transform
+ *
+ * @note The damped Call price e^(alpha k) C(k) in log strike k is square integrable, so its Fourier transform has a
+ * closed form in the characteristic function of the log price. Sampling that transform on N points and applying one
+ * FFT gives Call prices at N log strikes in O(N log N), instead of N independent evaluations. The natural grid ties
+ * the strike spacing to the integration spacing (lambda eta = 2 pi / N); the fractional FFT removes that restriction
+ * so that the N strikes can span any interval. Puts follow from put-call parity
+ *********************************************************************************************************************/
+
+#ifndef CARRMADAN_HPP
+#define CARRMADAN_HPP
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+#include "CharacteristicFunction.hpp"
+#include "FFT.hpp"
+
+template<typename Model_>
+class CarrMadan {
+private:
+    Model_ model;                                // Provides characteristic(u, T, r, b) of the log return
+    double alpha;                                // Damping exponent of the Call price
+    std::size_t points;                          // Number of integration points and strikes. A power of two
+    double eta;                                  // Spacing of the integration grid
+
+    // Helper functions
+    void integrand(double T_, double r_, double S_, double b_, double k0,
+                   std::vector<std::complex<double>>& x) const;
+    void calls(const std::vector<std::complex<double>>& y, double k0, double lambda, std::vector<double>& strikes,
+               std::vector<double>& prices) const;
+    static double interpolate(const std::vector<double>& prices, double position);
+
+public:
+    // Constructors and destructors
+    CarrMadan();
+    CarrMadan(const CarrMadan& source);
+    explicit CarrMadan(const Model_& model_, double alpha_ = 1.5, std::size_t points_ = 4096, double eta_ = 0.25);
+    virtual ~CarrMadan();
+
+    // Operator overloading
+    CarrMadan& operator=(const CarrMadan& source);
+
+    // Call prices on the natural FFT strike grid, centred on the forward
+    void strip(double T_, double r_, double S_, double b_, std::vector<double>& strikes,
+               std::vector<double>& prices) const;
+
+    // Call prices on N strikes evenly spaced in log strike over [kMin, kMax] by fractional FFT
+    void strip(double T_, double r_, double S_, double b_, double kMin, double kMax, std::vector<double>& strikes,
+               std::vector<double>& prices) const;
+
+    // Call and Put prices at arbitrary strikes from one fractional transform
+    std::vector<std::vector<double>> price(double T_, double r_, double S_, double b_,
+                                           const std::vector<double>& strikes) const;
+
+    // Call and Put prices for a matrix of option parameters (e.g. a strike sweep from Matrix::matrix)
+    std::vector<std::vector<double>> price(const std::vector<std::vector<double>>& matrix) const;
+
+    // Accessors
+    const Model_& process() const;
+    double damping() const;
+    std::size_t size() const;
+    double spacing() const;
+};
+
+#ifndef CARRMADAN_CPP
+#include "CarrMadan.cpp"
+
+#endif // CARRMADAN_CPP
+#endif // CARRMADAN_HPP
@@ -0,0 +1,405 @@
+/**********************************************************************************************************************
+ * Characteristic functions of the log return for the Fourier pricing engines
+ *********************************************************************************************************************/
+
+#include <cmath>
+#include <cstddef>
+
+#include "CharacteristicFunction.hpp"
+
+/* ********************************************************************************************************************
+ * Black-Scholes
+ *********************************************************************************************************************/
+
+/**
+ * Initialize a new Black-Scholes model with 20% volatility
+ */
+BlackScholesModel::BlackScholesModel() : sig(0.2) {}
+
+/**
+ * Initialize a new Black-Scholes model whose data members are a copy of the source
+ * @param source A model whose data members will be copied
+ */
+BlackScholesModel::BlackScholesModel(const BlackScholesModel &source) : sig(source.sig) {}
+
+/**
+ * Initialize a new Black-Scholes model
+ * @param sig_ Volatility
+ */
+BlackScholesModel::BlackScholesModel(double sig_) : sig(sig_) {}
+
+/**
+ * Destroy this Black-Scholes model
+ */
+BlackScholesModel::~BlackScholesModel() {}
+
+/**
+ * Copy the source data members into this model
+ * @param source A model whose data members will be copied
+ * @return This model
+ */
+BlackScholesModel& BlackScholesModel::operator=(const BlackScholesModel &source) {
+    // Avoid self assign
+    if (this == &source) { return *this; }
+
+    sig = source.sig;
+
+    return *this;
+}
+
+/**
+ * Characteristic function of the Black-Scholes log return
+ * @param u Argument
+ * @param T_ Expiry
+ * @param r_ Risk-free rate. The log return does not depend on it once the carry is given
+ * @param b_ Cost of carry
+ * @return E[e^(i u ln(S_T / S))]
+ */
+std::complex<double> BlackScholesModel::characteristic(const std::complex<double> &u, double T_, double,
+                                                       double b_) const {
+    const std::complex<double> i(0.0, 1.0);
+    double variance = sig * sig;
+    return std::exp(i * u * ((b_ - 0.5 * variance) * T_) - 0.5 * variance * T_ * u * u);
+}
+
+/**
+ * Volatility
+ * @return The volatility of the model
+ */
+double BlackScholesModel::vol() const { return sig; }
+
+/* ********************************************************************************************************************
+ * Heston stochastic volatility
+ *********************************************************************************************************************/
+
+/**
+ * Initialize a new Heston model with a flat 20% volatility term structure and a negative skew
+ */
+HestonModel::HestonModel() : v0(0.04), kappa(1.5), theta(0.04), xi(0.3), rho(-0.7) {}
+
+/**
+ * Initialize a new Heston model whose data members are a copy of the source
+ * @param source A model whose data members will be copied
+ */
+HestonModel::HestonModel(const HestonModel &source) : v0(source.v0), kappa(source.kappa), theta(source.theta),
+xi(source.xi), rho(source.rho) {}
+
+/**
+ * Initialize a new Heston model
+ * @param v0_ Initial variance
+ * @param kappa_ Mean reversion speed of the variance
+ * @param theta_ Long run variance
+ * @param xi_ Volatility of the variance
+ * @param rho_ Correlation of the spot and variance shocks
+ */
+HestonModel::HestonModel(double v0_, double kappa_, double theta_, double xi_, double rho_) : v0(v0_),
+kappa(kappa_), theta(theta_), xi(xi_), rho(rho_) {}
+
+/**
+ * Destroy this Heston model
+ */
+HestonModel::~HestonModel() {}
+
+/**
+ * Copy the source data members into this model
+ * @param source A model whose data members will be copied
+ * @return This model
+ */
+HestonModel& HestonModel::operator=(const HestonModel &source) {
+    // Avoid self assign
+    if (this == &source) { return *this; }
+
+    v0 = source.v0;
+    kappa = source.kappa;
+    theta = source.theta;
+    xi = source.xi;
+    rho = source.rho;
+
+    return *this;
+}
+
+/**
+ * Characteristic function of the Heston log return
+ * @note Uses the formulation of Albrecher et al. in which e^(-d T) replaces e^(d T). It never crosses the branch cut
+ * of the complex logarithm, so it stays continuous for long expiries where the original formulation does not
+ * @param u Argument
+ * @param T_ Expiry
+ * @param r_ Risk-free rate. The log return does not depend on it once the carry is given
+ * @param b_ Cost of carry
+ * @return E[e^(i u ln(S_T / S))]
+ */
+std::complex<double> HestonModel::characteristic(const std::complex<double> &u, double T_, double,
+                                                 double b_) const {
+    const std::complex<double> i(0.0, 1.0);
+    double xi2 = xi * xi;
+
+    std::complex<double> beta = kappa - rho * xi * i * u;
+    std::complex<double> d = std::sqrt(beta * beta + xi2 * (i * u + u * u));
+    std::complex<double> g = (beta - d) / (beta + d);
+    std::complex<double> decay = std::exp(-d * T_);
+
+    std::complex<double> C = i * u * (b_ * T_)
+            + (kappa * theta / xi2) * ((beta - d) * T_ - 2.0 * std::log((1.0 - g * decay) / (1.0 - g)));
+    std::complex<double> D = ((beta - d) / xi2) * ((1.0 - decay) / (1.0 - g * decay));
+
+    return std::exp(C + D * v0);
+}
+
+/**
+ * Characteristic function of the Heston log return and its analytic gradient with respect to the model parameters
+ * @note Differentiates the formulation used by characteristic term by term, so that calibration gets exact gradients
+ * for the cost of about two characteristic function evaluations
+ * @param u Argument
+ * @param T_ Expiry
+ * @param r_ Risk-free rate. The log return does not depend on it once the carry is given
+ * @param b_ Cost of carry
+ * @param gradient Receives d phi / d v0, d phi / d kappa, d phi / d theta, d phi / d xi, and d phi / d rho
+ * @return E[e^(i u ln(S_T / S))]
+ */
+std::complex<double> HestonModel::characteristic(const std::complex<double> &u, double T_, double, double b_,
+                                                 std::complex<double> *gradient) const {
+    const std::complex<double> i(0.0, 1.0);
+    double xi2 = xi * xi;
+    std::complex<double> iu = i * u;
+    std::complex<double> quadratic = iu + u * u;
+
+    std::complex<double> beta = kappa - rho * xi * iu;
+    std::complex<double> d = std::sqrt(beta * beta + xi2 * quadratic);
+    std::complex<double> g = (beta - d) / (beta + d);
+    std::complex<double> decay = std::exp(-d * T_);
+    std::complex<double> A = std::log((1.0 - g * decay) / (1.0 - g));
+    std::complex<double> Q = (beta - d) * T_ - 2.0 * A;
+    std::complex<double> P = (beta - d) / xi2;
+    std::complex<double> R = (1.0 - decay) / (1.0 - g * decay);
+
+    double c = kappa * theta / xi2;
+    std::complex<double> C = iu * (b_ * T_) + c * Q;
+    std::complex<double> D = P * R;
+    std::complex<double> phi = std::exp(C + D * v0);
+
+    // Partial derivatives of beta and c for kappa, theta, xi, and rho. v0 only enters through D v0
+    const std::complex<double> dBeta[4] = {1.0, 0.0, -rho * iu, -xi * iu};
+    const double dC[4] = {theta / xi2, kappa / xi2, -2.0 * c / xi, 0.0};
+
+    gradient[0] = phi * D;
+    for (std::size_t p = 0; p < 4; ++p) {
+        bool isXi = p == 2;
+
+        std::complex<double> dd = (beta * dBeta[p] + (isXi ? xi * quadratic : 0.0)) / d;
+        std::complex<double> dg = 2.0 * (d * dBeta[p] - beta * dd) / ((beta + d) * (beta + d));
+        std::complex<double> dDecay = -T_ * decay * dd;
+        std::complex<double> dA = -(dg * decay + g * dDecay) / (1.0 - g * decay) + dg / (1.0 - g);
+        std::complex<double> dQ = (dBeta[p] - dd) * T_ - 2.0 * dA;
+        std::complex<double> dP = (dBeta[p] - dd) / xi2 - (isXi ? 2.0 * P / xi : 0.0);
+        std::complex<double> dR = (-dDecay * (1.0 - g * decay) + (1.0 - decay) * (dg * decay + g * dDecay))
+                / ((1.0 - g * decay) * (1.0 - g * decay));
+
+        gradient[p + 1] = phi * (dC[p] * Q + c * dQ + v0 * (dP * R + P * dR));
+    }
+
+    return phi;
+}
+
+/**
+ * Initial variance
+ * @return The variance at time zero
+ */
+double HestonModel::initialVariance() const { return v0; }
+
+/**
+ * Mean reversion speed
+ * @return The speed at which the variance reverts to its long run level
+ */
+double HestonModel::reversion() const { return kappa; }
+
+/**
+ * Long run variance
+ * @return The level the variance reverts to
+ */
+double HestonModel::longRunVariance() const { return theta; }
+
+/**
+ * Volatility of the variance
+ * @return The diffusion coefficient of the variance process
+ */
+double HestonModel::volOfVol() const { return xi; }
+
+/**
+ * Correlation
+ * @return The correlation of the spot and variance shocks
+ */
+double HestonModel::correlation() const { return rho; }
+
+/* ********************************************************************************************************************
+ * Merton jump-diffusion
+ *********************************************************************************************************************/
+
+/**
+ * Initialize a new Merton model with 20% diffusion volatility and one down jump every ten years on average
+ */
+MertonModel::MertonModel() : sig(0.2), lambda(0.1), muJ(-0.1), sigJ(0.15) {}
+
+/**
+ * Initialize a new Merton model whose data members are a copy of the source
+ * @param source A model whose data members will be copied
+ */
+MertonModel::MertonModel(const MertonModel &source) : sig(source.sig), lambda(source.lambda), muJ(source.muJ),
+sigJ(source.sigJ) {}
+
+/**
+ * Initialize a new Merton model
+ * @param sig_ Diffusion volatility
+ * @param lambda_ Jump intensity per year
+ * @param muJ_ Mean of the log jump size
+ * @param sigJ_ Volatility of the log jump size
+ */
+MertonModel::MertonModel(double sig_, double lambda_, double muJ_, double sigJ_) : sig(sig_), lambda(lambda_),
+muJ(muJ_), sigJ(sigJ_) {}
+
+/**
+ * Destroy this Merton model
+ */
+MertonModel::~MertonModel() {}
+
+/**
+ * Copy the source data members into this model
+ * @param source A model whose data members will be copied
+ * @return This model
+ */
+MertonModel& MertonModel::operator=(const MertonModel &source) {
+    // Avoid self assign
+    if (this == &source) { return *this; }
+
+    sig = source.sig;
+    lambda = source.lambda;
+    muJ = source.muJ;
+    sigJ = source.sigJ;
+
+    return *this;
+}
+
+/**
+ * Characteristic function of the Merton log return
+ * @note The drift is compensated by lambda (e^(muJ + sigJ^2 / 2) - 1) so that the forward is S e^(b T)
+ * @param u Argument
+ * @param T_ Expiry
+ * @param r_ Risk-free rate. The log return does not depend on it once the carry is given
+ * @param b_ Cost of carry
+ * @return E[e^(i u ln(S_T / S))]
+ */
+std::complex<double> MertonModel::characteristic(const std::complex<double> &u, double T_, double,
+                                                 double b_) const {
+    const std::complex<double> i(0.0, 1.0);
+    double variance = sig * sig;
+    double compensator = lambda * (std::exp(muJ + 0.5 * sigJ * sigJ) - 1.0);
+
+    std::complex<double> jump = std::exp(i * u * muJ - 0.5 * sigJ * sigJ * u * u) - 1.0;
+    return std::exp(i * u * ((b_ - 0.5 * variance - compensator) * T_) - 0.5 * variance * T_ * u * u
+                    + lambda * T_ * jump);
+}
+
+/**
+ * Diffusion volatility
+ * @return The volatility of the continuous part of the return
+ */
+double MertonModel::vol() const { return sig; }
+
+/**
+ * Jump intensity
+ * @return The expected number of jumps per year
+ */
+double MertonModel::intensity() const { return lambda; }
+
+/**
+ * Mean log jump
+ * @return The mean of the log jump size
+ */
+double MertonModel::jumpMean() const { return muJ; }
+
+/**
+ * Log jump volatility
+ * @return The volatility of the log jump size
+ */
+double MertonModel::jumpVol() const { return sigJ; }
+
+/* ********************************************************************************************************************
+ * Variance Gamma
+ *********************************************************************************************************************/
+
+/**
+ * Initialize a new Variance Gamma model with 20% volatility and a moderate left skew
+ */
+VarianceGammaModel::VarianceGammaModel() : sig(0.2), nu(0.2), theta(-0.14) {}
+
+/**
+ * Initialize a new Variance Gamma model whose data members are a copy of the source
+ * @param source A model whose data members will be copied
+ */
+VarianceGammaModel::VarianceGammaModel(const VarianceGammaModel &source) : sig(source.sig), nu(source.nu),
+theta(source.theta) {}
+
+/**
+ * Initialize a new Variance Gamma model
+ * @param sig_ Volatility of the Brownian motion
+ * @param nu_ Variance rate of the gamma time change
+ * @param theta_ Drift of the Brownian motion
+ */
+VarianceGammaModel::VarianceGammaModel(double sig_, double nu_, double theta_) : sig(sig_), nu(nu_), theta(theta_) {}
+
+/**
+ * Destroy this Variance Gamma model
+ */
+VarianceGammaModel::~VarianceGammaModel() {}
+
+/**
+ * Copy the source data members into this model
+ * @param source A model whose data members will be copied
+ * @return This model
+ */
+VarianceGammaModel& VarianceGammaModel::operator=(const VarianceGammaModel &source) {
+    // Avoid self assign
+    if (this == &source) { return *this; }
+
+    sig = source.sig;
+    nu = source.nu;
+    theta = source.theta;
+
+    return *this;
+}
+
+/**
+ * Characteristic function of the Variance Gamma log return
+ * @note The drift is compensated by ln(1 - theta nu - sig^2 nu / 2) / nu so that the forward is S e^(b T), which
+ * requires theta nu + sig^2 nu / 2 < 1
+ * @param u Argument
+ * @param T_ Expiry
+ * @param r_ Risk-free rate. The log return does not depend on it once the carry is given
+ * @param b_ Cost of carry
+ * @return E[e^(i u ln(S_T / S))]
+ */
+std::complex<double> VarianceGammaModel::characteristic(const std::complex<double> &u, double T_, double,
+                                                        double b_) const {
+    const std::complex<double> i(0.0, 1.0);
+    double compensator = std::log(1.0 - theta * nu - 0.5 * sig * sig * nu) / nu;
+
+    std::complex<double> base = 1.0 - i * u * theta * nu + 0.5 * sig * sig * nu * u * u;
+    return std::exp(i * u * ((b_ + compensator) * T_) - (T_ / nu) * std::log(base));
+}
+
+/**
+ * Volatility of the Brownian motion
+ * @return sig
+ */
+double VarianceGammaModel::vol() const { return sig; }
+
+/**
+ * Variance rate of the gamma time change
+ * @return nu
+ */
+double VarianceGammaModel::variance() const { return nu; }
+
+/**
+ * Drift of the Brownian motion
+ * @return theta
+ */
+double VarianceGammaModel::drift() const { return theta; }
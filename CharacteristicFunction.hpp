@@ -0,0 +1,136 @@
+/**********************************************************************************************************************
+ * Characteristic functions of the log return for the Fourier pricing engines
+ *
+ * @note Each model provides characteristic(u, T, r, b) = E[e^(i u ln(S_T / S))] under the risk neutral measure, with
+ * the drift set by the cost of carry b as in the Black-Scholes classes. u is complex because damped Fourier pricers
+ * evaluate the function off the real axis. Any class with this member can be plugged into a Fourier engine
+ *********************************************************************************************************************/
+
+#ifndef CHARACTERISTICFUNCTION_HPP
+#define CHARACTERISTICFUNCTION_HPP
+
+#include <complex>
+
+/* ********************************************************************************************************************
+ * Black-Scholes
+ *********************************************************************************************************************/
+
+class BlackScholesModel {
+private:
+    double sig;                                  // Volatility
+
+public:
+    // Constructors and destructors
+    BlackScholesModel();
+    BlackScholesModel(const BlackScholesModel& source);
+    explicit BlackScholesModel(double sig_);
+    virtual ~BlackScholesModel();
+
+    // Operator overloading
+    BlackScholesModel& operator=(const BlackScholesModel& source);
+
+    // Characteristic function of ln(S_T / S)
+    std::complex<double> characteristic(const std::complex<double>& u, double T_, double r_, double b_) const;
+
+    // Accessors
+    double vol() const;
+};
+
+/* ********************************************************************************************************************
+ * Heston stochastic volatility
+ *********************************************************************************************************************/
+
+class HestonModel {
+private:
+    double v0;                                   // Initial variance
+    double kappa;                                // Mean reversion speed of the variance
+    double theta;                                // Long run variance
+    double xi;                                   // Volatility of the variance
+    double rho;                                  // Correlation of the spot and variance shocks
+
+public:
+    // Constructors and destructors
+    HestonModel();
+    HestonModel(const HestonModel& source);
+    HestonModel(double v0_, double kappa_, double theta_, double xi_, double rho_);
+    virtual ~HestonModel();
+
+    // Operator overloading
+    HestonModel& operator=(const HestonModel& source);
+
+    // Characteristic function of ln(S_T / S)
+    std::complex<double> characteristic(const std::complex<double>& u, double T_, double r_, double b_) const;
+
+    // Characteristic function and its derivatives with respect to v0, kappa, theta, xi, and rho
+    std::complex<double> characteristic(const std::complex<double>& u, double T_, double r_, double b_,
+                                        std::complex<double>* gradient) const;
+
+    // Accessors
+    double initialVariance() const;
+    double reversion() const;
+    double longRunVariance() const;
+    double volOfVol() const;
+    double correlation() const;
+};
+
+/* ********************************************************************************************************************
+ * Merton jump-diffusion
+ *********************************************************************************************************************/
+
+class MertonModel {
+private:
+    double sig;                                  // Diffusion volatility
+    double lambda;                               // Jump intensity per year
+    double muJ;                                  // Mean of the log jump size
+    double sigJ;                                 // Volatility of the log jump size
+
+public:
+    // Constructors and destructors
+    MertonModel();
+    MertonModel(const MertonModel& source);
+    MertonModel(double sig_, double lambda_, double muJ_, double sigJ_);
+    virtual ~MertonModel();
+
+    // Operator overloading
+    MertonModel& operator=(const MertonModel& source);
+
+    // Characteristic function of ln(S_T / S)
+    std::complex<double> characteristic(const std::complex<double>& u, double T_, double r_, double b_) const;
+
+    // Accessors
+    double vol() const;
+    double intensity() const;
+    double jumpMean() const;
+    double jumpVol() const;
+};
+
+/* ********************************************************************************************************************
+ * Variance Gamma
+ *********************************************************************************************************************/
+
+class VarianceGammaModel {
+private:
+    double sig;                                  // Volatility of the Brownian motion
+    double nu;                                   // Variance rate of the gamma time change
+    double theta;                                // Drift of the Brownian motion. Negative values skew to the left
+
+public:
+    // Constructors and destructors
+    VarianceGammaModel();
+    VarianceGammaModel(const VarianceGammaModel& source);
+    VarianceGammaModel(double sig_, double nu_, double theta_);
+    virtual ~VarianceGammaModel();
+
+    // Operator overloading
+    VarianceGammaModel& operator=(const VarianceGammaModel& source);
+
+    // Characteristic function of ln(S_T / S)
+    std::complex<double> characteristic(const std::complex<double>& u, double T_, double r_, double b_) const;
+
+    // Accessors
+    double vol() const;
+    double variance() const;
+    double drift() const;
+};
+
+#endif // CHARACTERISTICFUNCTION_HPP
@@ -0,0 +1,454 @@
+/**********************************************************************************************************************
+ * Chebyshev tensor interpolation proxy for expensive pricers
+ *********************************************************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+#include <boost/math/constants/constants.hpp>
+
+#include "ChebyshevProxy.hpp"
+#include "Parallel.hpp"
+
+/**
+ * Initialize an empty ChebyshevProxy
+ * @throws OutOfMemoryError Indicates insufficient memory for this new ChebyshevProxy
+ */
+ChebyshevProxy::ChebyshevProxy() : lower(), upper(), nodes(), strides(), coefficients() {}
+
+/**
+ * Initialize a new ChebyshevProxy whose data members are a deep copy of the source
+ * @param source A ChebyshevProxy whose data members will be deeply copied
+ * @throws OutOfMemoryError Indicates insufficient memory for this new ChebyshevProxy
+ */
+ChebyshevProxy::ChebyshevProxy(const ChebyshevProxy &source) : lower(source.lower), upper(source.upper),
+nodes(source.nodes), strides(source.strides), coefficients(source.coefficients) {}
+
+/**
+ * Initialize a new ChebyshevProxy on a box of parameters. The proxy evaluates to zero until it is fitted
+ * @param lower_ Lower corner of the box
+ * @param upper_ Upper corner of the box
+ * @param nodes_ Number of Chebyshev nodes in each dimension. Each must be at least 1
+ * @throws std::invalid_argument If the corners and node counts differ in size, a lower bound is not below its upper
+ * bound, a node count is zero, or the coefficient tensor would not fit in memory
+ * @throws OutOfMemoryError Indicates insufficient memory for this new ChebyshevProxy
+ */
+ChebyshevProxy::ChebyshevProxy(const std::vector<double> &lower_, const std::vector<double> &upper_,
+                               const std::vector<std::size_t> &nodes_) : lower(lower_), upper(upper_),
+                               nodes(nodes_), strides(), coefficients() {
+    if (lower.size() != nodes.size() || upper.size() != nodes.size()) {
+        throw std::invalid_argument("ChebyshevProxy needs one lower bound, upper bound, and node count per dimension");
+    }
+    for (std::size_t d = 0; d < nodes.size(); ++d) {
+        if (!(lower[d] < upper[d])) {
+            throw std::invalid_argument("ChebyshevProxy lower bounds must be below their upper bounds");
+        }
+    }
+    layout();
+}
+
+/**
+ * Destroy this ChebyshevProxy
+ */
+ChebyshevProxy::~ChebyshevProxy() {}
+
+/**
+ * Deeply copy the source data members into this ChebyshevProxy
+ * @param source A ChebyshevProxy whose data members will be deeply copied
+ * @return This ChebyshevProxy whose data members are a deep copy of the source data members
+ */
+ChebyshevProxy& ChebyshevProxy::operator=(const ChebyshevProxy &source) {
+    // Avoid self assign
+    if (this == &source) { return *this; }
+
+    lower = source.lower;
+    upper = source.upper;
+    nodes = source.nodes;
+    strides = source.strides;
+    coefficients = source.coefficients;
+
+    return *this;
+}
+
+/* ********************************************************************************************************************
+ * Helper functions
+ *********************************************************************************************************************/
+
+/*
+ * Number of coefficients in the tensor of the given node counts
+ * @param nodes Chebyshev nodes in each dimension
+ * @param total Receives the product of the node counts
+ * @return False if a node count is zero or the tensor would not fit in the address space
+ */
+bool ChebyshevProxy::tensorSize(const std::vector<std::size_t> &nodes, std::size_t &total) {
+    const std::size_t limit = std::numeric_limits<std::size_t>::max() / sizeof(double);
+    total = 1;
+    for (std::size_t n : nodes) {
+        if (n == 0 || total > limit / n) { return false; }
+        total *= n;
+    }
+    return true;
+}
+
+/*
+ * Compute the coefficient strides from the node counts and size the coefficient tensor
+ * @throws std::invalid_argument If a node count is zero or the tensor would not fit in the address space
+ */
+void ChebyshevProxy::layout() {
+    std::size_t total = 0;
+    if (!tensorSize(nodes, total)) {
+        throw std::invalid_argument("ChebyshevProxy node counts must be at least 1 and fit the coefficient tensor");
+    }
+
+    strides.assign(nodes.size(), 1);
+    std::size_t stride = 1;
+    for (std::size_t d = nodes.size(); d-- > 0;) {
+        strides[d] = stride;
+        stride *= nodes[d];
+    }
+    coefficients.assign(nodes.empty() ? 0 : total, 0.0);
+}
+
+/*
+ * Clenshaw recurrence for a single Chebyshev series
+ * @param a Coefficients of the series
+ * @param n Number of coefficients
+ * @param t Point in [-1, 1]
+ * @return The sum of the series
+ */
+double ChebyshevProxy::clenshaw(const double *a, std::size_t n, double t) {
+
+    double twoT = 2.0 * t;
+    double b1 = 0.0, b2 = 0.0;
+    for (std::size_t j = n; j-- > 1;) {
+        double b0 = a[j] + twoT * b1 - b2;
+        b2 = b1;
+        b1 = b0;
+    }
+    return a[0] + t * b1 - b2;
+}
+
+/*
+ * Clenshaw recurrences for four adjacent series of equal length. The recurrence is a chain of dependent operations, so
+ * running four independent chains together hides most of its latency
+ * @param a Coefficients of the first series. The others follow contiguously
+ * @param n Number of coefficients in each series
+ * @param t Point in [-1, 1]
+ * @param sums The sums of the four series
+ */
+void ChebyshevProxy::clenshaw(const double *a, std::size_t n, double t, double *sums) {
+
+    double twoT = 2.0 * t;
+    double b1[4] = {0.0, 0.0, 0.0, 0.0}, b2[4] = {0.0, 0.0, 0.0, 0.0};
+    for (std::size_t j = n; j-- > 1;) {
+        for (std::size_t s = 0; s < 4; ++s) {
+            double b0 = a[s * n + j] + twoT * b1[s] - b2[s];
+            b2[s] = b1[s];
+            b1[s] = b0;
+        }
+    }
+    for (std::size_t s = 0; s < 4; ++s) {
+        sums[s] = a[s * n] + t * b1[s] - b2[s];
+    }
+}
+
+/* ********************************************************************************************************************
+ * Core functionality
+ *********************************************************************************************************************/
+
+/**
+ * Sample a pricer on the Chebyshev nodes of the box and compute the coefficients of the interpolating polynomial
+ * @note The samples are taken in parallel, so the pricer must be safe to call concurrently. The coefficients follow
+ * from a discrete cosine transform along each dimension in turn
+ * @param pricer The function being approximated
+ */
+void ChebyshevProxy::fit(const Pricer &pricer) {
+
+    const double pi = boost::math::constants::pi<double>();
+    std::size_t D = nodes.size(), N = coefficients.size();
+    if (D == 0) { return; }
+
+    // Sample the pricer on the tensor grid x_k = mid + half * cos(pi * (k + 0.5) / n)
+    Parallel::forRange(N, [&](std::size_t, std::size_t first, std::size_t last) {
+        std::vector<double> x(D);
+        for (std::size_t i = first; i < last; ++i) {
+            for (std::size_t d = 0; d < D; ++d) {
+                std::size_t k = (i / strides[d]) % nodes[d];
+                double t = std::cos(pi * (static_cast<double>(k) + 0.5) / static_cast<double>(nodes[d]));
+                x[d] = 0.5 * (lower[d] + upper[d]) + 0.5 * (upper[d] - lower[d]) * t;
+            }
+            coefficients[i] = pricer(x);
+        }
+    }, 1);
+
+    // Transform each dimension: c_j = (2 / n) * sum_k f_k cos(pi * j * (k + 0.5) / n), with c_0 halved
+    std::vector<double> line, basis;
+    for (std::size_t d = 0; d < D; ++d) {
+        std::size_t n = nodes[d], s = strides[d];
+        line.resize(n);
+        basis.resize(n * n);
+        for (std::size_t j = 0; j < n; ++j) {
+            for (std::size_t k = 0; k < n; ++k) {
+                basis[j * n + k] = std::cos(pi * static_cast<double>(j) * (static_cast<double>(k) + 0.5)
+                                            / static_cast<double>(n));
+            }
+        }
+
+        for (std::size_t start = 0; start < N; ++start) {
+            // Visit the first element of every line along this dimension once
+            if ((start / s) % n != 0) { continue; }
+
+            for (std::size_t k = 0; k < n; ++k) {
+                line[k] = coefficients[start + k * s];
+            }
+            for (std::size_t j = 0; j < n; ++j) {
+                double sum = 0.0;
+                for (std::size_t k = 0; k < n; ++k) {
+                    sum += basis[j * n + k] * line[k];
+                }
+                coefficients[start + j * s] = (j == 0 ? 1.0 : 2.0) * sum / static_cast<double>(n);
+            }
+        }
+    }
+}
+
+/**
+ * Test whether a point lies in the box. The proxy extrapolates poorly, so points outside should use the pricer
+ * @param x Point with one coordinate per dimension
+ * @return True if every coordinate lies within the box
+ */
+bool ChebyshevProxy::contains(const std::vector<double> &x) const {
+    if (x.size() != nodes.size() || nodes.empty()) { return false; }
+
+    for (std::size_t d = 0; d < x.size(); ++d) {
+        if (!(x[d] >= lower[d] && x[d] <= upper[d])) { return false; }
+    }
+    return true;
+}
+
+/**
+ * Evaluate the proxy
+ * @param x Point with one coordinate per dimension
+ * @return The approximate price
+ */
+double ChebyshevProxy::evaluate(const std::vector<double> &x) const { return evaluate(x.data()); }
+
+/**
+ * Evaluate the proxy
+ * @param x Pointer to one coordinate per dimension
+ * @return The approximate price
+ */
+double ChebyshevProxy::evaluate(const double *x) const {
+
+    if (nodes.empty()) { return 0.0; }
+
+    // Sum the contiguous last dimension of every series first, then the next one, until a single value remains. Each
+    // reduction writes behind the position it reads, so it can work in place in a per-thread scratch buffer
+    thread_local std::vector<double> scratch;
+    scratch.resize(coefficients.size() / nodes.back());
+
+    const double *in = coefficients.data();
+    std::size_t count = coefficients.size();
+    for (std::size_t d = nodes.size(); d-- > 0;) {
+        std::size_t n = nodes[d], series = count / n;
+        double t = (2.0 * x[d] - lower[d] - upper[d]) / (upper[d] - lower[d]);
+        std::size_t l = 0;
+        for (; l + 4 <= series; l += 4) {
+            clenshaw(in + l * n, n, t, &scratch[l]);
+        }
+        for (; l < series; ++l) {
+            scratch[l] = clenshaw(in + l * n, n, t);
+        }
+        in = scratch.data();
+        count = series;
+    }
+
+    return in[0];
+}
+
+/* ********************************************************************************************************************
+ * Error estimation
+ *********************************************************************************************************************/
+
+/**
+ * Largest absolute difference between the proxy and the pricer on uniformly distributed points in the box
+ * @note The points are drawn from a single seeded stream before they are priced in parallel, so the estimate is
+ * reproducible for a given seed
+ * @param pricer The function that was approximated
+ * @param samples Number of points
+ * @param seed Seed of the point stream
+ * @return The largest absolute error found
+ */
+double ChebyshevProxy::estimateError(const Pricer &pricer, std::size_t samples, unsigned int seed) const {
+
+    std::size_t D = nodes.size();
+    if (D == 0 || samples == 0) { return 0.0; }
+
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> U(0.0, 1.0);
+    std::vector<double> points(samples * D);
+    for (std::size_t i = 0; i < samples; ++i) {
+        for (std::size_t d = 0; d < D; ++d) {
+            points[i * D + d] = lower[d] + (upper[d] - lower[d]) * U(rng);
+        }
+    }
+
+    std::vector<double> partial(Parallel::threads(), 0.0);
+    Parallel::forRange(samples, [&](std::size_t worker, std::size_t first, std::size_t last) {
+        std::vector<double> x(D);
+        double worst = 0.0;
+        for (std::size_t i = first; i < last; ++i) {
+            std::copy(points.begin() + i * D, points.begin() + (i + 1) * D, x.begin());
+            worst = std::max(worst, std::abs(evaluate(x.data()) - pricer(x)));
+        }
+        partial[worker] = worst;
+    }, 1);
+
+    return *std::max_element(partial.begin(), partial.end());
+}
+
+/**
+ * Cheap truncation error estimate that does not call the pricer
+ * @note Chebyshev coefficients of smooth functions decay geometrically, so the magnitude of the highest order
+ * coefficients along each dimension indicates the size of the neglected terms
+ * @return The sum of the absolute values of the coefficients whose index is the highest in any dimension
+ */
+double ChebyshevProxy::truncationError() const {
+
+    double sum = 0.0;
+    for (std::size_t i = 0; i < coefficients.size(); ++i) {
+        for (std::size_t d = 0; d < nodes.size(); ++d) {
+            if (nodes[d] > 1 && (i / strides[d]) % nodes[d] == nodes[d] - 1) {
+                sum += std::abs(coefficients[i]);
+                break;
+            }
+        }
+    }
+    return sum;
+}
+
+/* ********************************************************************************************************************
+ * Serialization
+ *********************************************************************************************************************/
+
+/**
+ * Write the box, node counts, and coefficients to a binary file
+ * @param path Path to the output file
+ * @return True if the file was written. Otherwise false and a message is written to the console
+ */
+bool ChebyshevProxy::save(const std::string &path) const {
+
+    std::ofstream outFile(path, std::ios::binary);
+    if (!outFile.is_open()) {
+        std::cout << "Unable to open the file. Check filepath permissions\n";
+        return false;
+    }
+
+    std::uint64_t D = nodes.size();
+    outFile.write(magic, sizeof(magic));
+    outFile.write(reinterpret_cast<const char*>(&D), sizeof(D));
+    for (std::size_t n : nodes) {
+        std::uint64_t count = n;
+        outFile.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    }
+    outFile.write(reinterpret_cast<const char*>(lower.data()), static_cast<std::streamsize>(D * sizeof(double)));
+    outFile.write(reinterpret_cast<const char*>(upper.data()), static_cast<std::streamsize>(D * sizeof(double)));
+    outFile.write(reinterpret_cast<const char*>(coefficients.data()),
+                  static_cast<std::streamsize>(coefficients.size() * sizeof(double)));
+
+    return static_cast<bool>(outFile);
+}
+
+/**
+ * Replace this proxy with one read from a binary file written by save
+ * @param path Path to the input file
+ * @return True if the proxy was loaded. Otherwise false, this proxy is unchanged, and a message is written to the
+ * console
+ */
+bool ChebyshevProxy::load(const std::string &path) {
+
+    std::ifstream inFile(path, std::ios::binary);
+    if (!inFile.is_open()) {
+        std::cout << "Unable to open the file. Check filepath permissions\n";
+        return false;
+    }
+
+    char header[sizeof(magic)];
+    std::uint64_t D = 0;
+    inFile.read(header, sizeof(header));
+    inFile.read(reinterpret_cast<char*>(&D), sizeof(D));
+    if (!inFile || !std::equal(header, header + sizeof(header), magic) || D == 0 || D > 64) {
+        std::cout << "Not a Chebyshev proxy file: " << path << "\n";
+        return false;
+    }
+
+    ChebyshevProxy proxy;
+    proxy.nodes.resize(D);
+    for (std::size_t &n : proxy.nodes) {
+        std::uint64_t count = 0;
+        inFile.read(reinterpret_cast<char*>(&count), sizeof(count));
+        n = count;
+    }
+    proxy.lower.resize(D);
+    proxy.upper.resize(D);
+    inFile.read(reinterpret_cast<char*>(proxy.lower.data()), static_cast<std::streamsize>(D * sizeof(double)));
+    inFile.read(reinterpret_cast<char*>(proxy.upper.data()), static_cast<std::streamsize>(D * sizeof(double)));
+    if (!inFile) {
+        std::cout << "Truncated Chebyshev proxy file: " << path << "\n";
+        return false;
+    }
+
+    // The node counts are untrusted. Their product must not overflow and must match the coefficients left in the file
+    std::size_t total = 0;
+    std::streamoff position = inFile.tellg();
+    inFile.seekg(0, std::ios::end);
+    std::streamoff remaining = inFile.tellg() - position;
+    inFile.seekg(position);
+    bool box = true;
+    for (std::size_t d = 0; d < D; ++d) {
+        box = box && proxy.lower[d] < proxy.upper[d];
+    }
+    if (!box || !tensorSize(proxy.nodes, total) || remaining < 0 ||
+        static_cast<std::uint64_t>(remaining) != static_cast<std::uint64_t>(total) * sizeof(double)) {
+        std::cout << "Corrupt Chebyshev proxy file: " << path << "\n";
+        return false;
+    }
+
+    try {
+        proxy.layout();
+    } catch (const std::exception &e) {
+        std::cout << "Cannot allocate the Chebyshev proxy in " << path << ": " << e.what() << "\n";
+        return false;
+    }
+    inFile.read(reinterpret_cast<char*>(proxy.coefficients.data()),
+                static_cast<std::streamsize>(proxy.coefficients.size() * sizeof(double)));
+    if (!inFile) {
+        std::cout << "Truncated Chebyshev proxy file: " << path << "\n";
+        return false;
+    }
+
+    *this = proxy;
+    return true;
+}
+
+/* ********************************************************************************************************************
+ * Accessors
+ *********************************************************************************************************************/
+
+/**
+ * Number of parameters of the proxy
+ * @return The number of dimensions
+ */
+std::size_t ChebyshevProxy::dimensions() const { return nodes.size(); }
+
+/**
+ * Number of stored Chebyshev coefficients
+ * @return The size of the coefficient tensor
+ */
+std::size_t ChebyshevProxy::size() const { return coefficients.size(); }
@@ -0,0 +1,68 @@
+/**********************************************************************************************************************
+ * Chebyshev tensor interpolation proxy for expensive pricers
+ *
+ * @note The pricer is sampled once on a tensor grid of Chebyshev nodes over a box of parameters. The samples are
+ * converted to Chebyshev coefficients and the proxy is evaluated with Clenshaw recurrences, one dimension at a time,
+ * so a valuation costs a few multiplications per coefficient regardless of how slow the original pricer is. Fitted
+ * proxies can be saved to and loaded from disk
+ *********************************************************************************************************************/
+
+#ifndef CHEBYSHEVPROXY_HPP
+#define CHEBYSHEVPROXY_HPP
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+class ChebyshevProxy {
+private:
+    std::vector<double> lower;                   // Lower corner of the box
+    std::vector<double> upper;                   // Upper corner of the box
+    std::vector<std::size_t> nodes;              // Chebyshev nodes (polynomial degree + 1) in each dimension
+    std::vector<std::size_t> strides;            // Coefficient strides. The last dimension is contiguous
+    std::vector<double> coefficients;            // Tensor of Chebyshev coefficients
+
+    // Helper functions
+    void layout();
+    static bool tensorSize(const std::vector<std::size_t>& nodes, std::size_t& total);
+    static double clenshaw(const double* a, std::size_t n, double t);
+    static void clenshaw(const double* a, std::size_t n, double t, double* sums);
+
+public:
+    // Pricing function of a point in the box. It is called concurrently from several threads
+    typedef std::function<double(const std::vector<double>&)> Pricer;
+
+    // Binary layout: magic, dimension count (std::uint64_t), nodes (std::uint64_t), lower, upper, coefficients
+    static constexpr char magic[8] = {'C', 'H', 'E', 'B', 'P', 'R', 'O', 'X'};
+
+    // Constructors and destructors
+    ChebyshevProxy();
+    ChebyshevProxy(const ChebyshevProxy& source);
+    ChebyshevProxy(const std::vector<double>& lower_, const std::vector<double>& upper_,
+                   const std::vector<std::size_t>& nodes_);
+    virtual ~ChebyshevProxy();
+
+    // Operator overloading
+    ChebyshevProxy& operator=(const ChebyshevProxy& source);
+
+    // Core functionality
+    void fit(const Pricer& pricer);
+    bool contains(const std::vector<double>& x) const;
+    double evaluate(const std::vector<double>& x) const;
+    double evaluate(const double* x) const;
+
+    // Error estimation
+    double estimateError(const Pricer& pricer, std::size_t samples, unsigned int seed = 0) const;
+    double truncationError() const;
+
+    // Serialization
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+
+    // Accessors
+    std::size_t dimensions() const;
+    std::size_t size() const;
+};
+
+#endif // CHEBYSHEVPROXY_HPP
@@ -0,0 +1,103 @@
+/**********************************************************************************************************************
+ * Cholesky decomposition of small dense symmetric positive definite matrices
+ *********************************************************************************************************************/
+
+#include <cmath>
+#include <stdexcept>
+
+#include "Cholesky.hpp"
+
+/**
+ * Lower triangular factor of a symmetric positive definite matrix
+ * @param A Symmetric positive definite matrix, e.g. a correlation matrix
+ * @return L with L L^T = A and zeros above the diagonal
+ * @throws std::invalid_argument If the matrix is not positive definite
+ */
+std::vector<std::vector<double>> Cholesky::factor(const std::vector<std::vector<double>> &A) {
+
+    std::size_t m = A.size();
+    std::vector<std::vector<double>> L(m, std::vector<double>(m, 0.0));
+
+    for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j <= i; ++j) {
+            double sum = A[i][j];
+            for (std::size_t k = 0; k < j; ++k) {
+                sum -= L[i][k] * L[j][k];
+            }
+
+            if (i == j) {
+                if (sum <= 0.0) { throw std::invalid_argument("Correlation matrix is not positive definite"); }
+                L[i][i] = sqrt(sum);
+            } else {
+                L[i][j] = sum / L[j][j];
+            }
+        }
+    }
+
+    return L;
+}
+
+/**
+ * Lower triangular factor of a symmetric positive definite matrix in one contiguous array
+ * @note Row i of the factor starts at i * n, so correlating a vector of variates walks the array front to back
+ * @param A Symmetric positive definite matrix, e.g. a correlation matrix
+ * @return L with L L^T = A, packed row-major with zeros above the diagonal
+ * @throws std::invalid_argument If the matrix is not positive definite
+ */
+std::vector<double> Cholesky::packed(const std::vector<std::vector<double>> &A) {
+
+    std::vector<std::vector<double>> L = factor(A);
+    std::size_t m = L.size();
+
+    std::vector<double> result(m * m);
+    for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j < m; ++j) {
+            result[i * m + j] = L[i][j];
+        }
+    }
+    return result;
+}
+
+/**
+ * Solve a small dense symmetric positive definite system, e.g. the normal equations of a least-squares fit
+ * @param A Symmetric positive definite matrix in row-major order
+ * @param g Right hand side
+ * @param x Receives the solution
+ * @return False if the matrix is not positive definite
+ */
+bool Cholesky::solve(std::vector<double> A, std::vector<double> g, std::vector<double> &x) {
+
+    std::size_t n = g.size();
+
+    // A = L L^T with L stored in the lower triangle of A
+    for (std::size_t j = 0; j < n; ++j) {
+        double diagonal = A[j * n + j];
+        for (std::size_t l = 0; l < j; ++l) {
+            diagonal -= A[j * n + l] * A[j * n + l];
+        }
+        if (!(diagonal > 0.0)) { return false; }
+        A[j * n + j] = sqrt(diagonal);
+
+        for (std::size_t i = j + 1; i < n; ++i) {
+            double sum = A[i * n + j];
+            for (std::size_t l = 0; l < j; ++l) {
+                sum -= A[i * n + l] * A[j * n + l];
+            }
+            A[i * n + j] = sum / A[j * n + j];
+        }
+    }
+
+    // Forward then backward substitution
+    x.assign(n, 0.0);
+    for (std::size_t i = 0; i < n; ++i) {
+        double sum = g[i];
+        for (std::size_t l = 0; l < i; ++l) { sum -= A[i * n + l] * x[l]; }
+        x[i] = sum / A[i * n + i];
+    }
+    for (std::size_t i = n; i-- > 0;) {
+        double sum = x[i];
+        for (std::size_t l = i + 1; l < n; ++l) { sum -= A[l * n + i] * x[l]; }
+        x[i] = sum / A[i * n + i];
+    }
+    return true;
+}
@@ -0,0 +1,27 @@
+/**********************************************************************************************************************
+ * Cholesky decomposition of small dense symmetric positive definite matrices
+ *
+ * @note factor turns a correlation matrix into the lower triangular factor used to correlate Gaussian variates in the
+ * Monte Carlo engines. solve is the least-squares workhorse for small normal equations in row-major order
+ *********************************************************************************************************************/
+
+#ifndef CHOLESKY_HPP
+#define CHOLESKY_HPP
+
+#include <cstddef>
+#include <vector>
+
+class Cholesky {
+private:
+public:
+    // Lower triangular L with L L^T = A
+    static std::vector<std::vector<double>> factor(const std::vector<std::vector<double>>& A);
+
+    // Lower triangular L with L L^T = A, packed row-major in an n x n array with zeros above the diagonal
+    static std::vector<double> packed(const std::vector<std::vector<double>>& A);
+
+    // Solve A x = g for a symmetric positive definite A in row-major order
+    static bool solve(std::vector<double> A, std::vector<double> g, std::vector<double>& x);
+};
+
+#endif // CHOLESKY_HPP
@@ -0,0 +1,101 @@
+/**********************************************************************************************************************
+ * Load generator for the local pricing daemon - Main entry point
+ *
+ * Usage: ClientMain [address] [clients] [requests] [rows] [style]
+ *     address   unix:<path> or tcp:<port>. Defaults to unix:/tmp/pricing-server.sock
+ *     clients   Concurrent connections, each on its own thread. Defaults to 8
+ *     requests  Requests sent by each client. Defaults to 10000
+ *     rows      Option rows in each request. Defaults to 16
+ *     style     european or american. Defaults to european
+ *
+ * Each client sends a request, waits for its response, and records the round trip latency before sending the next one
+ *********************************************************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "LatencyStats.hpp"
+#include "PricingProtocol.hpp"
+#include "Socket.hpp"
+
+int main(int argc, char* argv[]) {
+
+    std::string address = argc > 1 ? argv[1] : "unix:/tmp/pricing-server.sock";
+    std::size_t clients = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 8;
+    std::size_t requests = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 10000;
+    std::uint32_t rows = argc > 4 ? static_cast<std::uint32_t>(std::strtoul(argv[4], nullptr, 10)) : 16;
+    std::string style = argc > 5 ? argv[5] : "european";
+
+    LatencyStats latency;
+    std::atomic<std::size_t> failures(0);
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> pool;
+    for (std::size_t c = 0; c < clients; ++c) {
+        pool.emplace_back([&, c] {
+            int fd = Socket::connect(address);
+            if (fd < 0) {
+                ++failures;
+                return;
+            }
+
+            // Spot moves across the rows so that each request prices a small strip
+            PricingProtocol::RequestHeader header{0, rows, style == "american" ? PricingProtocol::American
+                                                                                : PricingProtocol::European, 0};
+            std::vector<double> request(6 * static_cast<std::size_t>(rows));
+            for (std::uint32_t i = 0; i < rows; ++i) {
+                double *row = request.data() + 6 * i;
+                row[0] = 0.25; row[1] = 0.30; row[2] = 0.08; row[3] = 50.0 + i + c; row[4] = 65.0;
+                row[5] = header.style == PricingProtocol::American ? 0.02 : 0.08;
+            }
+
+            PricingProtocol::ResponseHeader reply{};
+            std::vector<double> response(2 * static_cast<std::size_t>(rows));
+            std::vector<double> samples;
+            samples.reserve(requests);
+
+            for (std::size_t k = 0; k < requests; ++k) {
+                header.id = static_cast<std::uint32_t>(k);
+
+                auto sent = std::chrono::steady_clock::now();
+                bool ok = Socket::write(fd, &header, sizeof(header))
+                          && Socket::write(fd, request.data(), request.size() * sizeof(double))
+                          && Socket::read(fd, &reply, sizeof(reply))
+                          && reply.id == header.id && reply.count == rows
+                          && Socket::read(fd, response.data(), response.size() * sizeof(double));
+                if (!ok) {
+                    ++failures;
+                    break;
+                }
+
+                std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - sent;
+                samples.push_back(elapsed.count());
+            }
+
+            latency.add(samples);
+            Socket::close(fd);
+        });
+    }
+
+    for (auto &thread : pool) {
+        thread.join();
+    }
+
+    std::chrono::duration<double> elapsedTime = std::chrono::steady_clock::now() - start;
+    std::vector<double> p = latency.percentiles({0.50, 0.99});
+
+    std::cout << "clients: " << clients << ", requests: " << latency.count() << ", rows/request: " << rows
+              << ", failures: " << failures << std::endl;
+    std::cout << "elapsed time: " << elapsedTime.count() << "s, throughput: "
+              << latency.count() / elapsedTime.count() << " requests/s, "
+              << latency.count() * rows / elapsedTime.count() << " rows/s" << std::endl;
+    std::cout << "round trip p50: " << p[0] << "us, p99: " << p[1] << "us" << std::endl;
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,28 @@
+/**********************************************************************************************************************
+ * Compact record of the parameters of one option contract
+ *
+ * @note A Contract is six doubles with no base classes, virtual functions, or policies, so it is trivially copyable and
+ * 48 bytes. Books of millions of contracts can be held in a std::vector<Contract>, copied with memcpy, and written to
+ * or loaded from a mapped file as one block. Pricing is done by a single engine, e.g. the static contract functions of
+ * EuropeanOption and AmericanOption, instead of an engine object per contract
+ *********************************************************************************************************************/
+
+#ifndef CONTRACT_HPP
+#define CONTRACT_HPP
+
+#include <type_traits>
+
+struct Contract {
+    double T;                                    // Expiry time/maturity. Ignored by perpetual American options
+    double sig;                                  // Volatility
+    double r;                                    // Risk-free interest rate
+    double S;                                    // Spot price
+    double K;                                    // Strike price
+    double b;                                    // Cost of carry
+};
+
+static_assert(std::is_trivially_copyable<Contract>::value, "Contract must be trivially copyable");
+static_assert(std::is_standard_layout<Contract>::value, "Contract must have a standard layout");
+static_assert(sizeof(Contract) == 6 * sizeof(double), "Contract must not be padded");
+
+#endif // CONTRACT_HPP
@@ -7,7 +7,13 @@
 #ifndef EUROPEANOPTION_CPP
 #define EUROPEANOPTION_CPP
 
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
 #include "EuropeanOption.hpp"
+#include "Adjoint.hpp"
+#include "HyperDual.hpp"
 #include "Mesher.hpp"
 #include "Matrix.hpp"
 #include "Output.hpp"
@@ -26,7 +32,9 @@
  */
 template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
 EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::EuropeanOption() : Mesher_(), Matrix_(), RNG_(), Output_(), T(0.25),
-sig(0.30), r(0.08), S(60), K(65), b(0.08) {}
+sig(0.30), r(0.08), S(60), K(65), b(0.08), cache() {
+    refresh();
+}
 
 /**
  * Initialize a new European Option, whose data members will be a deep copy of the source
@@ -42,7 +50,7 @@ sig(0.30), r(0.08), S(60), K(65), b(0.08) {}
 template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
 EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::EuropeanOption(const EuropeanOption<Mesher_, Matrix_, RNG_, Output_>
         &source) : Mesher_(), Matrix_(), RNG_(), Output_(), T(source.T), sig(source.sig), r(source.r), S(source.S),
-        K(source.K), b(source.b) {}
+        K(source.K), b(source.b), cache(source.cache) {}
 
 /**
  * Initialize a new EuropeanOption whose members are a deep copy of the source
@@ -57,7 +65,28 @@ EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::EuropeanOption(const EuropeanOp
  */
 template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
 EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::EuropeanOption(double T_, double sig_, double r_, double S_, double K_,
-        double b_) : Mesher_(), Matrix_(), RNG_(), Output_(), T(T_), sig(sig_), r(r_), S(S_), K(K_), b(b_) {}
+        double b_) : Mesher_(), Matrix_(), RNG_(), Output_(), T(T_), sig(sig_), r(r_), S(S_), K(K_), b(b_),
+        cache() {
+    refresh();
+}
+
+/**
+ * Initialize a new EuropeanOption from a compact contract record
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param contract_ The parameters of the option
+ * @throws OutOfMemoryError Indicates insufficient memory for this new EuropeanOption
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::EuropeanOption(const Contract &contract_) : Mesher_(), Matrix_(),
+        RNG_(), Output_(), T(contract_.T), sig(contract_.sig), r(contract_.r), S(contract_.S), K(contract_.K),
+        b(contract_.b), cache() {
+    refresh();
+}
 
 /**
  * Destroy this EuropeanOption
@@ -99,6 +128,14 @@ EuropeanOption<Mesher_, Matrix_, RNG_, Output_> &EuropeanOption<Mesher_, Matrix_
     RNG_::operator=(source);
     Output_::operator=(source);
 
+    T = source.T;
+    sig = source.sig;
+    r = source.r;
+    S = source.S;
+    K = source.K;
+    b = source.b;
+    cache = source.cache;
+
     return *this;
 }
 
@@ -119,7 +156,8 @@ EuropeanOption<Mesher_, Matrix_, RNG_, Output_> &EuropeanOption<Mesher_, Matrix_
  */
 template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
 std::vector<std::vector<double>> EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::delta() const {
-    return delta(T, sig, r, S, K, b);
+    const Cache &c = cache;
+    return {{c.callDelta, c.putDelta}};
 }
 
 /**
@@ -145,11 +183,9 @@ std::vector<std::vector<double>> EuropeanOption<Mesher_, Matrix_, RNG_, Output_>
 
     std::vector<std::vector<double>> deltas;
 
-    double d1 = (log(S_ / K_) + (b_ + (sig_ * sig_) * 0.5) * T_) / (sig_ * sqrt(T_));
-
     // Add call delta then put delta
-    double callDelta = exp((b_ - r_) * T_) * RNG_::CDF(d1);
-    double putDelta = exp((b_ - r_) * T_) * (RNG_::CDF(d1) - 1.0);
+    double callDelta, putDelta;
+    delta(T_, sig_, r_, S_, K_, b_, callDelta, putDelta);
 
     deltas.push_back({callDelta, putDelta});
 
@@ -193,7 +229,7 @@ EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::delta(const std::vector<std::ve
  */
 template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
 double EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::gamma() const {
-    return gamma(T, sig, r, S, K, b);
+    return cache.gamma;
 }
 
 /**
@@ -216,11 +252,38 @@ double EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::gamma() const {
 template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
 double EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::gamma(double T_, double sig_, double r_, double S_, double K_,
         double b_) {
-    double tmp = sig_ * sqrt(T_);
+    return gamma<double>(T_, sig_, r_, S_, K_, b_);
+}
+
+/**
+ * Closed form Gamma kernel generic in the numeric type
+ * @note Gamma is the rate of change in an options delta per one point move in the underlying asset's price
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @tparam Real Numeric type
+ * @param T_ Expiry
+ * @param sig_ Volatility
+ * @param r_ Risk-free rate
+ * @param S_ Spot price
+ * @param K_ Strike price
+ * @param b_ Cost of carry
+ * @return The rate of change with respect to the input parameters
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+template<typename Real>
+Real EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::gamma(const Real &T_, const Real &sig_, const Real &r_,
+        const Real &S_, const Real &K_, const Real &b_) {
+    using std::exp; using std::log; using std::sqrt;
 
-    double d1 = (log(S_ / K_) + (b_ + (sig_ * sig_) * 0.5) * T_) / tmp;
+    Real tmp = sig_ * sqrt(T_);
 
-    double n1 = RNG_::PDF(d1);
+    Real d1 = (log(S_ / K_) + (b_ + (sig_ * sig_) * Real(0.5)) * T_) / tmp;
+
+    Real n1 = normalPDF(d1);
 
     return (n1 * exp((b_ - r_) * T_)) / (S_ * tmp);
 }
@@ -251,368 +314,1564 @@ EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::gamma(const std::vector<std::ve
     return gammas;
 }
 
-/* ********************************************************************************************************************
- * FDM for Option sensitivities (Greeks)
- *********************************************************************************************************************/
-
 /**
- * FDM to approximate option this options delta using divided differences
- * @note Delta is the change in the option’s price or premium due to the change in the Underlying futures price
+ * Calculate closed form solution of Vega for this European Option
+ * @note Vega is the rate of change in an options price per unit change in volatility. Calls and Puts share one Vega
  * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
  * is separated by the step
  * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
  * increased by the Mesher
  * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
  * @tparam Output_ Output class that sends option data to a file specified by the user
- * @param h Difference parameter
- * @return A vector of Call and Put Delta Approximations
+ * @return Vega of this European Option
  */
 template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
-std::vector<std::vector<double>> EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::delta(double h) const {
-    return delta(h, T, sig, r, S, K, b);
+double EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::vega() const {
+    return cache.vega;
 }
 
 /**
- * FDM to approximate option delta using divided differences
- * @note Delta is the change in the option’s price or premium due to the change in the Underlying futures price
+ * Calculate closed form solution of Vega for the specified parameters
+ * @note Vega is the rate of change in an options price per unit change in volatility. Calls and Puts share one Vega
  * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
  * is separated by the step
  * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
  * increased by the Mesher
  * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
  * @tparam Output_ Output class that sends option data to a file specified by the user
- * @param h Difference parameter
  * @param T_ Expiry
  * @param sig_ Volatility
  * @param r_ Risk-free rate
  * @param S_ Spot price
  * @param K_ Strike price
  * @param b_ Cost of carry
- * @return A vector of Call and Put Delta Approximations
+ * @return The rate of change in price with respect to volatility
  */
 template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
-std::vector<std::vector<double>> EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::delta(double h, double T_,
-        double sig_, double r_, double S_, double K_, double b_) {
-
-    // Call and Put Deltas
-    std::vector<std::vector<double>> deltas;
-
-    // Placeholders for final numerator values
-    std::vector<double> LHS = price(T_, sig_, r_, S_ + h, K_, b_)[0];
-    std::vector<double> RHS = price(T_, sig_, r_, S_ - h, K_, b_)[0];
-
-    // Divided differences method
-    double callDelta = (LHS[0] - RHS[0]) / (2 * h);              // Call prices
-    double putDelta = (LHS[1] - RHS[1]) / (2 * h);               // Put prices
-
-    deltas.push_back({callDelta, putDelta});
-
-    return deltas;
+double EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::vega(double T_, double sig_, double r_, double S_, double K_,
+        double b_) {
+    return vega<double>(T_, sig_, r_, S_, K_, b_);
 }
 
 /**
- * FDM to approximate option delta using divided differences
- * @note Delta is the change in the option’s price or premium due to the change in the Underlying futures price
+ * Closed form Vega kernel generic in the numeric type
+ * @note Vega is the rate of change in an options price per unit change in volatility. Calls and Puts share one Vega
  * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
  * is separated by the step
  * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
  * increased by the Mesher
  * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
  * @tparam Output_ Output class that sends option data to a file specified by the user
- * @param h Difference parameter
- * @param matrix A matrix option parameters where each row has T, sig, r, S, K, b
- * @return The delta call or delta put approximation, which depends on the type of option provided
+ * @tparam Real Numeric type
+ * @param T_ Expiry
+ * @param sig_ Volatility
+ * @param r_ Risk-free rate
+ * @param S_ Spot price
+ * @param K_ Strike price
+ * @param b_ Cost of carry
+ * @return The rate of change in price with respect to volatility
  */
 template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
-std::vector<std::vector<double>>
-EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::delta(double h, const std::vector<std::vector<double> > &matrix) {
+template<typename Real>
+Real EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::vega(const Real &T_, const Real &sig_, const Real &r_,
+        const Real &S_, const Real &K_, const Real &b_) {
+    using std::exp; using std::log; using std::sqrt;
 
-    // Container for divided differences results
-    std::vector<std::vector<double>> deltaPrices;
+    Real sqrtT = sqrt(T_);
 
-    for (const auto &row : matrix) {
-        deltaPrices.push_back(delta(h, row[0], row[1], row[2], row[3], row[4], row[5])[0]);
-    }
+    Real d1 = (log(S_ / K_) + (b_ + (sig_ * sig_) * Real(0.5)) * T_) / (sig_ * sqrtT);
 
-    return deltaPrices;
+    return S_ * exp((b_ - r_) * T_) * normalPDF(d1) * sqrtT;
 }
 
 /**
- * FDM to approximate this options Gamma using divided differences
- * @note Gamma is the rate of change in an options delta per one point move in the underlying asset's price
+ * Allocation free closed form solution for Call and Put Delta
+ * @note Delta is the change in the option’s price or premium due to the change in the Underlying futures price
  * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
  * is separated by the step
  * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
  * increased by the Mesher
  * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
  * @tparam Output_ Output class that sends option data to a file specified by the user
- * @param h Difference parameter
- * @param option A call or put option used to approximate gamma
- * @return An approximation of Gamma for the given option
+ * @param T_ Expiry
+ * @param sig_ Volatility
+ * @param r_ Risk-free rate
+ * @param S_ Spot price
+ * @param K_ Strike price
+ * @param b_ Cost of carry
+ * @param callDelta Receives the Call Delta
+ * @param putDelta Receives the Put Delta
  */
 template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
-double EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::gamma(double h) const {
-    // Input for divided differences numerator
-    double S1 = price(T, sig, r, S + h, K, b)[0][0];
-    double S2 = 2 * price(T, sig, r, S, K, b)[0][0];
-    double S3 = price(T, sig, r, S - h, K, b)[0][0];
-
-    // Divided differences method
-    return (S1 - S2 + S3) / (h * h);
+void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::delta(double T_, double sig_, double r_, double S_, double K_,
+        double b_, double &callDelta, double &putDelta) {
+    delta<double>(T_, sig_, r_, S_, K_, b_, callDelta, putDelta);
 }
 
 /**
- * FDM to approximate Gamma using divided differences
- * @note Gamma is the rate of change in an options delta per one point move in the underlying asset's price
+ * Closed form Call and Put Delta kernel generic in the numeric type
+ * @note Delta is the change in the option’s price or premium due to the change in the Underlying futures price
  * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
  * is separated by the step
  * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
  * increased by the Mesher
  * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
  * @tparam Output_ Output class that sends option data to a file specified by the user
- * @param h Difference parameter
- * @param option A call or put option used to approximate gamma
- * @return An approximation of Gamma for the given option
+ * @tparam Real Numeric type
+ * @param T_ Expiry
+ * @param sig_ Volatility
+ * @param r_ Risk-free rate
+ * @param S_ Spot price
+ * @param K_ Strike price
+ * @param b_ Cost of carry
+ * @param callDelta Receives the Call Delta
+ * @param putDelta Receives the Put Delta
  */
 template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
-double EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::gamma(double h, const std::vector<double> &option) {
+template<typename Real>
+void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::delta(const Real &T_, const Real &sig_, const Real &r_,
+        const Real &S_, const Real &K_, const Real &b_, Real &callDelta, Real &putDelta) {
+    using std::exp; using std::log; using std::sqrt;
 
-    // Input for divided differences numerator
-    double S1 = (price(option[0], option[1], option[2], option[3] + h, option[4], option[5])[0][0]);
-    double S2 = 2 * (price(option[0], option[1], option[2], option[3], option[4], option[5])[0][0]);
-    double S3 = (price(option[0], option[1], option[2], option[3] - h, option[4], option[5])[0][0]);
+    Real d1 = (log(S_ / K_) + (b_ + (sig_ * sig_) * Real(0.5)) * T_) / (sig_ * sqrt(T_));
+    Real carry = exp((b_ - r_) * T_);
+    Real N1 = normalCDF(d1);
 
-    // Divided differences method
-    return (S1 - S2 + S3) / (h * h);
+    callDelta = carry * N1;
+    putDelta = carry * (N1 - Real(1.0));
 }
 
 /**
- * FDM to approximate Gamma using divided differences
- * @note Gamma is the rate of change in an options delta per one point move in the underlying asset's price
+ * Calculate closed form Call and Put Deltas for every row in a batch of options
+ * @note Delta is the change in the option’s price or premium due to the change in the Underlying futures price
  * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
  * is separated by the step
  * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
  * increased by the Mesher
  * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
  * @tparam Output_ Output class that sends option data to a file specified by the user
- * @return A matrix of Gamma approximations (one solution for each row of options in the input matrix)
+ * @tparam Real Numeric type of the batch columns (double or float)
+ * @tparam Allocator Allocator of the result vectors, e.g. std::pmr::polymorphic_allocator over an Arena
+ * @param batch Contiguous columns of option parameters (T, sig, r, S, K, b)
+ * @param callDeltas Receives one Call Delta per row. Resized to the size of the batch
+ * @param putDeltas Receives one Put Delta per row. Resized to the size of the batch
  */
 template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
-std::vector<double>
-EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::gamma(double h, const std::vector<std::vector<double>> &matrix) {
+template<typename Real, typename Allocator>
+void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::delta(const BasicOptionBatch<Real> &batch,
+        std::vector<Real, Allocator> &callDeltas, std::vector<Real, Allocator> &putDeltas) {
 
-    // Create a new container for each new matrix
-    std::vector<double> gammas;
+    std::size_t n = batch.size();
+    callDeltas.resize(n);
+    putDeltas.resize(n);
 
-    // Calculate exact gamma and put the result into the output matrix
-    for (const auto &i : matrix) {
-        gammas.push_back(gamma(h, i));
-    }
+    const Real *T_ = batch.expiry().data(), *sig_ = batch.vol().data(), *r_ = batch.riskFree().data();
+    const Real *S_ = batch.spot().data(), *K_ = batch.strike().data(), *b_ = batch.carry().data();
 
-    return gammas;
+    for (std::size_t i = 0; i < n; ++i) {
+        delta(T_[i], sig_[i], r_[i], S_[i], K_[i], b_[i], callDeltas[i], putDeltas[i]);
+    }
 }
 
-/* ********************************************************************************************************************
- * Core pricing functions - European Options
- *********************************************************************************************************************/
-
 /**
- * The core pricing engine that uses the Black-Scholes formula
+ * Calculate closed form Gamma for every row in a batch of options
+ * @note Gamma is the rate of change in an options delta per one point move in the underlying asset's price
  * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
  * is separated by the step
  * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
  * increased by the Mesher
  * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
  * @tparam Output_ Output class that sends option data to a file specified by the user
- * @param h Difference parameter
- * @param start Start point of interval
- * @param stop End point of interval
- * @param step The step size within the interval
- * @param property The option parameter which will be monotonically increased by the Mesher
+ * @tparam Real Numeric type of the batch columns (double or float)
+ * @tparam Allocator Allocator of the result vectors, e.g. std::pmr::polymorphic_allocator over an Arena
+ * @param batch Contiguous columns of option parameters (T, sig, r, S, K, b)
+ * @param gammas Receives one Gamma per row. Resized to the size of the batch
  */
 template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
-void
-EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::price(double h, double start, double stop, double step,
-        const std::string& property) const {
-
-    std::vector<double> mesh = Mesher_::xarr(start, stop, step);     // Generate the mesh points for the matrix
+template<typename Real, typename Allocator>
+void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::gamma(const BasicOptionBatch<Real> &batch,
+        std::vector<Real, Allocator> &gammas) {
 
-    std::vector<std::vector<double>> matrix = Matrix_::matrix(mesh, property, T, sig, r, S, K, b);
+    std::size_t n = batch.size();
+    gammas.resize(n);
 
-    // Create and fill containers with option data
-    std::vector<std::vector<double>> prices = price(matrix);
-    std::vector<std::vector<double>> deltas = delta(h, matrix);
-    std::vector<double>gammas = gamma(h, matrix);
+    const Real *T_ = batch.expiry().data(), *sig_ = batch.vol().data(), *r_ = batch.riskFree().data();
+    const Real *S_ = batch.spot().data(), *K_ = batch.strike().data(), *b_ = batch.carry().data();
 
-    // Send data to an output file
-    Output_::csv(mesh, prices, deltas, gammas);
+    for (std::size_t i = 0; i < n; ++i) {
+        gammas[i] = gamma(T_[i], sig_[i], r_[i], S_[i], K_[i], b_[i]);
+    }
 }
 
 /**
- * Core pricing functionality for this European Option
+ * Calculate closed form Vega for every row in a batch of options
+ * @note Vega is the rate of change in an options price per unit change in volatility. Calls and Puts share one Vega
  * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
  * is separated by the step
  * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
  * increased by the Mesher
  * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
  * @tparam Output_ Output class that sends option data to a file specified by the user
- * @return A matrix of Call and Put prices
+ * @tparam Real Numeric type of the batch columns (double or float)
+ * @tparam Allocator Allocator of the result vectors, e.g. std::pmr::polymorphic_allocator over an Arena
+ * @param batch Contiguous columns of option parameters (T, sig, r, S, K, b)
+ * @param vegas Receives one Vega per row. Resized to the size of the batch
  */
 template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
-std::vector<std::vector<double>> EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::price() const {
-    return price(T, sig, r, S, K, b);
+template<typename Real, typename Allocator>
+void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::vega(const BasicOptionBatch<Real> &batch,
+        std::vector<Real, Allocator> &vegas) {
+
+    std::size_t n = batch.size();
+    vegas.resize(n);
+
+    const Real *T_ = batch.expiry().data(), *sig_ = batch.vol().data(), *r_ = batch.riskFree().data();
+    const Real *S_ = batch.spot().data(), *K_ = batch.strike().data(), *b_ = batch.carry().data();
+
+    for (std::size_t i = 0; i < n; ++i) {
+        vegas[i] = vega(T_[i], sig_[i], r_[i], S_[i], K_[i], b_[i]);
+    }
 }
 
 /**
- * Receives a matrix of options and prices each of of them
+ * Price every row in a batch of options and find its Deltas with half the normal CDFs of price and delta
+ * @note Only the out of the money leg of each row is priced from the normal CDFs, the Call when S e^((b-r)T) is below
+ * K e^(-rT) and the Put otherwise. The other leg follows from Put-Call parity, C - P = S e^((b-r)T) - K e^(-rT), which
+ * adds the forward intrinsic value to a price at least as large as itself, so neither leg loses relative precision.
+ * N(d1) is one of the two CDFs of the priced leg, so the Call Delta costs nothing more and the Put Delta is the Call
+ * Delta less e^((b-r)T). A row costs two CDFs instead of the six of price and delta
  * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
  * is separated by the step
  * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
  * increased by the Mesher
  * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
  * @tparam Output_ Output class that sends option data to a file specified by the user
- * @param matrix Option parameters
- * @return A matrix of option prices
+ * @tparam Real Numeric type of the batch columns (double or float)
+ * @tparam Allocator Allocator of the result vectors, e.g. std::pmr::polymorphic_allocator over an Arena
+ * @param batch Contiguous columns of option parameters (T, sig, r, S, K, b)
+ * @param calls Receives one Call price per row. Resized to the size of the batch
+ * @param puts Receives one Put price per row. Resized to the size of the batch
+ * @param callDeltas Receives one Call Delta per row. Resized to the size of the batch
+ * @param putDeltas Receives one Put Delta per row. Resized to the size of the batch
  */
 template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
-std::vector<std::vector<double> >
-EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::price(const std::vector<std::vector<double> > &matrix) {
-
-    // Create a new container for each new matrix
-    std::vector<std::vector<double> > prices;
-
-    for (const auto &row : matrix) {
-        // Each row in the matrix has a Call and Put price
-        prices.push_back(price(row[0], row[1], row[2], row[3], row[4], row[5])[0]);
+template<typename Real, typename Allocator>
+void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::priceParity(const BasicOptionBatch<Real> &batch,
+        std::vector<Real, Allocator> &calls, std::vector<Real, Allocator> &puts,
+        std::vector<Real, Allocator> &callDeltas, std::vector<Real, Allocator> &putDeltas) {
+    using std::exp; using std::log; using std::sqrt;
+
+    std::size_t n = batch.size();
+    calls.resize(n);
+    puts.resize(n);
+    callDeltas.resize(n);
+    putDeltas.resize(n);
+
+    const Real *T_ = batch.expiry().data(), *sig_ = batch.vol().data(), *r_ = batch.riskFree().data();
+    const Real *S_ = batch.spot().data(), *K_ = batch.strike().data(), *b_ = batch.carry().data();
+
+    for (std::size_t i = 0; i < n; ++i) {
+        Real vst = sig_[i] * sqrt(T_[i]);
+        Real d1 = (log(S_[i] / K_[i]) + (b_[i] + (sig_[i] * sig_[i]) * Real(0.5)) * T_[i]) / vst;
+        Real growth = exp((b_[i] - r_[i]) * T_[i]);
+        Real carry = S_[i] * growth;
+        Real discount = K_[i] * exp(-r_[i] * T_[i]);
+        Real forward = carry - discount;
+
+        // s is 1 when the Call is out of the money and -1 when the Put is, which folds both legs into one formula
+        Real s = forward < Real(0.0) ? Real(1.0) : Real(-1.0);
+        Real N1 = normalCDF(s * d1);
+        Real leg = s * ((carry * N1) - (discount * normalCDF(s * (d1 - vst))));
+
+        Real call = forward < Real(0.0) ? leg : leg + forward;
+        Real Nd1 = forward < Real(0.0) ? N1 : Real(1.0) - N1;
+
+        calls[i] = call;
+        puts[i] = call - forward;
+        callDeltas[i] = growth * Nd1;
+        putDeltas[i] = growth * (Nd1 - Real(1.0));
     }
-    return prices;
 }
 
-/*
- * Private helper function used to price this option or option data provided by the input matrix
+/**
+ * Check Put-Call parity for every row in a batch of priced options
+ * @note The residual C - P - (S e^((b-r)T) - K e^(-rT)) of each row is formed in one branch free pass over the columns,
+ * so the check can follow any batch pricing, e.g. priceFloatCore or a float batch, at the cost of two exponentials per
+ * row
  * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
  * is separated by the step
  * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
  * increased by the Mesher
  * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
  * @tparam Output_ Output class that sends option data to a file specified by the user
- * @param T Expiry
- * @param sig Volatility
- * @param r Risk-free rate
- * @param S Spot price
- * @param K Strike price
- * @param b Cost of carry
- * @return A vector of Call and Put prices
+ * @tparam Real Numeric type of the batch columns (double or float)
+ * @tparam Allocator Allocator of the result vectors, e.g. std::pmr::polymorphic_allocator over an Arena
+ * @param batch Contiguous columns of option parameters (T, sig, r, S, K, b)
+ * @param calls One Call price per row
+ * @param puts One Put price per row
+ * @param residuals Receives the parity residual of each row. Resized to the size of the batch
+ * @param tolerance Largest absolute residual that satisfies parity. The default value is 1e-5
+ * @return Number of rows whose residual exceeds the tolerance
+ * @throws std::invalid_argument If calls or puts do not have one price per row of the batch
  */
 template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
-std::vector<std::vector<double>> EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::price(double T_, double sig_, double r_,
-        double S_, double K_, double b_) {
-
-    std::vector<std::vector<double>> prices;
-
-    double tmp = sig_ * sqrt(T_);
-    double d1 = (log(S_ / K_) + (b_ + (sig_ * sig_) * 0.5) * T_) / tmp;
-    double d2 = d1 - tmp;
-
-    // Call and Put prices
-    double call = (S_ * exp((b_ - r_) * T_) * RNG_::CDF(d1)) - (K_ * exp(-r_ * T_) * RNG_::CDF(d2));
-    double put = (K_ * exp(-r_ * T_) * RNG_::CDF(-d2)) - (S_ * exp((b_ - r_) * T_) * RNG_::CDF(-d1));
-
-    prices.push_back({call, put});
-
-    return prices;
+template<typename Real, typename Allocator>
+std::size_t EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::parityViolations(const BasicOptionBatch<Real> &batch,
+        const std::vector<Real, Allocator> &calls, const std::vector<Real, Allocator> &puts,
+        std::vector<Real, Allocator> &residuals, Real tolerance) {
+    using std::exp;
+
+    std::size_t n = batch.size();
+    if (calls.size() != n || puts.size() != n) {
+        throw std::invalid_argument("parityViolations needs one Call and one Put price per row of the batch");
+    }
+    residuals.resize(n);
+
+    const Real *T_ = batch.expiry().data(), *r_ = batch.riskFree().data();
+    const Real *S_ = batch.spot().data(), *K_ = batch.strike().data(), *b_ = batch.carry().data();
+    const Real *C = calls.data(), *P = puts.data();
+    Real *residual = residuals.data();
+
+    std::size_t violations = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        Real forward = S_[i] * exp((b_[i] - r_[i]) * T_[i]) - K_[i] * exp(-r_[i] * T_[i]);
+        residual[i] = C[i] - P[i] - forward;
+        violations += std::abs(residual[i]) > tolerance ? 1 : 0;
+    }
+    return violations;
 }
 
-/* ********************************************************************************************************************
- * Put Call Parity
- *********************************************************************************************************************/
-
 /**
- * A mechanism to calculate the call (or put) price for a corresponding put (or call) price
+ * Price every contract in a book of compact contract records
+ * @note The records hold no policies, so one engine prices the whole book without an object per contract
  * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
  * is separated by the step
  * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
  * increased by the Mesher
  * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
  * @tparam Output_ Output class that sends option data to a file specified by the user
- * @param optionPrice
- * @param optType_ Call or Put. The default value is a Call
- * @return The price that satisfies the put-call parity relationship
+ * @param contracts Option parameters, one record per contract
+ * @param calls Receives one Call price per contract. Resized to the size of the book
+ * @param puts Receives one Put price per contract. Resized to the size of the book
  */
 template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
-double EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::putCallParity(double optionPrice, const std::string& optType_) const {
-    if (optType_ == "Put" || optType_ == "put") {
-        return optionPrice + S - (K * exp(-r * T));
-    } else {
-        return optionPrice + (K * exp(-r * T)) - S;
+void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::price(const std::vector<Contract> &contracts,
+        std::vector<double> &calls, std::vector<double> &puts) {
+
+    std::size_t n = contracts.size();
+    calls.resize(n);
+    puts.resize(n);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const Contract &c = contracts[i];
+        price(c.T, c.sig, c.r, c.S, c.K, c.b, calls[i], puts[i]);
     }
 }
 
 /**
- * Mechanism to check if a given set of call (C) and put (P) prices satisfy parity
+ * Calculate closed form Call and Put Deltas for every contract in a book of compact contract records
+ * @note Delta is the change in the option’s price or premium due to the change in the Underlying futures price
  * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
  * is separated by the step
  * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
  * increased by the Mesher
  * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
  * @tparam Output_ Output class that sends option data to a file specified by the user
- * @param putPrice
- * @param callPrice
- * @return True if the relationship is satisfied. Otherwise false
+ * @param contracts Option parameters, one record per contract
+ * @param callDeltas Receives one Call Delta per contract. Resized to the size of the book
+ * @param putDeltas Receives one Put Delta per contract. Resized to the size of the book
  */
 template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
-bool EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::putCallParity(double callPrice, double putPrice) const {
-    return putCallParity(callPrice, putPrice, T, K, r, S);
+void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::delta(const std::vector<Contract> &contracts,
+        std::vector<double> &callDeltas, std::vector<double> &putDeltas) {
+
+    std::size_t n = contracts.size();
+    callDeltas.resize(n);
+    putDeltas.resize(n);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const Contract &c = contracts[i];
+        delta(c.T, c.sig, c.r, c.S, c.K, c.b, callDeltas[i], putDeltas[i]);
+    }
 }
 
-/*
- * Helper function to check if a given set of call (C) and put (P) prices satisfy parity (tolerance = 1e-5)
+/**
+ * Calculate closed form Gamma for every contract in a book of compact contract records
+ * @note Gamma is the rate of change in an options delta per one point move in the underlying asset's price
  * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
  * is separated by the step
  * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
  * increased by the Mesher
  * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
  * @tparam Output_ Output class that sends option data to a file specified by the user
- * @param C Call price
- * @param P Put price
- * @param T_ Expiry
- * @param K_ Strike price
- * @param r_ Risk-Free Rate
- * @param S_ Spot price
- * @return True if Put-Call Parity is satisfied. False otherwise
+ * @param contracts Option parameters, one record per contract
+ * @param gammas Receives one Gamma per contract. Resized to the size of the book
  */
 template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
-bool EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::putCallParity(double C, double P, double T_, double K_, double r_,
-        double S_) {
-    return ((C + (K_ * exp(-r_ * T_))) - (P + S_)) <= 1e-5;
-}
+void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::gamma(const std::vector<Contract> &contracts,
+        std::vector<double> &gammas) {
 
-/* ********************************************************************************************************************
- * Accessors
- *********************************************************************************************************************/
+    std::size_t n = contracts.size();
+    gammas.resize(n);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const Contract &c = contracts[i];
+        gammas[i] = gamma(c.T, c.sig, c.r, c.S, c.K, c.b);
+    }
+}
 
 /**
- * Accessor that retrieves this options Expiry
+ * Calculate closed form Vega for every contract in a book of compact contract records
+ * @note Vega is the rate of change in an options price per unit change in volatility. Calls and Puts share one Vega
  * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
  * is separated by the step
  * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
  * increased by the Mesher
  * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
  * @tparam Output_ Output class that sends option data to a file specified by the user
- * @return Expiry of this Option
+ * @param contracts Option parameters, one record per contract
+ * @param vegas Receives one Vega per contract. Resized to the size of the book
  */
 template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
-double EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::expiry() const {return T;}
+void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::vega(const std::vector<Contract> &contracts,
+        std::vector<double> &vegas) {
+
+    std::size_t n = contracts.size();
+    vegas.resize(n);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const Contract &c = contracts[i];
+        vegas[i] = vega(c.T, c.sig, c.r, c.S, c.K, c.b);
+    }
+}
 
 /**
- * Accessor that retrieves this options Volatility
+ * Exact first and second order sensitivities with respect to any two option parameters
+ * @note The pricing kernel is evaluated once on hyper-dual numbers, so there is no difference parameter to tune and
+ * no extra pricing. For example i = j = 3 gives Delta and Gamma, i = j = 1 gives Vega and Volga, and i = 3, j = 1 gives
+ * Delta, Vega, and Vanna
  * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
  * is separated by the step
  * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
  * increased by the Mesher
  * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
  * @tparam Output_ Output class that sends option data to a file specified by the user
- * @return Volatility of this option
+ * @param option Option parameters T, sig, r, S, K, b
+ * @param i Position of the first parameter in the option
+ * @param j Position of the second parameter in the option
+ * @param call Receives the Call price, dC/di, dC/dj, and d2C/didj
+ * @param put Receives the Put price, dP/di, dP/dj, and d2P/didj
+ * @throws std::invalid_argument If the option has fewer than 6 parameters or if i or j is not a parameter position
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::derivatives(const std::vector<double> &option, std::size_t i,
+        std::size_t j, std::vector<double> &call, std::vector<double> &put) {
+    if (option.size() < 6) {
+        throw std::invalid_argument("The option needs the parameters T, sig, r, S, K, and b");
+    }
+    if (i >= 6 || j >= 6) {
+        throw std::invalid_argument("Parameter positions must be between 0 and 5");
+    }
+
+    HyperDual x[6];
+    for (std::size_t k = 0; k < 6; ++k) {
+        x[k] = HyperDual(option[k], k == i ? 1.0 : 0.0, k == j ? 1.0 : 0.0, 0.0);
+    }
+
+    HyperDual c, p;
+    price(x[0], x[1], x[2], x[3], x[4], x[5], c, p);
+
+    call = {c.value(), c.first(), c.second(), c.cross()};
+    put = {p.value(), p.first(), p.second(), p.cross()};
+}
+
+/* ********************************************************************************************************************
+ * FDM for Option sensitivities (Greeks)
+ *********************************************************************************************************************/
+
+/**
+ * FDM to approximate option this options delta using divided differences
+ * @note Delta is the change in the option’s price or premium due to the change in the Underlying futures price
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param h Difference parameter
+ * @return A vector of Call and Put Delta Approximations
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+std::vector<std::vector<double>> EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::delta(double h) const {
+    return delta(h, T, sig, r, S, K, b);
+}
+
+/**
+ * FDM to approximate option delta using divided differences
+ * @note Delta is the change in the option’s price or premium due to the change in the Underlying futures price
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param h Difference parameter
+ * @param T_ Expiry
+ * @param sig_ Volatility
+ * @param r_ Risk-free rate
+ * @param S_ Spot price
+ * @param K_ Strike price
+ * @param b_ Cost of carry
+ * @return A vector of Call and Put Delta Approximations
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+std::vector<std::vector<double>> EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::delta(double h, double T_,
+        double sig_, double r_, double S_, double K_, double b_) {
+
+    // Call and Put Deltas
+    std::vector<std::vector<double>> deltas;
+
+    // Placeholders for final numerator values
+    std::vector<double> LHS = price(T_, sig_, r_, S_ + h, K_, b_)[0];
+    std::vector<double> RHS = price(T_, sig_, r_, S_ - h, K_, b_)[0];
+
+    // Divided differences method
+    double callDelta = (LHS[0] - RHS[0]) / (2 * h);              // Call prices
+    double putDelta = (LHS[1] - RHS[1]) / (2 * h);               // Put prices
+
+    deltas.push_back({callDelta, putDelta});
+
+    return deltas;
+}
+
+/**
+ * FDM to approximate option delta using divided differences
+ * @note Delta is the change in the option’s price or premium due to the change in the Underlying futures price
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param h Difference parameter
+ * @param matrix A matrix option parameters where each row has T, sig, r, S, K, b
+ * @return The delta call or delta put approximation, which depends on the type of option provided
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+std::vector<std::vector<double>>
+EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::delta(double h, const std::vector<std::vector<double> > &matrix) {
+
+    // Container for divided differences results
+    std::vector<std::vector<double>> deltaPrices;
+
+    for (const auto &row : matrix) {
+        deltaPrices.push_back(delta(h, row[0], row[1], row[2], row[3], row[4], row[5])[0]);
+    }
+
+    return deltaPrices;
+}
+
+/**
+ * FDM to approximate this options Gamma using divided differences
+ * @note Gamma is the rate of change in an options delta per one point move in the underlying asset's price
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param h Difference parameter
+ * @param option A call or put option used to approximate gamma
+ * @return An approximation of Gamma for the given option
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+double EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::gamma(double h) const {
+    // Input for divided differences numerator
+    double S1 = price(T, sig, r, S + h, K, b)[0][0];
+    double S2 = 2 * cache.call;
+    double S3 = price(T, sig, r, S - h, K, b)[0][0];
+
+    // Divided differences method
+    return (S1 - S2 + S3) / (h * h);
+}
+
+/**
+ * FDM to approximate Gamma using divided differences
+ * @note Gamma is the rate of change in an options delta per one point move in the underlying asset's price
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param h Difference parameter
+ * @param option A call or put option used to approximate gamma
+ * @return An approximation of Gamma for the given option
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+double EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::gamma(double h, const std::vector<double> &option) {
+
+    // Input for divided differences numerator
+    double S1 = (price(option[0], option[1], option[2], option[3] + h, option[4], option[5])[0][0]);
+    double S2 = 2 * (price(option[0], option[1], option[2], option[3], option[4], option[5])[0][0]);
+    double S3 = (price(option[0], option[1], option[2], option[3] - h, option[4], option[5])[0][0]);
+
+    // Divided differences method
+    return (S1 - S2 + S3) / (h * h);
+}
+
+/**
+ * FDM to approximate Gamma using divided differences
+ * @note Gamma is the rate of change in an options delta per one point move in the underlying asset's price
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @return A matrix of Gamma approximations (one solution for each row of options in the input matrix)
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+std::vector<double>
+EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::gamma(double h, const std::vector<std::vector<double>> &matrix) {
+
+    // Create a new container for each new matrix
+    std::vector<double> gammas;
+
+    // Calculate exact gamma and put the result into the output matrix
+    for (const auto &i : matrix) {
+        gammas.push_back(gamma(h, i));
+    }
+
+    return gammas;
+}
+
+/* ********************************************************************************************************************
+ * Core pricing functions - European Options
+ *********************************************************************************************************************/
+
+/**
+ * The core pricing engine that uses the Black-Scholes formula
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param h Difference parameter
+ * @param start Start point of interval
+ * @param stop End point of interval
+ * @param step The step size within the interval
+ * @param property The option parameter which will be monotonically increased by the Mesher
+ * @throws std::invalid_argument If the property is not one of T, sig, r, S, K, or b
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+void
+EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::price(double h, double start, double stop, double step,
+        const std::string& property) const {
+
+    std::vector<double> mesh = Mesher_::xarr(start, stop, step);     // Generate the mesh points for the matrix
+
+    // Create and fill containers with option data
+    std::vector<std::vector<double>> prices, deltas;
+    std::vector<double> gammas;
+    sweep(h, mesh, property, T, sig, r, S, K, b, prices, deltas, gammas);
+
+    // Send data to an output file
+    Output_::csv(mesh, prices, deltas, gammas);
+}
+
+/**
+ * Core pricing functionality for this European Option
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @return A matrix of Call and Put prices
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+std::vector<std::vector<double>> EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::price() const {
+    const Cache &c = cache;
+    return {{c.call, c.put}};
+}
+
+/*
+ * Set a parameter and invalidate the cached groups that depend on it. The caller refreshes the cache
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param parameter The data member to set
+ * @param value Its new value. Nothing is invalidated if it is unchanged
+ * @param keep Groups that do not depend on the parameter
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::assign(double &parameter, double value, unsigned char keep) {
+    if (value == parameter) { return; }
+    parameter = value;
+    cache.valid &= keep;
+}
+
+/*
+ * Bring the invalidated groups of the cache up to date
+ * @note Called by the constructors and mutators only, so const member functions never write the cache. Uses the same
+ * expressions, in the same order, as the static kernels, so the cached results are bit for bit equal to theirs
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::refresh() {
+
+    if (cache.valid == (Diffusion | Discounting | Moneyness)) { return; }
+
+    if (!(cache.valid & Diffusion)) {
+        cache.sqrtT = std::sqrt(T);
+        cache.vst = sig * cache.sqrtT;
+        cache.drift = (b + (sig * sig) * 0.5) * T;
+    }
+
+    if (!(cache.valid & Discounting)) {
+        cache.growth = std::exp((b - r) * T);
+        cache.discount = K * std::exp(-r * T);
+    }
+
+    if (!(cache.valid & Moneyness)) {
+        double d1 = (std::log(S / K) + cache.drift) / cache.vst;
+        double d2 = d1 - cache.vst;
+        double N1 = normalCDF(d1);
+        double carry = S * cache.growth;
+
+        cache.d1 = d1;
+        cache.n1 = normalPDF(d1);
+        cache.call = (carry * N1) - (cache.discount * normalCDF(d2));
+        cache.put = (cache.discount * normalCDF(-d2)) - (carry * normalCDF(-d1));
+        cache.callDelta = cache.growth * N1;
+        cache.putDelta = cache.growth * (N1 - 1.0);
+        cache.gamma = (cache.n1 * cache.growth) / (S * cache.vst);
+        cache.vega = carry * cache.n1 * cache.sqrtT;
+    }
+
+    cache.valid = Diffusion | Discounting | Moneyness;
+}
+
+/**
+ * Receives a matrix of options and prices each of of them
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param matrix Option parameters
+ * @return A matrix of option prices
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+std::vector<std::vector<double> >
+EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::price(const std::vector<std::vector<double> > &matrix) {
+
+    // Create a new container for each new matrix
+    std::vector<std::vector<double> > prices;
+
+    for (const auto &row : matrix) {
+        // Each row in the matrix has a Call and Put price
+        prices.push_back(price(row[0], row[1], row[2], row[3], row[4], row[5])[0]);
+    }
+    return prices;
+}
+
+/*
+ * Private helper function used to price this option or option data provided by the input matrix
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param T Expiry
+ * @param sig Volatility
+ * @param r Risk-free rate
+ * @param S Spot price
+ * @param K Strike price
+ * @param b Cost of carry
+ * @return A vector of Call and Put prices
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+std::vector<std::vector<double>> EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::price(double T_, double sig_, double r_,
+        double S_, double K_, double b_) {
+
+    std::vector<std::vector<double>> prices;
+
+    // Call and Put prices
+    double call, put;
+    price(T_, sig_, r_, S_, K_, b_, call, put);
+
+    prices.push_back({call, put});
+
+    return prices;
+}
+
+/**
+ * Allocation free Black-Scholes pricing kernel shared by the single option, matrix, and batch pricing functions
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param T_ Expiry
+ * @param sig_ Volatility
+ * @param r_ Risk-free rate
+ * @param S_ Spot price
+ * @param K_ Strike price
+ * @param b_ Cost of carry
+ * @param call Receives the Call price
+ * @param put Receives the Put price
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::price(double T_, double sig_, double r_, double S_, double K_,
+        double b_, double &call, double &put) {
+    price<double>(T_, sig_, r_, S_, K_, b_, call, put);
+}
+
+/**
+ * Black-Scholes pricing kernel generic in the numeric type
+ * @note Instantiated with double and float by the pricing functions, with Adjoint by sensitivities, and with HyperDual
+ * by derivatives. Elementary functions are found by argument dependent lookup, so any numeric type that provides exp, log,
+ * sqrt, and CDF can be used
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @tparam Real Numeric type
+ * @param T_ Expiry
+ * @param sig_ Volatility
+ * @param r_ Risk-free rate
+ * @param S_ Spot price
+ * @param K_ Strike price
+ * @param b_ Cost of carry
+ * @param call Receives the Call price
+ * @param put Receives the Put price
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+template<typename Real>
+void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::price(const Real &T_, const Real &sig_, const Real &r_,
+        const Real &S_, const Real &K_, const Real &b_, Real &call, Real &put) {
+    using std::exp; using std::log; using std::sqrt;
+
+    Real tmp = sig_ * sqrt(T_);
+    Real d1 = (log(S_ / K_) + (b_ + (sig_ * sig_) * Real(0.5)) * T_) / tmp;
+    Real d2 = d1 - tmp;
+
+    Real carry = S_ * exp((b_ - r_) * T_);
+    Real discount = K_ * exp(-r_ * T_);
+
+    call = (carry * normalCDF(d1)) - (discount * normalCDF(d2));
+    put = (discount * normalCDF(-d2)) - (carry * normalCDF(-d1));
+}
+
+/**
+ * Price a sweep of one property, e.g. the rows of Matrix::matrix(mesh, property, T, sig, r, S, K, b)
+ * @note Terms that do not depend on the swept property are computed once. A row of a spot or strike sweep costs one log
+ * and two normal CDFs, a volatility sweep needs no log at all, and an expiry sweep adds a square root and two
+ * exponentials. Risk-free rate and cost of carry sweeps, which the Matrix policy couples as b = r, are priced row by row
+ * from the matrix with the generic kernel, which allocates the matrix
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @tparam Allocator Allocator of the mesh and result vectors, e.g. std::pmr::polymorphic_allocator over an Arena
+ * @param mesh Values of the swept property
+ * @param property The swept property (e.g. T, sig, r, S, K, b)
+ * @param T_ Expiry
+ * @param sig_ Volatility
+ * @param r_ Risk-free rate
+ * @param S_ Spot price
+ * @param K_ Strike price
+ * @param b_ Cost of carry
+ * @param calls Receives one Call price per mesh point. Resized to the size of the mesh
+ * @param puts Receives one Put price per mesh point. Resized to the size of the mesh
+ * @throws std::invalid_argument If the property is not one of T, sig, r, S, K, or b
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+template<typename Allocator>
+void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::sweep(const std::vector<double, Allocator> &mesh,
+        const std::string &property, double T_, double sig_, double r_, double S_, double K_, double b_,
+        std::vector<double, Allocator> &calls, std::vector<double, Allocator> &puts) {
+
+    if (Matrix_::property(property) == Matrix_::Property::Unknown) {
+        throw std::invalid_argument("Unknown sweep property: " + property);
+    }
+
+    std::size_t n = mesh.size();
+    calls.resize(n);
+    puts.resize(n);
+
+    switch (Matrix_::property(property)) {
+        case Matrix_::Property::Spot: {
+            double vst = sig_ * std::sqrt(T_);
+            double drift = (b_ + (sig_ * sig_) * 0.5) * T_ - std::log(K_);
+            double growth = std::exp((b_ - r_) * T_);
+            double discount = K_ * std::exp(-r_ * T_);
+
+            for (std::size_t i = 0; i < n; ++i) {
+                double d1 = (std::log(mesh[i]) + drift) / vst;
+                legs(d1, vst, mesh[i] * growth, discount, calls[i], puts[i]);
+            }
+            break;
+        }
+        case Matrix_::Property::Strike: {
+            double vst = sig_ * std::sqrt(T_);
+            double drift = std::log(S_) + (b_ + (sig_ * sig_) * 0.5) * T_;
+            double carry = S_ * std::exp((b_ - r_) * T_);
+            double df = std::exp(-r_ * T_);
+
+            for (std::size_t i = 0; i < n; ++i) {
+                double d1 = (drift - std::log(mesh[i])) / vst;
+                legs(d1, vst, carry, mesh[i] * df, calls[i], puts[i]);
+            }
+            break;
+        }
+        case Matrix_::Property::Volatility: {
+            double moneyness = std::log(S_ / K_);
+            double sqrtT = std::sqrt(T_);
+            double carry = S_ * std::exp((b_ - r_) * T_);
+            double discount = K_ * std::exp(-r_ * T_);
+
+            for (std::size_t i = 0; i < n; ++i) {
+                double sig = mesh[i], vst = sig * sqrtT;
+                double d1 = (moneyness + (b_ + (sig * sig) * 0.5) * T_) / vst;
+                legs(d1, vst, carry, discount, calls[i], puts[i]);
+            }
+            break;
+        }
+        case Matrix_::Property::Expiry: {
+            double moneyness = std::log(S_ / K_);
+            double drift = b_ + (sig_ * sig_) * 0.5;
+
+            for (std::size_t i = 0; i < n; ++i) {
+                double T = mesh[i], vst = sig_ * std::sqrt(T);
+                double d1 = (moneyness + drift * T) / vst;
+                legs(d1, vst, S_ * std::exp((b_ - r_) * T), K_ * std::exp(-r_ * T), calls[i], puts[i]);
+            }
+            break;
+        }
+        default: {
+            std::vector<std::vector<double>> matrix = Matrix_::matrix(std::vector<double>(mesh.begin(), mesh.end()),
+                                                                      property, T_, sig_, r_, S_, K_, b_);
+            calls.resize(matrix.size());
+            puts.resize(matrix.size());
+            for (std::size_t i = 0; i < matrix.size(); ++i) {
+                const std::vector<double> &row = matrix[i];
+                price(row[0], row[1], row[2], row[3], row[4], row[5], calls[i], puts[i]);
+            }
+        }
+    }
+}
+
+/**
+ * Prices and divided difference Deltas and Gammas of a sweep of one property
+ * @note Returns the rows of price(matrix), delta(h, matrix), and gamma(h, matrix) for the matrix of the sweep. When the
+ * spot is swept on a mesh whose spacing is h, the bumped prices of a row are the prices of its neighbors, so the mesh
+ * extended by one point at each end is priced once and each row costs one pricing instead of three. The differences
+ * then use the actual spacing of the neighbors, which absorbs the rounding of an accumulated mesh. Otherwise the mesh
+ * is priced with the spot bumped up and down. Temporary buffers come from the allocator of the mesh, so with an Arena
+ * a repeated sweep makes no heap allocations once the Arena has grown to fit it
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @tparam Allocator Allocator of the mesh and result vectors, e.g. std::pmr::polymorphic_allocator over an Arena
+ * @param h Difference parameter
+ * @param mesh Values of the swept property
+ * @param property The swept property (e.g. T, sig, r, S, K, b)
+ * @param T_ Expiry
+ * @param sig_ Volatility
+ * @param r_ Risk-free rate
+ * @param S_ Spot price
+ * @param K_ Strike price
+ * @param b_ Cost of carry
+ * @param calls Receives one Call price per mesh point
+ * @param puts Receives one Put price per mesh point
+ * @param callDeltas Receives one Call Delta per mesh point
+ * @param putDeltas Receives one Put Delta per mesh point
+ * @param gammas Receives one Gamma per mesh point
+ * @throws std::invalid_argument If the property is not one of T, sig, r, S, K, or b
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+template<typename Allocator>
+void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::sweep(double h, const std::vector<double, Allocator> &mesh,
+        const std::string &property, double T_, double sig_, double r_, double S_, double K_, double b_,
+        std::vector<double, Allocator> &calls, std::vector<double, Allocator> &puts,
+        std::vector<double, Allocator> &callDeltas, std::vector<double, Allocator> &putDeltas,
+        std::vector<double, Allocator> &gammas) {
+
+    // Reject an unknown property before any output is resized, so all five outputs keep matching lengths
+    if (Matrix_::property(property) == Matrix_::Property::Unknown) {
+        throw std::invalid_argument("Unknown sweep property: " + property);
+    }
+
+    std::size_t n = mesh.size();
+    callDeltas.resize(n);
+    putDeltas.resize(n);
+    gammas.resize(n);
+
+    if (Matrix_::property(property) == Matrix_::Property::Spot && neighbors(mesh, h)) {
+        std::vector<double, Allocator> x(mesh.get_allocator());
+        std::vector<double, Allocator> xCalls(mesh.get_allocator()), xPuts(mesh.get_allocator());
+        x.reserve(n + 2);
+        x.push_back(mesh.front() - h);
+        x.insert(x.end(), mesh.begin(), mesh.end());
+        x.push_back(mesh.back() + h);
+
+        sweep(x, property, T_, sig_, r_, S_, K_, b_, xCalls, xPuts);
+
+        calls.assign(xCalls.begin() + 1, xCalls.end() - 1);
+        puts.assign(xPuts.begin() + 1, xPuts.end() - 1);
+        for (std::size_t i = 1; i <= n; ++i) {
+            double lower = x[i] - x[i - 1], upper = x[i + 1] - x[i], width = x[i + 1] - x[i - 1];
+            callDeltas[i - 1] = (xCalls[i + 1] - xCalls[i - 1]) / width;
+            putDeltas[i - 1] = (xPuts[i + 1] - xPuts[i - 1]) / width;
+            gammas[i - 1] = 2 * ((xCalls[i + 1] - xCalls[i]) / upper - (xCalls[i] - xCalls[i - 1]) / lower) / width;
+        }
+        return;
+    }
+
+    std::vector<double, Allocator> upCalls(mesh.get_allocator()), upPuts(mesh.get_allocator());
+    std::vector<double, Allocator> downCalls(mesh.get_allocator()), downPuts(mesh.get_allocator());
+    sweep(mesh, property, T_, sig_, r_, S_, K_, b_, calls, puts);
+    if (Matrix_::property(property) == Matrix_::Property::Spot) {
+        std::vector<double, Allocator> bumped(mesh, mesh.get_allocator());
+        for (std::size_t i = 0; i < n; ++i) {
+            bumped[i] = mesh[i] + h;
+        }
+        sweep(bumped, property, T_, sig_, r_, S_, K_, b_, upCalls, upPuts);
+        for (std::size_t i = 0; i < n; ++i) {
+            bumped[i] = mesh[i] - h;
+        }
+        sweep(bumped, property, T_, sig_, r_, S_, K_, b_, downCalls, downPuts);
+    } else {
+        sweep(mesh, property, T_, sig_, r_, S_ + h, K_, b_, upCalls, upPuts);
+        sweep(mesh, property, T_, sig_, r_, S_ - h, K_, b_, downCalls, downPuts);
+    }
+
+    for (std::size_t i = 0; i < calls.size(); ++i) {
+        callDeltas[i] = (upCalls[i] - downCalls[i]) / (2 * h);
+        putDeltas[i] = (upPuts[i] - downPuts[i]) / (2 * h);
+        gammas[i] = (upCalls[i] - 2 * calls[i] + downCalls[i]) / (h * h);
+    }
+}
+
+/**
+ * Prices and divided difference Deltas and Gammas of a sweep of one property, in the row layout of the matrix functions
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param h Difference parameter
+ * @param mesh Values of the swept property
+ * @param property The swept property (e.g. T, sig, r, S, K, b)
+ * @param T_ Expiry
+ * @param sig_ Volatility
+ * @param r_ Risk-free rate
+ * @param S_ Spot price
+ * @param K_ Strike price
+ * @param b_ Cost of carry
+ * @param prices Receives a Call and Put price per mesh point
+ * @param deltas Receives a Call and Put Delta per mesh point
+ * @param gammas Receives a Gamma per mesh point
+ * @throws std::invalid_argument If the property is not one of T, sig, r, S, K, or b
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::sweep(double h, const std::vector<double> &mesh,
+        const std::string &property, double T_, double sig_, double r_, double S_, double K_, double b_,
+        std::vector<std::vector<double>> &prices, std::vector<std::vector<double>> &deltas,
+        std::vector<double> &gammas) {
+
+    std::vector<double> calls, puts, callDeltas, putDeltas;
+    sweep(h, mesh, property, T_, sig_, r_, S_, K_, b_, calls, puts, callDeltas, putDeltas, gammas);
+
+    prices.clear();
+    deltas.clear();
+    for (std::size_t i = 0; i < calls.size(); ++i) {
+        prices.push_back({calls[i], puts[i]});
+        deltas.push_back({callDeltas[i], putDeltas[i]});
+    }
+}
+
+/*
+ * Whether the neighbors of every mesh point are its spot bumped by h
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @tparam Allocator Allocator of the mesh
+ * @param mesh Values of the swept spot
+ * @param h Difference parameter
+ * @return True if the mesh is not empty and every spacing is h to within the rounding of an accumulated mesh
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+template<typename Allocator>
+bool EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::neighbors(const std::vector<double, Allocator> &mesh, double h) {
+    if (mesh.empty() || !(h > 0.0)) { return false; }
+
+    for (std::size_t i = 1; i < mesh.size(); ++i) {
+        if (std::fabs(mesh[i] - mesh[i - 1] - h) > 1e-9 * h) { return false; }
+    }
+    return true;
+}
+
+/*
+ * Call and Put prices of one row of a sweep
+ * @note Only the out of the money leg is priced from the normal CDFs. The other leg follows from Put-Call parity, which
+ * adds the forward intrinsic value to a price at least as large as itself, so neither leg loses relative precision
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param d1 d1 of the row
+ * @param vst sig sqrt(T) of the row
+ * @param carry S e^((b-r)T) of the row
+ * @param discount K e^(-rT) of the row
+ * @param call Receives the Call price
+ * @param put Receives the Put price
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::legs(double d1, double vst, double carry, double discount,
+        double &call, double &put) {
+    double d2 = d1 - vst;
+
+    if (carry < discount) {
+        call = (carry * normalCDF(d1)) - (discount * normalCDF(d2));
+        put = call - carry + discount;
+    } else {
+        put = (discount * normalCDF(-d2)) - (carry * normalCDF(-d1));
+        call = put + carry - discount;
+    }
+}
+
+/*
+ * Cumulative normal distribution for the double instantiation of the generic pricing kernel
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param x Argument
+ * @return N(x) from the RNG policy
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+double EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::normalCDF(double x) { return RNG_::CDF(x); }
+
+/*
+ * Cumulative normal distribution for the float instantiation of the generic kernels
+ * @note Evaluated with the single precision complementary error function so that the float path never widens
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param x Argument
+ * @return N(x) in single precision
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+float EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::normalCDF(float x) {
+    return 0.5f * std::erfc(-x * 0.70710678f);
+}
+
+/*
+ * Cumulative normal distribution for other instantiations of the generic pricing kernel
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @tparam Real Numeric type that provides CDF
+ * @param x Argument
+ * @return N(x) from the numeric type
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+template<typename Real>
+Real EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::normalCDF(const Real &x) { return CDF(x); }
+
+/*
+ * Normal density for the double instantiation of the generic Greek kernels
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param x Argument
+ * @return n(x) from the RNG policy
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+double EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::normalPDF(double x) { return RNG_::PDF(x); }
+
+/*
+ * Normal density for the float instantiation of the generic Greek kernels
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param x Argument
+ * @return n(x) in single precision
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+float EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::normalPDF(float x) {
+    return 0.39894228f * std::exp(-0.5f * x * x);
+}
+
+/*
+ * Normal density for other instantiations of the generic Greek kernels
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @tparam Real Numeric type that provides PDF
+ * @param x Argument
+ * @return n(x) from the numeric type
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+template<typename Real>
+Real EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::normalPDF(const Real &x) { return PDF(x); }
+
+/**
+ * Price every row in a batch of options without allocating per row
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @tparam Real Numeric type of the batch columns (double or float)
+ * @tparam Allocator Allocator of the result vectors, e.g. std::pmr::polymorphic_allocator over an Arena
+ * @param batch Contiguous columns of option parameters (T, sig, r, S, K, b)
+ * @param calls Receives one Call price per row. Resized to the size of the batch
+ * @param puts Receives one Put price per row. Resized to the size of the batch
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+template<typename Real, typename Allocator>
+void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::price(const BasicOptionBatch<Real> &batch,
+        std::vector<Real, Allocator> &calls, std::vector<Real, Allocator> &puts) {
+
+    std::size_t n = batch.size();
+    calls.resize(n);
+    puts.resize(n);
+
+    const Real *T_ = batch.expiry().data(), *sig_ = batch.vol().data(), *r_ = batch.riskFree().data();
+    const Real *S_ = batch.spot().data(), *K_ = batch.strike().data(), *b_ = batch.carry().data();
+
+    for (std::size_t i = 0; i < n; ++i) {
+        price(T_[i], sig_[i], r_[i], S_[i], K_[i], b_[i], calls[i], puts[i]);
+    }
+}
+
+/**
+ * Price every row in a batch of options with float cumulative normals refined in double
+ * @note The cumulative normals are evaluated in float at float d1 and d2, which is where the path saves its time. d1
+ * and d2 are recomputed in double and each N(d) is refined to first order, N(df) + n(d)(d - df), which removes the
+ * float rounding of d. The discount factors and the final differences are formed in double, which removes the
+ * cancellation that costs the pure float path most of its accuracy on deep in the money options. The float rounding
+ * of N itself remains, scaled by the discounted spot and strike; see precision
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param batch Contiguous columns of option parameters (T, sig, r, S, K, b)
+ * @param calls Receives one Call price per row. Resized to the size of the batch
+ * @param puts Receives one Put price per row. Resized to the size of the batch
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::priceFloatCore(const OptionBatch &batch,
+        std::vector<double> &calls, std::vector<double> &puts) {
+
+    std::size_t n = batch.size();
+    calls.resize(n);
+    puts.resize(n);
+
+    const double *T_ = batch.expiry().data(), *sig_ = batch.vol().data(), *r_ = batch.riskFree().data();
+    const double *S_ = batch.spot().data(), *K_ = batch.strike().data(), *b_ = batch.carry().data();
+
+    for (std::size_t i = 0; i < n; ++i) {
+        float T = static_cast<float>(T_[i]), sig = static_cast<float>(sig_[i]), b = static_cast<float>(b_[i]);
+        float moneyness = static_cast<float>(S_[i] / K_[i]);
+
+        float tmp = sig * std::sqrt(T);
+        float d1f = (std::log(moneyness) + (b + (sig * sig) * 0.5f) * T) / tmp;
+        float d2f = d1f - tmp;
+
+        double vst = sig_[i] * std::sqrt(T_[i]);
+        double d1 = (std::log(S_[i] / K_[i]) + (b_[i] + (sig_[i] * sig_[i]) * 0.5) * T_[i]) / vst;
+        double d2 = d1 - vst;
+
+        double carry = S_[i] * exp((b_[i] - r_[i]) * T_[i]);
+        double discount = K_[i] * exp(-r_[i] * T_[i]);
+
+        // First order refinement N(d) = N(df) + n(d)(d - df). Since S e^((b-r)T) n(d1) = K e^(-rT) n(d2), one density
+        // corrects both legs, and both Call and Put by the same amount
+        double correction = carry * normalPDF(d1) * ((d1 - d1f) - (d2 - d2f));
+
+        calls[i] = (carry * normalCDF(d1f)) - (discount * normalCDF(d2f)) + correction;
+        puts[i] = (discount * normalCDF(-d2f)) - (carry * normalCDF(-d1f)) + correction;
+    }
+}
+
+/**
+ * Measure the error of the float and float core batch paths against the double path
+ * @note Errors are reported in absolute terms and relative to the strike, since relative errors of far out of the
+ * money prices near zero say nothing about the usefulness of a path. On a grid of S in [50, 150], sig in [0.1, 0.6],
+ * and T in [0.1, 2] with K = 100, r = 0.05, and b = 0.03 the float path is within 3.2e-7 of the strike (3.1e-5 in
+ * price) and the float core path within 1.2e-7 (1.1e-5 in price)
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param batch Contiguous columns of option parameters (T, sig, r, S, K, b)
+ * @return Rows for the float and float core paths. Each row has the maximum absolute Call error, the maximum absolute
+ * Put error, and the maximum of either error divided by the strike
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+std::vector<std::vector<double>> EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::precision(const OptionBatch &batch) {
+
+    std::vector<double> calls, puts;
+    price(batch, calls, puts);
+
+    // Narrow the batch and price it in single precision
+    std::size_t n = batch.size();
+    FloatOptionBatch narrow;
+    narrow.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        narrow.push_back(static_cast<float>(batch.expiry()[i]), static_cast<float>(batch.vol()[i]),
+                         static_cast<float>(batch.riskFree()[i]), static_cast<float>(batch.spot()[i]),
+                         static_cast<float>(batch.strike()[i]), static_cast<float>(batch.carry()[i]));
+    }
+    std::vector<float> floatCalls, floatPuts;
+    price(narrow, floatCalls, floatPuts);
+
+    std::vector<double> coreCalls, corePuts;
+    priceFloatCore(batch, coreCalls, corePuts);
+
+    std::vector<std::vector<double>> errors(2, std::vector<double>(3, 0.0));
+    for (std::size_t i = 0; i < n; ++i) {
+        double strike = batch.strike()[i];
+        double paths[2][2] = {{floatCalls[i], floatPuts[i]}, {coreCalls[i], corePuts[i]}};
+        for (std::size_t j = 0; j < 2; ++j) {
+            double callError = std::abs(paths[j][0] - calls[i]);
+            double putError = std::abs(paths[j][1] - puts[i]);
+            errors[j][0] = std::max(errors[j][0], callError);
+            errors[j][1] = std::max(errors[j][1], putError);
+            errors[j][2] = std::max(errors[j][2], std::max(callError, putError) / strike);
+        }
+    }
+    return errors;
+}
+
+/**
+ * Prices and the sensitivities to every input of every row in a batch of options by adjoint differentiation
+ * @note Rows are recorded in blocks on a thread local tape whose arena is reset, not reallocated, between blocks. The
+ * rows of a block share no tape nodes, so seeding every Call in the block and sweeping once yields all of their
+ * sensitivities, and a second sweep does the same for the Puts. Callers that price on several threads get one tape
+ * per thread
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param batch Contiguous columns of option parameters (T, sig, r, S, K, b)
+ * @param calls Receives one Call price per row. Resized to the size of the batch
+ * @param puts Receives one Put price per row. Resized to the size of the batch
+ * @param callSensitivities Receives dC/dT, dC/dsig, dC/dr, dC/dS, dC/dK, and dC/db in the columns that hold T, sig, r,
+ * S, K, and b. Resized to the size of the batch
+ * @param putSensitivities Receives the Put sensitivities in the same layout
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::sensitivities(const OptionBatch &batch,
+        std::vector<double> &calls, std::vector<double> &puts, OptionBatch &callSensitivities,
+        OptionBatch &putSensitivities) {
+
+    const std::size_t block = 128;
+    thread_local Tape tape;
+    thread_local std::vector<Adjoint> inputs(6 * block), outputs(2 * block);
+
+    std::size_t n = batch.size();
+    calls.resize(n);
+    puts.resize(n);
+    callSensitivities.resize(n);
+    putSensitivities.resize(n);
+
+    const std::vector<double> *columns[6] = {&batch.expiry(), &batch.vol(), &batch.riskFree(), &batch.spot(),
+                                             &batch.strike(), &batch.carry()};
+    std::vector<double> *callColumns[6] = {&callSensitivities.expiry(), &callSensitivities.vol(),
+                                           &callSensitivities.riskFree(), &callSensitivities.spot(),
+                                           &callSensitivities.strike(), &callSensitivities.carry()};
+    std::vector<double> *putColumns[6] = {&putSensitivities.expiry(), &putSensitivities.vol(),
+                                          &putSensitivities.riskFree(), &putSensitivities.spot(),
+                                          &putSensitivities.strike(), &putSensitivities.carry()};
+
+    Tape *previous = Tape::active();
+    tape.activate();
+
+    for (std::size_t first = 0; first < n; first += block) {
+        std::size_t last = std::min(n, first + block);
+        tape.reset();
+
+        // Forward sweep records every row of the block
+        for (std::size_t i = first; i < last; ++i) {
+            Adjoint *x = &inputs[6 * (i - first)];
+            for (std::size_t k = 0; k < 6; ++k) {
+                x[k] = Adjoint::variable((*columns[k])[i]);
+            }
+            Adjoint &call = outputs[2 * (i - first)], &put = outputs[2 * (i - first) + 1];
+            price(x[0], x[1], x[2], x[3], x[4], x[5], call, put);
+            calls[i] = call.value();
+            puts[i] = put.value();
+        }
+
+        // One reverse sweep per leg
+        for (std::size_t leg = 0; leg < 2; ++leg) {
+            std::vector<double> **target = leg == 0 ? callColumns : putColumns;
+
+            tape.clearAdjoints();
+            for (std::size_t i = first; i < last; ++i) {
+                outputs[2 * (i - first) + leg].adjoint() = 1.0;
+            }
+            tape.propagate();
+
+            for (std::size_t i = first; i < last; ++i) {
+                const Adjoint *x = &inputs[6 * (i - first)];
+                for (std::size_t k = 0; k < 6; ++k) {
+                    (*target[k])[i] = x[k].adjoint();
+                }
+            }
+        }
+    }
+
+    if (previous) { previous->activate(); } else { Tape::deactivate(); }
+}
+
+/* ********************************************************************************************************************
+ * Put Call Parity
+ *********************************************************************************************************************/
+
+/**
+ * A mechanism to calculate the call (or put) price for a corresponding put (or call) price
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param optionPrice
+ * @param optType_ Call or Put. The default value is a Call
+ * @return The price that satisfies the put-call parity relationship
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+double EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::putCallParity(double optionPrice, const std::string& optType_) const {
+    double discount = cache.discount;
+    if (optType_ == "Put" || optType_ == "put") {
+        return optionPrice + S - discount;
+    } else {
+        return optionPrice + discount - S;
+    }
+}
+
+/**
+ * Mechanism to check if a given set of call (C) and put (P) prices satisfy parity
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param putPrice
+ * @param callPrice
+ * @return True if the relationship is satisfied. Otherwise false
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+bool EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::putCallParity(double callPrice, double putPrice) const {
+    return putCallParity(callPrice, putPrice, T, K, r, S);
+}
+
+/*
+ * Helper function to check if a given set of call (C) and put (P) prices satisfy parity (tolerance = 1e-5)
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param C Call price
+ * @param P Put price
+ * @param T_ Expiry
+ * @param K_ Strike price
+ * @param r_ Risk-Free Rate
+ * @param S_ Spot price
+ * @return True if Put-Call Parity is satisfied. False otherwise
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+bool EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::putCallParity(double C, double P, double T_, double K_, double r_,
+        double S_) {
+    return ((C + (K_ * exp(-r_ * T_))) - (P + S_)) <= 1e-5;
+}
+
+/* ********************************************************************************************************************
+ * Accessors
+ *********************************************************************************************************************/
+
+/**
+ * Accessor that retrieves this options Expiry
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @return Expiry of this Option
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+double EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::expiry() const {return T;}
+
+/**
+ * Accessor that retrieves this options Volatility
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @return Volatility of this option
  */
 template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
 double EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::vol() const { return sig; }
@@ -669,12 +1928,26 @@ double EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::strike() const { return
 template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
 double EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::carry() const { return b; }
 
+/**
+ * Accessor that retrieves this options parameters as a compact contract record
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @return T, sig, r, S, K, and b of this option
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+Contract EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::contract() const { return Contract{T, sig, r, S, K, b}; }
+
 /* ********************************************************************************************************************
  * Mutators
  *********************************************************************************************************************/
 
 /**
  * Mutator that sets this options parameters to the values specified in the argument list
+ * @note Only the cached terms that depend on a parameter whose value changed are recomputed, once for all of them
  * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
  * is separated by the step
  * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
@@ -691,12 +1964,13 @@ double EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::carry() const { return b
 template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
 void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::setOptionData(double T_, double sig_, double r_, double S_,
         double K_, double b_) {
-    T = T_;
-    sig = sig_;
-    r = r_;
-    S = S_;
-    K = K_;
-    b = b_;
+    assign(T, T_, 0);
+    assign(sig, sig_, Discounting);
+    assign(r, r_, Diffusion);
+    assign(S, S_, Diffusion | Discounting);
+    assign(K, K_, Diffusion);
+    assign(b, b_, 0);
+    refresh();
 }
 
 /**
@@ -710,7 +1984,10 @@ void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::setOptionData(double T_, d
  * @param T_ Expiry
  */
 template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
-void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::expiry(double T_) {T = T_;}
+void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::expiry(double T_) {
+    assign(T, T_, 0);
+    refresh();
+}
 
 /**
  * Mutator that sets this options Volatility to the value specified in the argument list
@@ -723,7 +2000,10 @@ void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::expiry(double T_) {T = T_;
  * @param sig_ Volatility
  */
 template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
-void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::vol(double sig_) {sig = sig_;}
+void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::vol(double sig_) {
+    assign(sig, sig_, Discounting);
+    refresh();
+}
 
 /**
  * Mutator that sets this options Risk-Free Rate to the value specified in the argument list
@@ -736,7 +2016,10 @@ void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::vol(double sig_) {sig = si
  * @param r_ Risk-free rate
  */
 template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
-void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::riskFree(double r_) {r = r_;}
+void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::riskFree(double r_) {
+    assign(r, r_, Diffusion);
+    refresh();
+}
 
 /**
  * Mutator that sets this options Spot price to the value specified in the argument list
@@ -749,7 +2032,10 @@ void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::riskFree(double r_) {r = r
  * @param S_ Spot price
  */
 template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
-void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::spot(double S_) {S = S_;}
+void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::spot(double S_) {
+    assign(S, S_, Diffusion | Discounting);      // sig sqrt(T) and the discount factors do not depend on the spot
+    refresh();
+}
 
 /**
  * Mutator that sets this options Strike price to the value specified in the argument list
@@ -762,7 +2048,10 @@ void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::spot(double S_) {S = S_;}
  * @param K_ Strike price
  */
 template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
-void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::strike(double K_) {K = K_;}
+void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::strike(double K_) {
+    assign(K, K_, Diffusion);
+    refresh();
+}
 
 /**
  * Mutator that sets this options Cost of Carry to the value specified in the argument list
@@ -775,6 +2064,25 @@ void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::strike(double K_) {K = K_;
  * @param b_ Cost of Carry
  */
 template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
-void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::carry(double b_) {b = b_;}
+void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::carry(double b_) {
+    assign(b, b_, 0);
+    refresh();
+}
+
+/**
+ * Mutator that sets this options parameters to those of a compact contract record
+ * @note Only the cached terms that depend on a parameter whose value changed are invalidated
+ * @tparam Mesher_ Monotonically increases the specified option property. The interval is [start, stop] and each point
+ * is separated by the step
+ * @tparam Matrix_ Creates a matrix of option parameters where each new row has a property that has been monotonically
+ * increased by the Mesher
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Output_ Output class that sends option data to a file specified by the user
+ * @param contract_ The parameters of the option
+ */
+template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
+void EuropeanOption<Mesher_, Matrix_, RNG_, Output_>::contract(const Contract &contract_) {
+    setOptionData(contract_.T, contract_.sig, contract_.r, contract_.S, contract_.K, contract_.b);
+}
 
 #endif
\ No newline at end of file
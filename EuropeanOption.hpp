@@ -1,6 +1,11 @@
 /**********************************************************************************************************************
  * Black-Scholes pricing application for European (plain) Options
  *
+ * @note Each option caches d1, n(d1), the discount factors, sig sqrt(T), and the prices and Greeks, so price, delta,
+ * gamma, and vega evaluate the closed form solution once between changes. The constructors and mutators bring the
+ * cache up to date and a spot change keeps sig sqrt(T) and the discount factors. Const member functions only read the
+ * cache, so one object can be priced from several threads at once as long as none of them mutates it
+ *
  * Created by Michael Lewis on 7/31/20.
  *********************************************************************************************************************/
 
@@ -9,8 +14,12 @@
 
 #include <vector>
 
+#include "Adjoint.hpp"
+#include "Contract.hpp"
+#include "HyperDual.hpp"
 #include "Mesher.hpp"
 #include "Matrix.hpp"
+#include "OptionBatch.hpp"
 #include "Output.hpp"
 
 template<typename Mesher_, typename Matrix_, typename RNG_, typename Output_>
@@ -25,17 +34,54 @@ private:
     double K;                                    // Strike price
     double b;                                    // Cost of carry; b = r for Black-Scholes equity option model
 
+    // Groups of cached intermediates. A mutator clears only the groups that depend on the parameter it sets
+    enum Terms : unsigned char { Diffusion = 1, Discounting = 2, Moneyness = 4 };
+
+    // Intermediates and results of the closed form solution, recomputed by the constructors and mutators
+    struct Cache {
+        unsigned char valid;                     // Terms that are up to date
+        double sqrtT, vst, drift;                // Diffusion: sqrt(T), sig sqrt(T), (b + sig^2 / 2) T
+        double growth, discount;                 // Discounting: e^((b-r)T), K e^(-rT)
+        double d1, n1;                           // Moneyness: d1 and n(d1)
+        double call, put, callDelta, putDelta, gamma, vega;
+    };
+
+    Cache cache;
+
+    // Helper functions to set a parameter and invalidate the groups that depend on it, and to bring the invalidated
+    // groups of the cache up to date
+    void assign(double& parameter, double value, unsigned char keep);
+    void refresh();
+
     // Helper function to check if a given set of call (C) and put (P) prices satisfy parity
     static bool putCallParity(double C, double P, double T_, double K_, double r_, double S);
 
     // Helper function to price the option
     static std::vector<std::vector<double>> price(double T_, double sig_, double r_, double S_, double K_, double b_);
 
+    // Helper function that prices both legs of one row of a sweep from d1 and the terms of the row
+    static void legs(double d1, double vst, double carry, double discount, double& call, double& put);
+
+    // Helper function to check that the neighbors of every point of a spot mesh are its bumped spots
+    template<typename Allocator>
+    static bool neighbors(const std::vector<double, Allocator>& mesh, double h);
+
+    // Helper functions that give the generic kernels the normal distribution of their numeric type
+    static double normalCDF(double x);
+    static float normalCDF(float x);
+    template<typename Real>
+    static Real normalCDF(const Real& x);
+    static double normalPDF(double x);
+    static float normalPDF(float x);
+    template<typename Real>
+    static Real normalPDF(const Real& x);
+
 public:
     // Constructors and destructors
     EuropeanOption();
     EuropeanOption(const EuropeanOption& source);
     EuropeanOption(double T_, double sig_, double r_, double S_, double K_, double b_);
+    explicit EuropeanOption(const Contract& contract_);
     virtual ~EuropeanOption();
 
     // Operator overloading
@@ -46,6 +92,60 @@ public:
     static std::vector<std::vector<double>> price(const std::vector<std::vector<double> >& matrix);
     void price(double h, double start, double stop, double step, const std::string& property) const;
 
+    // Allocation free pricing kernel and batch pricing over contiguous columns of option data. Results may use any
+    // allocator, e.g. std::pmr::polymorphic_allocator over an Arena
+    static void price(double T_, double sig_, double r_, double S_, double K_, double b_, double& call, double& put);
+    template<typename Real, typename Allocator>
+    static void price(const BasicOptionBatch<Real>& batch, std::vector<Real, Allocator>& calls,
+                      std::vector<Real, Allocator>& puts);
+
+    // Prices and Deltas of a batch from the out of the money leg of each row, with the other leg and Delta from
+    // Put-Call parity, and the Put-Call parity residuals of any priced batch
+    template<typename Real, typename Allocator>
+    static void priceParity(const BasicOptionBatch<Real>& batch, std::vector<Real, Allocator>& calls,
+                            std::vector<Real, Allocator>& puts, std::vector<Real, Allocator>& callDeltas,
+                            std::vector<Real, Allocator>& putDeltas);
+    template<typename Real, typename Allocator>
+    static std::size_t parityViolations(const BasicOptionBatch<Real>& batch, const std::vector<Real, Allocator>& calls,
+                                        const std::vector<Real, Allocator>& puts,
+                                        std::vector<Real, Allocator>& residuals, Real tolerance = Real(1e-5));
+
+    // Prices along a mesh of one property from a kernel specialized on that property, with its invariants hoisted,
+    // and the same with divided difference Greeks that reuse neighboring prices on a spot mesh of spacing h. Results
+    // and temporary buffers use the allocator of the mesh
+    template<typename Allocator>
+    static void sweep(const std::vector<double, Allocator>& mesh, const std::string& property, double T_, double sig_,
+                      double r_, double S_, double K_, double b_, std::vector<double, Allocator>& calls,
+                      std::vector<double, Allocator>& puts);
+    template<typename Allocator>
+    static void sweep(double h, const std::vector<double, Allocator>& mesh, const std::string& property, double T_,
+                      double sig_, double r_, double S_, double K_, double b_, std::vector<double, Allocator>& calls,
+                      std::vector<double, Allocator>& puts, std::vector<double, Allocator>& callDeltas,
+                      std::vector<double, Allocator>& putDeltas, std::vector<double, Allocator>& gammas);
+    static void sweep(double h, const std::vector<double>& mesh, const std::string& property, double T_, double sig_,
+                      double r_, double S_, double K_, double b_, std::vector<std::vector<double>>& prices,
+                      std::vector<std::vector<double>>& deltas, std::vector<double>& gammas);
+
+    // Prices and Greeks of a book of compact contract records
+    static void price(const std::vector<Contract>& contracts, std::vector<double>& calls, std::vector<double>& puts);
+    static void delta(const std::vector<Contract>& contracts, std::vector<double>& callDeltas,
+                      std::vector<double>& putDeltas);
+    static void gamma(const std::vector<Contract>& contracts, std::vector<double>& gammas);
+    static void vega(const std::vector<Contract>& contracts, std::vector<double>& vegas);
+
+    // Pricing kernel generic in the numeric type (e.g. double, float, or Adjoint)
+    template<typename Real>
+    static void price(const Real& T_, const Real& sig_, const Real& r_, const Real& S_, const Real& K_, const Real& b_,
+                      Real& call, Real& put);
+
+    // Batch pricing with float cumulative normals refined in double, and the error of the reduced precision paths
+    static void priceFloatCore(const OptionBatch& batch, std::vector<double>& calls, std::vector<double>& puts);
+    static std::vector<std::vector<double>> precision(const OptionBatch& batch);
+
+    // Prices and every first order sensitivity of a batch from one reverse sweep per leg
+    static void sensitivities(const OptionBatch& batch, std::vector<double>& calls, std::vector<double>& puts,
+                              OptionBatch& callSensitivities, OptionBatch& putSensitivities);
+
     // Mechanism to calculate the call (or put) price for a corresponding put (or call) price
     double putCallParity(double optionPrice, const std::string& optType_) const;
     // Mechanism to check if a given set of call (C) and put (P) prices satisfy parity
@@ -58,6 +158,32 @@ public:
     double gamma() const;
     static double gamma(double T_, double sig_, double r_, double S_, double K_, double b_);
     static std::vector<double> gamma(const std::vector<std::vector<double>>& matrix);
+    double vega() const;
+    static double vega(double T_, double sig_, double r_, double S_, double K_, double b_);
+
+    // Allocation free Greeks and batch Greeks over contiguous columns of option data
+    static void delta(double T_, double sig_, double r_, double S_, double K_, double b_, double& callDelta,
+                      double& putDelta);
+    template<typename Real, typename Allocator>
+    static void delta(const BasicOptionBatch<Real>& batch, std::vector<Real, Allocator>& callDeltas,
+                      std::vector<Real, Allocator>& putDeltas);
+    template<typename Real, typename Allocator>
+    static void gamma(const BasicOptionBatch<Real>& batch, std::vector<Real, Allocator>& gammas);
+    template<typename Real, typename Allocator>
+    static void vega(const BasicOptionBatch<Real>& batch, std::vector<Real, Allocator>& vegas);
+
+    // Greek kernels generic in the numeric type (e.g. double or float)
+    template<typename Real>
+    static void delta(const Real& T_, const Real& sig_, const Real& r_, const Real& S_, const Real& K_, const Real& b_,
+                      Real& callDelta, Real& putDelta);
+    template<typename Real>
+    static Real gamma(const Real& T_, const Real& sig_, const Real& r_, const Real& S_, const Real& K_, const Real& b_);
+    template<typename Real>
+    static Real vega(const Real& T_, const Real& sig_, const Real& r_, const Real& S_, const Real& K_, const Real& b_);
+
+    // Exact first and second order sensitivities from one hyper-dual evaluation of the pricing kernel
+    static void derivatives(const std::vector<double>& option, std::size_t i, std::size_t j, std::vector<double>& call,
+                            std::vector<double>& put);
 
     // European Greeks using Finite difference methods
     std::vector<std::vector<double>> delta(double h) const;
@@ -74,9 +200,11 @@ public:
     double spot() const;
     double strike() const;
     double carry() const;
+    Contract contract() const;
 
     // Mutators
     void setOptionData(double T_, double sig_, double r_, double S_, double K_, double b_);
+    void contract(const Contract& contract_);
     void expiry(double T_);
     void vol(double sig_);
     void riskFree(double r_);
@@ -0,0 +1,105 @@
+/**********************************************************************************************************************
+ * Self-contained fast Fourier transforms for the Fourier pricing engines
+ *********************************************************************************************************************/
+
+#include <cmath>
+#include <utility>
+
+#include "FFT.hpp"
+
+/**
+ * Smallest power of two that is not less than n
+ * @param n Number of points
+ * @return A power of two
+ */
+std::size_t FFT::size(std::size_t n) {
+    std::size_t m = 1;
+    while (m < n) { m <<= 1; }
+    return m;
+}
+
+/**
+ * In place iterative radix-2 transform
+ * @note The inverse is not scaled by 1 / n
+ * @param data Points to transform. The size must be a power of two
+ * @param inverse True for the inverse transform
+ */
+void FFT::transform(std::vector<std::complex<double>> &data, bool inverse) {
+
+    std::size_t n = data.size();
+    if (n < 2) { return; }
+
+    // Bit reversal permutation
+    for (std::size_t i = 1, j = 0; i < n; ++i) {
+        std::size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) { j ^= bit; }
+        j ^= bit;
+        if (i < j) { std::swap(data[i], data[j]); }
+    }
+
+    // Butterflies. Twiddles of each stage are built by recurrence from one exact root of unity
+    double sign = inverse ? 1.0 : -1.0;
+    for (std::size_t length = 2; length <= n; length <<= 1) {
+        double angle = sign * 2.0 * M_PI / static_cast<double>(length);
+        std::complex<double> root(std::cos(angle), std::sin(angle));
+        std::size_t half = length >> 1;
+
+        for (std::size_t start = 0; start < n; start += length) {
+            std::complex<double> w(1.0, 0.0);
+            for (std::size_t k = 0; k < half; ++k) {
+                std::complex<double> even = data[start + k];
+                std::complex<double> odd = data[start + k + half] * w;
+                data[start + k] = even + odd;
+                data[start + k + half] = even - odd;
+                w *= root;
+            }
+        }
+    }
+}
+
+/**
+ * Fractional transform by Bluestein's chirp-z substitution
+ * @note Uses 2 j u = j^2 + u^2 - (u - j)^2 to write the sum as a chirp times the convolution of the chirped data with
+ * a conjugate chirp, and evaluates the convolution with three power of two transforms of at least 2n points
+ * @param data Points x_j
+ * @param gamma Frequency spacing. gamma = 1 / n is the ordinary transform
+ * @param result Receives y_u for u in [0, n). Resized to the size of the data
+ */
+void FFT::fractional(const std::vector<std::complex<double>> &data, double gamma,
+                     std::vector<std::complex<double>> &result) {
+
+    std::size_t n = data.size();
+    result.assign(n, std::complex<double>(0.0, 0.0));
+    if (n == 0) { return; }
+
+    std::size_t m = size(2 * n);
+
+    // chirp[j] = e^(-pi i gamma j^2)
+    std::vector<std::complex<double>> chirp(n);
+    for (std::size_t j = 0; j < n; ++j) {
+        double jj = static_cast<double>(j);
+        chirp[j] = std::polar(1.0, -M_PI * gamma * jj * jj);
+    }
+
+    std::vector<std::complex<double>> y(m, std::complex<double>(0.0, 0.0));
+    std::vector<std::complex<double>> z(m, std::complex<double>(0.0, 0.0));
+    for (std::size_t j = 0; j < n; ++j) {
+        y[j] = data[j] * chirp[j];
+        z[j] = std::conj(chirp[j]);
+    }
+    for (std::size_t j = 1; j < n; ++j) {
+        z[m - j] = std::conj(chirp[j]);
+    }
+
+    transform(y);
+    transform(z);
+    for (std::size_t j = 0; j < m; ++j) {
+        y[j] *= z[j];
+    }
+    transform(y, true);
+
+    double scale = 1.0 / static_cast<double>(m);
+    for (std::size_t u = 0; u < n; ++u) {
+        result[u] = y[u] * scale * chirp[u];
+    }
+}
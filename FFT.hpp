@@ -0,0 +1,30 @@
+/**********************************************************************************************************************
+ * Self-contained fast Fourier transforms for the Fourier pricing engines
+ *
+ * @note transform is an in place iterative radix-2 transform. fractional evaluates the transform at an arbitrary
+ * frequency spacing with Bluestein's chirp-z substitution, which turns it into a convolution of three power of two
+ * transforms. Neither needs a third party library
+ *********************************************************************************************************************/
+
+#ifndef FFT_HPP
+#define FFT_HPP
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+class FFT {
+private:
+public:
+    // Smallest power of two that is not less than n
+    static std::size_t size(std::size_t n);
+
+    // In place transform y_u = sum_j x_j e^(-2 pi i j u / n), or its unscaled inverse. n must be a power of two
+    static void transform(std::vector<std::complex<double>>& data, bool inverse = false);
+
+    // y_u = sum_j x_j e^(-2 pi i gamma j u) for u in [0, n) and any n and gamma
+    static void fractional(const std::vector<std::complex<double>>& data, double gamma,
+                           std::vector<std::complex<double>>& result);
+};
+
+#endif // FFT_HPP
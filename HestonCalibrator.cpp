@@ -0,0 +1,387 @@
+/**********************************************************************************************************************
+ * Levenberg-Marquardt calibration of the Heston model to a surface of option quotes
+ *********************************************************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "Cholesky.hpp"
+#include "COSPricer.hpp"
+#include "HestonCalibrator.hpp"
+#include "Mesher.hpp"
+#include "Matrix.hpp"
+#include "Output.hpp"
+#include "Parallel.hpp"
+
+namespace {
+    typedef COSPricer<HestonModel, Mesher, Matrix, Output> HestonCOS;
+}
+
+/**
+ * Initialize a new calibrator with no quotes and the default Heston model as its first guess
+ */
+HestonCalibrator::HestonCalibrator() : surface(), market(), weights(), types(), expiries(), model(), terms(128),
+L(12.0), steps(0), rmse(0.0) {}
+
+/**
+ * Initialize a new calibrator whose data members are a copy of the source
+ * @param source A calibrator whose data members will be copied
+ */
+HestonCalibrator::HestonCalibrator(const HestonCalibrator &source) : surface(source.surface), market(source.market),
+weights(source.weights), types(source.types), expiries(source.expiries), model(source.model), terms(source.terms),
+L(source.L), steps(source.steps), rmse(source.rmse) {}
+
+/**
+ * Initialize a new calibrator for a surface of quotes
+ * @param surface_ T, sig, r, S, K, b of every quote. The volatility column is unused
+ * @param prices Quoted price of every quote
+ * @param types_ Call or Put of every quote
+ * @param terms_ Number of cosine terms in the expansion of each expiry
+ * @param L_ Width of the truncation interval in standard deviations. It is wider than for pricing because the interval
+ * is fixed from the first guess for the whole calibration
+ * @throws std::invalid_argument If the prices or types differ in size from the surface
+ */
+HestonCalibrator::HestonCalibrator(const OptionBatch &surface_, const std::vector<double> &prices,
+                                   const std::vector<Portfolio::OptionType> &types_, std::size_t terms_, double L_) :
+HestonCalibrator() {
+    terms = terms_;
+    L = L_;
+    quotes(surface_, prices, types_);
+}
+
+/**
+ * Destroy this calibrator
+ */
+HestonCalibrator::~HestonCalibrator() {}
+
+/**
+ * Copy the source data members into this calibrator
+ * @param source A calibrator whose data members will be copied
+ * @return This calibrator
+ */
+HestonCalibrator& HestonCalibrator::operator=(const HestonCalibrator &source) {
+    // Avoid self assign
+    if (this == &source) { return *this; }
+
+    surface = source.surface;
+    market = source.market;
+    weights = source.weights;
+    types = source.types;
+    expiries = source.expiries;
+    model = source.model;
+    terms = source.terms;
+    L = source.L;
+    steps = source.steps;
+    rmse = source.rmse;
+
+    return *this;
+}
+
+/* ********************************************************************************************************************
+ * Quotes
+ *********************************************************************************************************************/
+
+/**
+ * Replace the surface of quotes
+ * @note Weights are reset to one. The fitted model is kept as the warm start
+ * @param surface_ T, sig, r, S, K, b of every quote. The volatility column is unused
+ * @param prices Quoted price of every quote
+ * @param types_ Call or Put of every quote
+ * @throws std::invalid_argument If the prices or types differ in size from the surface
+ */
+void HestonCalibrator::quotes(const OptionBatch &surface_, const std::vector<double> &prices,
+                              const std::vector<Portfolio::OptionType> &types_) {
+    if (prices.size() != surface_.size() || types_.size() != surface_.size()) {
+        throw std::invalid_argument("A surface needs one price and one option type per quote");
+    }
+    surface = surface_;
+    market = prices;
+    types = types_;
+    weights.assign(surface.size(), 1.0);
+    expiries.clear();
+}
+
+/**
+ * Replace the quoted prices of the current surface, e.g. on the next snapshot of the market
+ * @param prices Quoted price of every quote in the order of the surface
+ * @throws std::invalid_argument If the prices differ in size from the surface
+ */
+void HestonCalibrator::prices(const std::vector<double> &prices) {
+    if (prices.size() != surface.size()) { throw std::invalid_argument("Expected one price per quote"); }
+    market = prices;
+}
+
+/**
+ * Weight the residual of every quote, e.g. by the inverse of its Vega to fit implied volatilities
+ * @param weights_ One weight per quote
+ * @throws std::invalid_argument If the weights differ in size from the surface
+ */
+void HestonCalibrator::weight(const std::vector<double> &weights_) {
+    if (weights_.size() != surface.size()) { throw std::invalid_argument("Expected one weight per quote"); }
+    weights = weights_;
+}
+
+/* ********************************************************************************************************************
+ * Calibration
+ *********************************************************************************************************************/
+
+/**
+ * Calibrate from the previously fitted model
+ * @note Each iteration solves (J^T J + mu diag(J^T J)) dx = -J^T r for the step. mu shrinks after a step that lowers
+ * the error and grows after one that does not. Parameters are projected back onto v0, kappa, theta, xi > 0 and
+ * |rho| < 1 after every step
+ * @param maxIterations Maximum number of accepted steps
+ * @param tolerance Stop when a step lowers the sum of squared residuals by less than this fraction
+ * @return The root mean square weighted error of the fitted model
+ */
+double HestonCalibrator::calibrate(std::size_t maxIterations, double tolerance) {
+
+    steps = 0;
+    if (surface.size() == 0) { return rmse = 0.0; }
+
+    prepare();
+
+    std::vector<double> x = {model.initialVariance(), model.reversion(), model.longRunVariance(), model.volOfVol(),
+                             model.correlation()};
+    std::vector<double> residuals, jacobian, trialResiduals, trialJacobian, trial(dimension), step;
+    double cost = evaluate(x, residuals, jacobian);
+    double mu = 1e-3;
+
+    std::size_t n = residuals.size();
+    std::vector<double> A(dimension * dimension), g(dimension);
+
+    while (steps < maxIterations) {
+
+        // Normal equations
+        std::fill(A.begin(), A.end(), 0.0);
+        std::fill(g.begin(), g.end(), 0.0);
+        for (std::size_t q = 0; q < n; ++q) {
+            const double *row = jacobian.data() + q * dimension;
+            for (std::size_t i = 0; i < dimension; ++i) {
+                g[i] += row[i] * residuals[q];
+                for (std::size_t j = 0; j <= i; ++j) {
+                    A[i * dimension + j] += row[i] * row[j];
+                }
+            }
+        }
+        for (std::size_t i = 0; i < dimension; ++i) {
+            for (std::size_t j = 0; j < i; ++j) {
+                A[j * dimension + i] = A[i * dimension + j];
+            }
+        }
+
+        // Damped steps until one lowers the error
+        bool accepted = false;
+        double previous = cost;
+        while (!accepted && mu < 1e12) {
+            std::vector<double> damped = A;
+            for (std::size_t i = 0; i < dimension; ++i) {
+                damped[i * dimension + i] += mu * std::max(A[i * dimension + i], 1e-12);
+            }
+
+            std::vector<double> rhs(dimension);
+            for (std::size_t i = 0; i < dimension; ++i) { rhs[i] = -g[i]; }
+            if (!Cholesky::solve(damped, rhs, step)) { mu *= 4.0; continue; }
+
+            for (std::size_t i = 0; i < dimension; ++i) { trial[i] = x[i] + step[i]; }
+            project(trial);
+
+            double trialCost = evaluate(trial, trialResiduals, trialJacobian);
+            if (trialCost < cost) {
+                x.swap(trial);
+                residuals.swap(trialResiduals);
+                jacobian.swap(trialJacobian);
+                cost = trialCost;
+                mu = std::max(mu / 3.0, 1e-12);
+                accepted = true;
+            } else {
+                mu *= 4.0;
+            }
+        }
+
+        if (!accepted) { break; }
+        ++steps;
+        if (previous - cost <= tolerance * previous) { break; }
+    }
+
+    model = HestonModel(x[0], x[1], x[2], x[3], x[4]);
+    return rmse = std::sqrt(2.0 * cost / static_cast<double>(n));
+}
+
+/**
+ * Calibrate from a given first guess
+ * @param guess Starting point of the calibration
+ * @param maxIterations Maximum number of accepted steps
+ * @param tolerance Stop when a step lowers the sum of squared residuals by less than this fraction
+ * @return The root mean square weighted error of the fitted model
+ */
+double HestonCalibrator::calibrate(const HestonModel &guess, std::size_t maxIterations, double tolerance) {
+    model = guess;
+    return calibrate(maxIterations, tolerance);
+}
+
+/**
+ * Model prices of the quotes
+ * @note Uses the number of cosine terms and the truncation width of the calibration, so the prices of the fitted model
+ * match the prices it was fitted with
+ * @param model_ Heston model
+ * @param prices Receives one price per quote in the order of the surface
+ */
+void HestonCalibrator::price(const HestonModel &model_, std::vector<double> &prices) const {
+
+    prices.resize(surface.size());
+    std::vector<double> strikes, calls, puts;
+    HestonCOS pricer(model_, 1.0, 0.0, 100.0, 100.0, 0.0, terms, L);
+
+    for (std::size_t q = 0; q < surface.size(); ++q) {
+        strikes.assign(1, surface.strike()[q]);
+        pricer.price(surface.expiry()[q], surface.riskFree()[q], surface.spot()[q], surface.carry()[q], strikes,
+                     calls, puts);
+        prices[q] = types[q] == Portfolio::OptionType::Call ? calls[0] : puts[0];
+    }
+}
+
+/* ********************************************************************************************************************
+ * Helper functions
+ *********************************************************************************************************************/
+
+/*
+ * Group the quotes by expiry and cache the parameter free parts of each expansion
+ * @note The truncation interval is set from the warm start, which is why the calibrator uses a wider L than pricing
+ */
+void HestonCalibrator::prepare() {
+
+    expiries.clear();
+    for (std::size_t q = 0; q < surface.size(); ++q) {
+        double T = surface.expiry()[q], r = surface.riskFree()[q], S = surface.spot()[q], b = surface.carry()[q];
+
+        auto same = [&](const Expiry &e) { return e.T == T && e.r == r && e.S == S && e.b == b; };
+        auto found = std::find_if(expiries.begin(), expiries.end(), same);
+        if (found == expiries.end()) {
+            expiries.push_back(Expiry{T, r, S, b, 0.0, 0.0, {}, {}, {}, {}});
+            found = expiries.end() - 1;
+        }
+        found->quotes.push_back(q);
+        found->strikes.push_back(surface.strike()[q]);
+    }
+
+    HestonCOS pricer(model, 1.0, 0.0, 100.0, 100.0, 0.0, terms, L);
+    Parallel::forRange(expiries.size(), [&](std::size_t, std::size_t first, std::size_t last) {
+        for (std::size_t e = first; e < last; ++e) {
+            Expiry &expiry = expiries[e];
+            pricer.truncation(expiry.T, expiry.r, expiry.b, expiry.lower, expiry.upper);
+            HestonCOS::payoffs(expiry.S, expiry.lower, expiry.upper, terms, expiry.strikes, expiry.V);
+
+            double width = expiry.upper - expiry.lower;
+            expiry.shift.resize(terms);
+            for (std::size_t k = 0; k < terms; ++k) {
+                expiry.shift[k] = std::polar(1.0, -static_cast<double>(k) * M_PI * expiry.lower / width);
+            }
+        }
+    }, 1);
+}
+
+/*
+ * Weighted residuals, their Jacobian, and half the sum of squared residuals for a set of parameters
+ * @param parameters v0, kappa, theta, xi, rho
+ * @param residuals Receives weight * (model price - quoted price) for every quote
+ * @param jacobian Receives the derivatives of every residual with respect to the parameters, one row per quote
+ * @return Half the sum of squared residuals
+ */
+double HestonCalibrator::evaluate(const std::vector<double> &parameters, std::vector<double> &residuals,
+                                  std::vector<double> &jacobian) const {
+
+    HestonModel trial(parameters[0], parameters[1], parameters[2], parameters[3], parameters[4]);
+    residuals.resize(surface.size());
+    jacobian.resize(surface.size() * dimension);
+
+    Parallel::forRange(expiries.size(), [&](std::size_t, std::size_t first, std::size_t last) {
+        std::vector<double> F(terms), puts;
+        std::vector<std::vector<double>> dF(dimension, std::vector<double>(terms)), dPuts(dimension);
+        std::complex<double> gradient[dimension];
+
+        for (std::size_t e = first; e < last; ++e) {
+            const Expiry &expiry = expiries[e];
+            double width = expiry.upper - expiry.lower;
+
+            // Density coefficients and their gradient. This is the only part that depends on the parameters
+            for (std::size_t k = 0; k < terms; ++k) {
+                double omega = static_cast<double>(k) * M_PI / width;
+                double scale = (k == 0 ? 1.0 : 2.0) / width;
+                std::complex<double> phi = trial.characteristic(std::complex<double>(omega, 0.0), expiry.T,
+                                                                expiry.r, expiry.b, gradient);
+                F[k] = scale * std::real(phi * expiry.shift[k]);
+                for (std::size_t p = 0; p < dimension; ++p) {
+                    dF[p][k] = scale * std::real(gradient[p] * expiry.shift[k]);
+                }
+            }
+
+            double discount = std::exp(-expiry.r * expiry.T);
+            double forward = expiry.S * std::exp((expiry.b - expiry.r) * expiry.T);
+            HestonCOS::expansion(F, expiry.V, discount, puts);
+            for (std::size_t p = 0; p < dimension; ++p) {
+                HestonCOS::expansion(dF[p], expiry.V, discount, dPuts[p]);
+            }
+
+            // Calls differ from Puts by a parameter free forward, so both share one gradient
+            for (std::size_t j = 0; j < expiry.quotes.size(); ++j) {
+                std::size_t q = expiry.quotes[j];
+                double value = puts[j];
+                if (types[q] == Portfolio::OptionType::Call) {
+                    value += forward - expiry.strikes[j] * discount;
+                }
+
+                residuals[q] = weights[q] * (value - market[q]);
+                for (std::size_t p = 0; p < dimension; ++p) {
+                    jacobian[q * dimension + p] = weights[q] * dPuts[p][j];
+                }
+            }
+        }
+    }, 1);
+
+    double cost = 0.0;
+    for (double residual : residuals) {
+        cost += residual * residual;
+    }
+    return 0.5 * cost;
+}
+
+/*
+ * Project parameters onto the admissible region
+ * @param parameters v0, kappa, theta, xi, rho
+ */
+void HestonCalibrator::project(std::vector<double> &parameters) {
+    for (std::size_t p = 0; p < 4; ++p) {
+        parameters[p] = std::max(parameters[p], 1e-4);
+    }
+    parameters[4] = std::min(std::max(parameters[4], -0.999), 0.999);
+}
+
+/* ********************************************************************************************************************
+ * Accessors
+ *********************************************************************************************************************/
+
+/**
+ * Fitted model
+ * @return The model of the last calibration, or the warm start if there has been none
+ */
+const HestonModel& HestonCalibrator::fitted() const { return model; }
+
+/**
+ * Iterations of the last calibration
+ * @return The number of accepted Levenberg-Marquardt steps
+ */
+std::size_t HestonCalibrator::iterations() const { return steps; }
+
+/**
+ * Error of the last calibration
+ * @return The root mean square weighted error
+ */
+double HestonCalibrator::error() const { return rmse; }
+
+/**
+ * Number of quotes
+ * @return The size of the surface
+ */
+std::size_t HestonCalibrator::size() const { return surface.size(); }
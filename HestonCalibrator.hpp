@@ -0,0 +1,85 @@
+/**********************************************************************************************************************
+ * Levenberg-Marquardt calibration of the Heston model to a surface of option quotes
+ *
+ * @note Residuals and their exact Jacobian come from the COS expansion. The strike side of the expansion (the payoff
+ * cosine integrals of every quote) and the cosine frequencies of each expiry are cached when the quotes are prepared,
+ * so an iteration only evaluates the characteristic function and its analytic gradient at the frequencies of each
+ * expiry and sums the cached expansion. Expiries are evaluated in parallel. The fitted model is kept, and the next call
+ * to calibrate starts from it, so a refit of a surface that moved a little converges in a few iterations
+ *********************************************************************************************************************/
+
+#ifndef HESTONCALIBRATOR_HPP
+#define HESTONCALIBRATOR_HPP
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+#include "CharacteristicFunction.hpp"
+#include "OptionBatch.hpp"
+#include "Portfolio.hpp"
+
+class HestonCalibrator {
+private:
+    // The quotes of one expiry and the parts of their COS expansion that do not depend on the model parameters
+    struct Expiry {
+        double T, r, S, b;                       // Option data shared by the quotes
+        double lower, upper;                     // Truncation interval of the log return
+        std::vector<std::size_t> quotes;         // Positions of the quotes in the surface
+        std::vector<double> strikes;             // Strike of each quote
+        std::vector<double> V;                   // Put payoff cosine integrals, one row per term
+        std::vector<std::complex<double>> shift; // e^(-i omega_k lower) of each term
+    };
+
+    OptionBatch surface;                         // T, sig, r, S, K, b of every quote. sig is unused
+    std::vector<double> market;                  // Quoted prices
+    std::vector<double> weights;                 // Residual weights
+    std::vector<Portfolio::OptionType> types;    // Call or Put
+    std::vector<Expiry> expiries;                // Quotes grouped by expiry with their cached expansion
+
+    HestonModel model;                           // Fitted model and warm start of the next calibration
+    std::size_t terms;                           // Number of cosine terms
+    double L;                                    // Width of the truncation interval in standard deviations
+    std::size_t steps;                           // Iterations of the last calibration
+    double rmse;                                 // Root mean square weighted error of the last calibration
+
+    // Helper functions
+    void prepare();
+    double evaluate(const std::vector<double>& parameters, std::vector<double>& residuals,
+                    std::vector<double>& jacobian) const;
+    static void project(std::vector<double>& parameters);
+
+public:
+    static constexpr std::size_t dimension = 5;  // v0, kappa, theta, xi, rho
+
+    // Constructors and destructors
+    HestonCalibrator();
+    HestonCalibrator(const HestonCalibrator& source);
+    HestonCalibrator(const OptionBatch& surface_, const std::vector<double>& prices,
+                     const std::vector<Portfolio::OptionType>& types_, std::size_t terms_ = 128, double L_ = 12.0);
+    virtual ~HestonCalibrator();
+
+    // Operator overloading
+    HestonCalibrator& operator=(const HestonCalibrator& source);
+
+    // Quotes
+    void quotes(const OptionBatch& surface_, const std::vector<double>& prices,
+                const std::vector<Portfolio::OptionType>& types_);
+    void prices(const std::vector<double>& prices);
+    void weight(const std::vector<double>& weights_);
+
+    // Calibration
+    double calibrate(std::size_t maxIterations = 100, double tolerance = 1e-10);
+    double calibrate(const HestonModel& guess, std::size_t maxIterations = 100, double tolerance = 1e-10);
+
+    // Model prices of the quotes
+    void price(const HestonModel& model_, std::vector<double>& prices) const;
+
+    // Accessors
+    const HestonModel& fitted() const;
+    std::size_t iterations() const;
+    double error() const;
+    std::size_t size() const;
+};
+
+#endif // HESTONCALIBRATOR_HPP
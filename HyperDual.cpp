@@ -0,0 +1,291 @@
+/**********************************************************************************************************************
+ * Hyper-dual numbers for exact first and second derivatives in a single forward evaluation
+ *********************************************************************************************************************/
+
+#include <cmath>
+
+#include <boost/math/distributions/normal.hpp>
+
+#include "HyperDual.hpp"
+
+/**
+ * Initialize a new HyperDual constant equal to zero
+ */
+HyperDual::HyperDual() : f(0.0), f1(0.0), f2(0.0), f12(0.0) {}
+
+/**
+ * Initialize a new HyperDual constant
+ * @param value_ Value
+ */
+HyperDual::HyperDual(double value_) : f(value_), f1(0.0), f2(0.0), f12(0.0) {}
+
+/**
+ * Initialize a new HyperDual from all of its parts. Use (x, 1, 0, 0) and (y, 0, 1, 0) to seed two inputs, or (x, 1, 1,
+ * 0) to seed the same input along both directions for a pure second derivative
+ * @param value_ Value
+ * @param first_ Derivative along e1
+ * @param second_ Derivative along e2
+ * @param cross_ Mixed second derivative
+ */
+HyperDual::HyperDual(double value_, double first_, double second_, double cross_) : f(value_), f1(first_),
+f2(second_), f12(cross_) {}
+
+/**
+ * Initialize a new HyperDual whose data members are a copy of the source
+ * @param source A HyperDual whose data members will be copied
+ */
+HyperDual::HyperDual(const HyperDual &source) : f(source.f), f1(source.f1), f2(source.f2), f12(source.f12) {}
+
+/**
+ * Destroy this HyperDual
+ */
+HyperDual::~HyperDual() {}
+
+/**
+ * Copy the source data members into this HyperDual
+ * @param source A HyperDual whose data members will be copied
+ * @return This HyperDual
+ */
+HyperDual& HyperDual::operator=(const HyperDual &source) {
+    // Avoid self assign
+    if (this == &source) { return *this; }
+
+    f = source.f;
+    f1 = source.f1;
+    f2 = source.f2;
+    f12 = source.f12;
+
+    return *this;
+}
+
+/**
+ * Add and assign
+ * @param rhs Right hand side
+ * @return This HyperDual
+ */
+HyperDual& HyperDual::operator+=(const HyperDual &rhs) { return *this = *this + rhs; }
+
+/**
+ * Subtract and assign
+ * @param rhs Right hand side
+ * @return This HyperDual
+ */
+HyperDual& HyperDual::operator-=(const HyperDual &rhs) { return *this = *this - rhs; }
+
+/**
+ * Multiply and assign
+ * @param rhs Right hand side
+ * @return This HyperDual
+ */
+HyperDual& HyperDual::operator*=(const HyperDual &rhs) { return *this = *this * rhs; }
+
+/**
+ * Divide and assign
+ * @param rhs Right hand side
+ * @return This HyperDual
+ */
+HyperDual& HyperDual::operator/=(const HyperDual &rhs) { return *this = *this / rhs; }
+
+/* ********************************************************************************************************************
+ * Accessors
+ *********************************************************************************************************************/
+
+/**
+ * Value of this number
+ * @return The real part
+ */
+double HyperDual::value() const { return f; }
+
+/**
+ * Derivative along the first seeded direction
+ * @return The e1 part
+ */
+double HyperDual::first() const { return f1; }
+
+/**
+ * Derivative along the second seeded direction
+ * @return The e2 part
+ */
+double HyperDual::second() const { return f2; }
+
+/**
+ * Mixed second derivative along both seeded directions
+ * @return The e1 e2 part
+ */
+double HyperDual::cross() const { return f12; }
+
+/*
+ * Apply a function with known derivatives to this number
+ * @param g Function value
+ * @param g1 First derivative of the function
+ * @param g2 Second derivative of the function
+ * @return g(this)
+ */
+HyperDual HyperDual::chain(double g, double g1, double g2) const {
+    return HyperDual(g, g1 * f1, g1 * f2, g1 * f12 + g2 * f1 * f2);
+}
+
+/* ********************************************************************************************************************
+ * Arithmetic
+ *********************************************************************************************************************/
+
+/**
+ * Sum of two numbers
+ * @param x Left operand
+ * @param y Right operand
+ * @return x + y
+ */
+HyperDual operator+(const HyperDual &x, const HyperDual &y) {
+    return HyperDual(x.f + y.f, x.f1 + y.f1, x.f2 + y.f2, x.f12 + y.f12);
+}
+
+/**
+ * Difference of two numbers
+ * @param x Left operand
+ * @param y Right operand
+ * @return x - y
+ */
+HyperDual operator-(const HyperDual &x, const HyperDual &y) {
+    return HyperDual(x.f - y.f, x.f1 - y.f1, x.f2 - y.f2, x.f12 - y.f12);
+}
+
+/**
+ * Product of two numbers
+ * @param x Left operand
+ * @param y Right operand
+ * @return x * y
+ */
+HyperDual operator*(const HyperDual &x, const HyperDual &y) {
+    return HyperDual(x.f * y.f, x.f * y.f1 + x.f1 * y.f, x.f * y.f2 + x.f2 * y.f,
+                     x.f * y.f12 + x.f1 * y.f2 + x.f2 * y.f1 + x.f12 * y.f);
+}
+
+/**
+ * Quotient of two numbers
+ * @param x Numerator
+ * @param y Denominator
+ * @return x / y
+ */
+HyperDual operator/(const HyperDual &x, const HyperDual &y) {
+    double inverse = 1.0 / y.f;
+    HyperDual q = x * y.chain(inverse, -inverse * inverse, 2.0 * inverse * inverse * inverse);
+
+    // Keep the value bit for bit equal to a double division
+    q.f = x.f / y.f;
+    return q;
+}
+
+/**
+ * Negation
+ * @param x Operand
+ * @return -x
+ */
+HyperDual operator-(const HyperDual &x) { return HyperDual(-x.f, -x.f1, -x.f2, -x.f12); }
+
+/* ********************************************************************************************************************
+ * Elementary functions
+ *********************************************************************************************************************/
+
+/**
+ * Exponential function
+ * @param x Operand
+ * @return e^x
+ */
+HyperDual exp(const HyperDual &x) {
+    double g = std::exp(x.f);
+    return x.chain(g, g, g);
+}
+
+/**
+ * Natural logarithm
+ * @param x Operand
+ * @return ln(x)
+ */
+HyperDual log(const HyperDual &x) {
+    double inverse = 1.0 / x.f;
+    return x.chain(std::log(x.f), inverse, -inverse * inverse);
+}
+
+/**
+ * Square root
+ * @param x Operand
+ * @return sqrt(x)
+ */
+HyperDual sqrt(const HyperDual &x) {
+    double g = std::sqrt(x.f);
+    return x.chain(g, 0.5 / g, -0.25 / (g * x.f));
+}
+
+/**
+ * Power function
+ * @param x Base. Must be positive when the exponent carries derivatives
+ * @param y Exponent
+ * @return x^y
+ */
+HyperDual pow(const HyperDual &x, const HyperDual &y) {
+    if (y.f1 == 0.0 && y.f2 == 0.0 && y.f12 == 0.0) {
+        double g = std::pow(x.f, y.f);
+        return x.chain(g, y.f * std::pow(x.f, y.f - 1.0), y.f * (y.f - 1.0) * std::pow(x.f, y.f - 2.0));
+    }
+    HyperDual g = exp(y * log(x));
+    g.f = std::pow(x.f, y.f);
+    return g;
+}
+
+/**
+ * Standard normal cumulative distribution function
+ * @param x Operand
+ * @return N(x)
+ */
+HyperDual CDF(const HyperDual &x) {
+    boost::math::normal norm;
+    double n = boost::math::pdf(norm, x.f);
+    return x.chain(boost::math::cdf(norm, x.f), n, -x.f * n);
+}
+
+/**
+ * Standard normal probability density function
+ * @param x Operand
+ * @return n(x)
+ */
+HyperDual PDF(const HyperDual &x) {
+    boost::math::normal norm;
+    double n = boost::math::pdf(norm, x.f);
+    return x.chain(n, -x.f * n, (x.f * x.f - 1.0) * n);
+}
+
+/* ********************************************************************************************************************
+ * Comparisons on values
+ *********************************************************************************************************************/
+
+/**
+ * Equality of values
+ * @param x Left operand
+ * @param y Right operand
+ * @return True if the values are equal
+ */
+bool operator==(const HyperDual &x, const HyperDual &y) { return x.f == y.f; }
+
+/**
+ * Inequality of values
+ * @param x Left operand
+ * @param y Right operand
+ * @return True if the values differ
+ */
+bool operator!=(const HyperDual &x, const HyperDual &y) { return x.f != y.f; }
+
+/**
+ * Ordering of values
+ * @param x Left operand
+ * @param y Right operand
+ * @return True if the value of x is less than the value of y
+ */
+bool operator<(const HyperDual &x, const HyperDual &y) { return x.f < y.f; }
+
+/**
+ * Ordering of values
+ * @param x Left operand
+ * @param y Right operand
+ * @return True if the value of x is greater than the value of y
+ */
+bool operator>(const HyperDual &x, const HyperDual &y) { return x.f > y.f; }
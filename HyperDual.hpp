@@ -0,0 +1,67 @@
+/**********************************************************************************************************************
+ * Hyper-dual numbers for exact first and second derivatives in a single forward evaluation
+ *
+ * @note A hyper-dual number is f + f1 e1 + f2 e2 + f12 e1 e2 where e1^2 = e2^2 = 0 and e1 e2 != 0. Seeding an input
+ * with e1 and a second input (or the same input) with e2 and evaluating a formula once gives the value, both first
+ * derivatives, and the mixed second derivative of the result, exactly and without a difference parameter. Seeding only
+ * e1 gives ordinary dual number (first derivative) behaviour
+ *********************************************************************************************************************/
+
+#ifndef HYPERDUAL_HPP
+#define HYPERDUAL_HPP
+
+// HyperDual is a value type with no virtual functions so that it stays four doubles wide
+class HyperDual {
+private:
+    double f;                                    // Value
+    double f1;                                   // Derivative along e1
+    double f2;                                   // Derivative along e2
+    double f12;                                  // Mixed second derivative along e1 and e2
+
+    // Result of a function g with first derivative g1 and second derivative g2 at the value of this number
+    HyperDual chain(double g, double g1, double g2) const;
+
+public:
+    // Constructors and destructors
+    HyperDual();
+    HyperDual(double value_);
+    HyperDual(double value_, double first_, double second_, double cross_);
+    HyperDual(const HyperDual& source);
+    ~HyperDual();
+
+    // Operator overloading
+    HyperDual& operator=(const HyperDual& source);
+    HyperDual& operator+=(const HyperDual& rhs);
+    HyperDual& operator-=(const HyperDual& rhs);
+    HyperDual& operator*=(const HyperDual& rhs);
+    HyperDual& operator/=(const HyperDual& rhs);
+
+    // Accessors
+    double value() const;
+    double first() const;
+    double second() const;
+    double cross() const;
+
+    // Arithmetic
+    friend HyperDual operator+(const HyperDual& x, const HyperDual& y);
+    friend HyperDual operator-(const HyperDual& x, const HyperDual& y);
+    friend HyperDual operator*(const HyperDual& x, const HyperDual& y);
+    friend HyperDual operator/(const HyperDual& x, const HyperDual& y);
+    friend HyperDual operator-(const HyperDual& x);
+
+    // Elementary functions
+    friend HyperDual exp(const HyperDual& x);
+    friend HyperDual log(const HyperDual& x);
+    friend HyperDual sqrt(const HyperDual& x);
+    friend HyperDual pow(const HyperDual& x, const HyperDual& y);
+    friend HyperDual CDF(const HyperDual& x);
+    friend HyperDual PDF(const HyperDual& x);
+
+    // Comparisons on values
+    friend bool operator==(const HyperDual& x, const HyperDual& y);
+    friend bool operator!=(const HyperDual& x, const HyperDual& y);
+    friend bool operator<(const HyperDual& x, const HyperDual& y);
+    friend bool operator>(const HyperDual& x, const HyperDual& y);
+};
+
+#endif // HYPERDUAL_HPP
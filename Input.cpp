@@ -0,0 +1,324 @@
+/**********************************************************************************************************************
+ * Black-Scholes Option pricing application - Input class
+ *********************************************************************************************************************/
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Input.hpp"
+#include "Parallel.hpp"
+
+namespace {
+
+    /*
+     * Read only memory mapping of a file that is unmapped when it goes out of scope
+     */
+    class MappedFile {
+    private:
+        const char *data_;
+        std::size_t size_;
+        bool empty_;
+
+    public:
+        explicit MappedFile(const std::string &path) : data_(nullptr), size_(0), empty_(false) {
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) { return; }
+
+            struct stat st{};
+            bool stated = ::fstat(fd, &st) == 0;
+            empty_ = stated && st.st_size == 0;
+            if (stated && st.st_size > 0) {
+                void *p = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+                if (p != MAP_FAILED) {
+                    data_ = static_cast<const char *>(p);
+                    size_ = static_cast<std::size_t>(st.st_size);
+                    ::madvise(p, size_, MADV_SEQUENTIAL);
+                }
+            }
+            ::close(fd);
+        }
+
+        ~MappedFile() {
+            if (data_) { ::munmap(const_cast<char *>(data_), size_); }
+        }
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        const char *data() const { return data_; }
+        std::size_t size() const { return size_; }
+        bool empty() const { return empty_; }
+    };
+
+    /*
+     * True if the file was mapped and holds data. Otherwise false and a message is written to the console
+     */
+    bool readable(const MappedFile &file) {
+        if (file.empty()) {
+            std::cout << "The file is empty\n";
+            return false;
+        }
+        if (!file.data()) {
+            std::cout << "Unable to open the file. Check filepath permissions\n";
+            return false;
+        }
+        return true;
+    }
+
+    /*
+     * Pointer to the character after the next newline, or end if there is none
+     */
+    const char *nextLine(const char *p, const char *end) {
+        const char *nl = static_cast<const char *>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+        return nl ? nl + 1 : end;
+    }
+
+    /*
+     * True if the line starting at p holds no data (empty, whitespace, or a carriage return)
+     */
+    bool blank(const char *p, const char *end) {
+        for (; p < end && *p != '\n'; ++p) {
+            if (*p != ' ' && *p != '\t' && *p != '\r') { return false; }
+        }
+        return true;
+    }
+}
+
+/**
+ * Initialize a new Input object
+ * @throws OutOfMemoryError Indicates insufficient memory for this new Input
+ */
+Input::Input() {}
+
+/**
+ * Initialize a new Input object
+ * @param source An Input object whose members will be used to initialize this new Input
+ * @throws OutOfMemoryError Indicates insufficient memory for this new Input
+ */
+Input::Input(const Input &) {}
+
+/**
+ * Destroy this Input
+ */
+Input::~Input() {}
+
+/**
+ * Deeply copy the source
+ * @param source An Input object whose members will be deeply copied into this Input object
+ * @return This Input object whose members are now a deep copy of the source members
+ */
+Input & Input::operator=(const Input &source) {
+    // Avoid self assign
+    if (this == &source) {return *this;}
+
+    return *this;
+}
+
+/**
+ * Load option data from a CSV file where each row has T, sig, r, S, K, b
+ * @note The file is memory mapped and split into one chunk per worker at line boundaries. Rows are counted in a first
+ * pass so the batch is sized once, then every chunk is parsed with std::from_chars directly into its slice of the
+ * batch. An optional header line and blank lines are skipped. A row with fewer or more than six fields, including a
+ * trailing comma, is malformed
+ * @param path Path to the CSV file
+ * @param batch Receives the option data. Any existing rows are replaced
+ * @return True if every row was parsed. Otherwise false and a message is written to the console, which tells an empty
+ * file apart from one that cannot be opened
+ */
+bool Input::csv(const std::string &path, OptionBatch &batch) {
+
+    MappedFile file(path);
+    if (!readable(file)) { return false; }
+
+    const char *begin = file.data();
+    const char *end = begin + file.size();
+
+    // Skip a header line if the first character cannot start a number
+    char c = *begin;
+    if (!((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.')) {
+        begin = nextLine(begin, end);
+    }
+
+    // Split the file into chunks that start at the beginning of a line
+    std::size_t workers = Parallel::threads();
+    std::vector<const char *> bounds(workers + 1, end);
+    bounds[0] = begin;
+    for (std::size_t w = 1; w < workers; ++w) {
+        const char *p = begin + (end - begin) * w / workers;
+        p = std::max(p, bounds[w - 1]);
+        bounds[w] = p == begin ? begin : nextLine(p - 1, end);
+    }
+
+    // First pass counts the rows in each chunk
+    std::vector<std::size_t> counts(workers, 0);
+    Parallel::forRange(workers, [&](std::size_t, std::size_t first, std::size_t last) {
+        for (std::size_t w = first; w < last; ++w) {
+            for (const char *p = bounds[w]; p < bounds[w + 1]; p = nextLine(p, bounds[w + 1])) {
+                if (!blank(p, bounds[w + 1])) { ++counts[w]; }
+            }
+        }
+    }, 1);
+
+    std::vector<std::size_t> offsets(workers + 1, 0);
+    for (std::size_t w = 0; w < workers; ++w) {
+        offsets[w + 1] = offsets[w] + counts[w];
+    }
+
+    batch.resize(offsets[workers]);
+    double *columns[6] = {batch.expiry().data(), batch.vol().data(), batch.riskFree().data(),
+                          batch.spot().data(), batch.strike().data(), batch.carry().data()};
+
+    // Second pass parses each chunk into its slice of the batch. The first malformed row of each chunk is recorded
+    std::vector<std::size_t> errors(workers, SIZE_MAX);
+    Parallel::forRange(workers, [&](std::size_t, std::size_t first, std::size_t last) {
+        for (std::size_t w = first; w < last; ++w) {
+            const char *chunkEnd = bounds[w + 1];
+            std::size_t row = offsets[w];
+
+            for (const char *p = bounds[w]; p < chunkEnd; p = nextLine(p, chunkEnd)) {
+                if (blank(p, chunkEnd)) { continue; }
+
+                const char *q = p;
+                bool ok = true;
+                for (int k = 0; k < 6 && ok; ++k) {
+                    while (q < chunkEnd && (*q == ' ' || *q == '\t')) { ++q; }
+                    if (q < chunkEnd && *q == '+') { ++q; }
+
+                    auto parsed = std::from_chars(q, chunkEnd, columns[k][row]);
+                    ok = parsed.ec == std::errc();
+                    q = parsed.ptr;
+
+                    while (q < chunkEnd && (*q == ' ' || *q == '\t')) { ++q; }
+                    if (k < 5) {
+                        ok = ok && q < chunkEnd && *q == ',';
+                        ++q;
+                    }
+                }
+
+                // The sixth field must end the row, so extra or trailing fields are rejected
+                if (q < chunkEnd && *q == '\r') { ++q; }
+                ok = ok && (q == chunkEnd || *q == '\n');
+
+                if (!ok && errors[w] == SIZE_MAX) { errors[w] = row; }
+                ++row;
+            }
+        }
+    }, 1);
+
+    for (std::size_t w = 0; w < workers; ++w) {
+        if (errors[w] != SIZE_MAX) {
+            std::cout << "Malformed option data on row " << errors[w] + 1 << ". Expected exactly T, sig, r, S, K, b\n";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Load option data from a binary columnar file written by Output::binary
+ * @note The file is memory mapped and each column is copied into the batch with a single memcpy
+ * @param path Path to the binary file
+ * @param batch Receives the option data. Any existing rows are replaced
+ * @return True if the file has a valid header and size. Otherwise false and a message is written to the console
+ */
+bool Input::binary(const std::string &path, OptionBatch &batch) {
+
+    MappedFile file(path);
+    if (!readable(file)) { return false; }
+
+    std::uint64_t n = 0;
+    if (file.size() < headerSize || std::memcmp(file.data(), magic, sizeof(magic)) != 0) {
+        std::cout << "Unrecognized binary option data\n";
+        return false;
+    }
+    std::memcpy(&n, file.data() + sizeof(magic), sizeof(n));
+
+    // Bound the row count by the file size before multiplying, so a corrupt count cannot wrap the expected size
+    std::size_t rowBytes = 6 * sizeof(double);
+    if (n > (file.size() - headerSize) / rowBytes || file.size() != headerSize + n * rowBytes) {
+        std::cout << "Truncated binary option data\n";
+        return false;
+    }
+
+    try {
+        batch.resize(static_cast<std::size_t>(n));
+    } catch (const std::exception &e) {
+        std::cout << "Cannot allocate " << n << " option rows: " << e.what() << "\n";
+        return false;
+    }
+    double *columns[6] = {batch.expiry().data(), batch.vol().data(), batch.riskFree().data(),
+                          batch.spot().data(), batch.strike().data(), batch.carry().data()};
+
+    const char *p = file.data() + headerSize;
+    Parallel::forRange(6, [&](std::size_t, std::size_t first, std::size_t last) {
+        for (std::size_t k = first; k < last; ++k) {
+            std::memcpy(columns[k], p + k * n * sizeof(double), n * sizeof(double));
+        }
+    }, 1);
+
+    return true;
+}
+
+/**
+ * Load a book of compact contract records from a binary file written by Output::binary
+ * @note The file is memory mapped and the records are copied into the book with a single memcpy
+ * @param path Path to the binary file
+ * @param contracts Receives the contract records. Any existing records are replaced
+ * @return True if the file has a valid header and size. Otherwise false and a message is written to the console
+ */
+bool Input::binary(const std::string &path, std::vector<Contract> &contracts) {
+
+    MappedFile file(path);
+    if (!readable(file)) { return false; }
+
+    std::uint64_t n = 0;
+    if (file.size() < headerSize || std::memcmp(file.data(), contractMagic, sizeof(contractMagic)) != 0) {
+        std::cout << "Unrecognized binary contract data\n";
+        return false;
+    }
+    std::memcpy(&n, file.data() + sizeof(contractMagic), sizeof(n));
+
+    // Bound the record count by the file size before multiplying, so a corrupt count cannot wrap the expected size
+    if (n > (file.size() - headerSize) / sizeof(Contract) || file.size() != headerSize + n * sizeof(Contract)) {
+        std::cout << "Truncated binary contract data\n";
+        return false;
+    }
+
+    try {
+        contracts.resize(static_cast<std::size_t>(n));
+    } catch (const std::exception &e) {
+        std::cout << "Cannot allocate " << n << " contracts: " << e.what() << "\n";
+        return false;
+    }
+    std::memcpy(contracts.data(), file.data() + headerSize, static_cast<std::size_t>(n) * sizeof(Contract));
+
+    return true;
+}
+
+/**
+ * Load option data from either a binary columnar file or a CSV file
+ * @param path Path to the file. Binary files are recognized by their header
+ * @param batch Receives the option data. Any existing rows are replaced
+ * @return True if the file was loaded. Otherwise false and a message is written to the console
+ */
+bool Input::load(const std::string &path, OptionBatch &batch) {
+
+    bool isBinary = false;
+    {
+        MappedFile file(path);
+        isBinary = file.size() >= headerSize && std::memcmp(file.data(), magic, sizeof(magic)) == 0;
+    }
+
+    return isBinary ? binary(path, batch) : csv(path, batch);
+}
@@ -0,0 +1,45 @@
+/**********************************************************************************************************************
+ * Black-Scholes Option pricing application - Input class
+ *
+ * @note Loads option data (T, sig, r, S, K, b) from memory mapped CSV or binary columnar files into an OptionBatch, and
+ * books of compact contract records from memory mapped binary files
+ *********************************************************************************************************************/
+
+#ifndef INPUT_HPP
+#define INPUT_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "Contract.hpp"
+#include "OptionBatch.hpp"
+
+class Input {
+
+private:
+
+public:
+    // Binary columnar layout: magic, row count (std::uint64_t), then the T, sig, r, S, K, b columns as native doubles
+    static constexpr char magic[8] = {'O', 'P', 'T', 'B', 'A', 'T', 'C', 'H'};
+    static constexpr std::size_t headerSize = sizeof(magic) + 8;
+
+    // Binary contract layout: contractMagic, row count (std::uint64_t), then the Contract records
+    static constexpr char contractMagic[8] = {'O', 'P', 'T', 'R', 'E', 'C', 'O', 'R'};
+
+    // Constructors and destructors
+    Input();
+    Input(const Input& source);
+    virtual ~Input();
+
+    // Operator overloading
+    Input& operator=(const Input& source);
+
+    // Core functionality
+    static bool csv(const std::string& path, OptionBatch& batch);
+    static bool binary(const std::string& path, OptionBatch& batch);
+    static bool load(const std::string& path, OptionBatch& batch);
+    static bool binary(const std::string& path, std::vector<Contract>& contracts);
+};
+
+#endif // INPUT_HPP
@@ -0,0 +1,506 @@
+/**********************************************************************************************************************
+ * Longstaff-Schwartz least-squares Monte Carlo for Bermudan and American options on one or more correlated assets
+ *********************************************************************************************************************/
+
+#ifndef LSMCENGINE_CPP
+#define LSMCENGINE_CPP
+
+#include <algorithm>
+#include <cmath>
+#include "LSMCEngine.hpp"
+#include "Cholesky.hpp"
+#include "Parallel.hpp"
+
+/**
+ * Initialize a new LSMCEngine on a single asset with annual exercise over one year
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @throws OutOfMemoryError Indicates insufficient memory for this new LSMCEngine
+ */
+template<typename RNG_>
+LSMCEngine<RNG_>::LSMCEngine() : spots(1, 100.0), vols(1, 0.2), carries(1, 0.0),
+cholesky(1, std::vector<double>(1, 1.0)), r(0.0), dates(1, 1.0), degree(3), training(16384), paths(65536), block(2048),
+seed(1), coefficients(), value(0.0), standardError(0.0) {}
+
+/**
+ * Initialize a new LSMCEngine whose data members are a deep copy of the source
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @param source A LSMCEngine whose data members will be deeply copied
+ * @throws OutOfMemoryError Indicates insufficient memory for this new LSMCEngine
+ */
+template<typename RNG_>
+LSMCEngine<RNG_>::LSMCEngine(const LSMCEngine<RNG_> &source) : spots(source.spots), vols(source.vols),
+carries(source.carries), cholesky(source.cholesky), r(source.r), dates(source.dates), degree(source.degree),
+training(source.training), paths(source.paths), block(source.block), seed(source.seed),
+coefficients(source.coefficients), value(source.value), standardError(source.standardError) {}
+
+/**
+ * Initialize a new LSMCEngine with the specified market data and exercise dates
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @param spots_ Spot price of each asset
+ * @param vols_ Volatility of each asset
+ * @param carries_ Cost of carry of each asset
+ * @param correlation Correlation matrix of the assets
+ * @param r_ Risk-free interest rate
+ * @param dates_ Exercise dates in years, increasing and after today. The last one is the expiry
+ * @throws std::invalid_argument If the correlation matrix is not positive definite
+ */
+template<typename RNG_>
+LSMCEngine<RNG_>::LSMCEngine(const std::vector<double> &spots_, const std::vector<double> &vols_,
+        const std::vector<double> &carries_, const std::vector<std::vector<double>> &correlation, double r_,
+        const std::vector<double> &dates_) : LSMCEngine() {
+
+    spots = spots_;
+    vols = vols_;
+    carries = carries_;
+    r = r_;
+    dates = dates_;
+
+    cholesky = Cholesky::factor(correlation);
+}
+
+/**
+ * Destroy this LSMCEngine
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ */
+template<typename RNG_>
+LSMCEngine<RNG_>::~LSMCEngine() {}
+
+/**
+ * Deeply copy the source data members into this LSMCEngine
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @param source A LSMCEngine whose data members will be deeply copied
+ * @return This LSMCEngine whose data members are a deep copy of the source data members
+ */
+template<typename RNG_>
+LSMCEngine<RNG_>& LSMCEngine<RNG_>::operator=(const LSMCEngine<RNG_> &source) {
+    // Avoid self assign
+    if (this == &source) { return *this; }
+
+    spots = source.spots;
+    vols = source.vols;
+    carries = source.carries;
+    cholesky = source.cholesky;
+    r = source.r;
+    dates = source.dates;
+    degree = source.degree;
+    training = source.training;
+    paths = source.paths;
+    block = source.block;
+    seed = source.seed;
+    coefficients = source.coefficients;
+    value = source.value;
+    standardError = source.standardError;
+
+    return *this;
+}
+
+/**
+ * Equally spaced exercise dates up to expiry
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @param T_ Expiry time/maturity
+ * @param n Number of exercise dates. Many dates approximate an American option
+ * @return The dates T / n, 2T / n, ..., T
+ */
+template<typename RNG_>
+std::vector<double> LSMCEngine<RNG_>::schedule(double T_, std::size_t n) {
+    std::vector<double> result(n);
+    for (std::size_t t = 0; t < n; ++t) {
+        result[t] = T_ * static_cast<double>(t + 1) / static_cast<double>(n);
+    }
+    return result;
+}
+
+/* ********************************************************************************************************************
+ * Core pricing functionality
+ *********************************************************************************************************************/
+
+/**
+ * Learn the exercise rule on training paths, then estimate the price on independent paths
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Payoff Callable with the signature double(const double* S) that returns the exercise value given the spot of
+ * every asset, e.g. max(K - S[0], 0) for a Put or max(K - (S[0] + S[1]) / 2, 0) for a basket Put
+ * @param payoff Exercise value
+ * @return The price estimate. Its standard error is available from error()
+ */
+template<typename RNG_>
+template<typename Payoff>
+double LSMCEngine<RNG_>::price(const Payoff &payoff) {
+    regress(payoff);
+    return estimate(payoff);
+}
+
+/**
+ * Learn the exercise rule by backward induction over the training paths
+ * @note At each exercise date the discounted value of following the rule is regressed on the basis over the paths that
+ * are in the money, and paths whose exercise value beats the fitted continuation value are exercised. The normal
+ * equations are accumulated per block of paths and reduced in block order before the solve, so the coefficients do not
+ * depend on the number of threads. The spots of every training path at every date are stored, N * m * training
+ * doubles, so the memory of this stage grows with the number of training paths rather than the block size
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Payoff Callable with the signature double(const double* S)
+ * @param payoff Exercise value
+ */
+template<typename RNG_>
+template<typename Payoff>
+void LSMCEngine<RNG_>::regress(const Payoff &payoff) {
+
+    std::size_t N = dates.size(), m = spots.size(), n = training, k = size();
+
+    std::vector<double> drift, diffusion;
+    steps(drift, diffusion);
+
+    // Spots of every path, time-major: (t * m + asset) * n + path
+    std::vector<double> state(N * m * n);
+    std::size_t blocks = (n + block - 1) / block;
+
+    Parallel::forRange(blocks, [&](std::size_t, std::size_t first, std::size_t last) {
+        std::vector<double> z, s(m);
+        for (std::size_t j = first; j < last; ++j) {
+            std::size_t p0 = j * block, p1 = std::min(n, p0 + block);
+
+            z.resize((p1 - p0) * N * m);
+            RNG_::MersenneTwister(z, seed + 2 * static_cast<unsigned int>(j));
+
+            for (std::size_t p = p0; p < p1; ++p) {
+                std::copy(spots.begin(), spots.end(), s.begin());
+                for (std::size_t t = 0; t < N; ++t) {
+                    evolve(z.data() + ((p - p0) * N + t) * m, drift.data() + t * m, diffusion.data() + t * m,
+                           s.data());
+                    for (std::size_t a = 0; a < m; ++a) {
+                        state[(t * m + a) * n + p] = s[a];
+                    }
+                }
+            }
+        }
+    }, 1);
+
+    // Value of following the rule, as of the current exercise date
+    std::vector<double> V(n), h(n);
+    Parallel::forRange(n, [&](std::size_t, std::size_t first, std::size_t last) {
+        std::vector<double> s(m);
+        for (std::size_t p = first; p < last; ++p) {
+            for (std::size_t a = 0; a < m; ++a) {
+                s[a] = state[((N - 1) * m + a) * n + p];
+            }
+            V[p] = payoff(s.data());
+        }
+    });
+
+    coefficients.assign(N, std::vector<double>());
+    std::vector<double> A(blocks * k * k), g(blocks * k);
+
+    for (std::size_t t = N - 1; t-- > 0;) {
+        double discount = exp(-r * (dates[t + 1] - dates[t]));
+
+        // Normal equations of each block of paths over the paths in the money
+        std::fill(A.begin(), A.end(), 0.0);
+        std::fill(g.begin(), g.end(), 0.0);
+        Parallel::forRange(blocks, [&](std::size_t, std::size_t first, std::size_t last) {
+            std::vector<double> s(m), phi(k);
+            for (std::size_t j = first; j < last; ++j) {
+                std::size_t p0 = j * block, p1 = std::min(n, p0 + block);
+                double *Aj = A.data() + j * k * k, *gj = g.data() + j * k;
+
+                for (std::size_t p = p0; p < p1; ++p) {
+                    V[p] *= discount;
+                    for (std::size_t a = 0; a < m; ++a) {
+                        s[a] = state[(t * m + a) * n + p];
+                    }
+                    h[p] = payoff(s.data());
+                    if (h[p] <= 0.0) { continue; }
+
+                    basis(s.data(), phi.data());
+                    for (std::size_t i = 0; i < k; ++i) {
+                        gj[i] += phi[i] * V[p];
+                        for (std::size_t l = 0; l <= i; ++l) {
+                            Aj[i * k + l] += phi[i] * phi[l];
+                        }
+                    }
+                }
+            }
+        }, 1);
+
+        // Reduce in block order so that the regression does not depend on the number of threads
+        for (std::size_t j = 1; j < blocks; ++j) {
+            for (std::size_t i = 0; i < k * k; ++i) { A[i] += A[j * k * k + i]; }
+            for (std::size_t i = 0; i < k; ++i) { g[i] += g[j * k + i]; }
+        }
+        std::vector<double> normal(A.begin(), A.begin() + k * k), rhs(g.begin(), g.begin() + k);
+        for (std::size_t i = 0; i < k; ++i) {
+            for (std::size_t l = 0; l < i; ++l) {
+                normal[l * k + i] = normal[i * k + l];
+            }
+        }
+
+        // A small ridge relative to the diagonal keeps nearly collinear bases solvable. Without a regression there is
+        // no exercise at this date
+        for (std::size_t i = 0; i < k; ++i) {
+            normal[i * k + i] *= 1.0 + 1e-10;
+        }
+        if (!Cholesky::solve(normal, rhs, coefficients[t])) {
+            coefficients[t].clear();
+            continue;
+        }
+
+        const std::vector<double> &beta = coefficients[t];
+        Parallel::forRange(n, [&](std::size_t, std::size_t first, std::size_t last) {
+            std::vector<double> s(m), phi(k);
+            for (std::size_t p = first; p < last; ++p) {
+                if (h[p] <= 0.0) { continue; }
+
+                for (std::size_t a = 0; a < m; ++a) {
+                    s[a] = state[(t * m + a) * n + p];
+                }
+                basis(s.data(), phi.data());
+
+                double continuation = 0.0;
+                for (std::size_t i = 0; i < k; ++i) {
+                    continuation += phi[i] * beta[i];
+                }
+                if (h[p] > continuation) { V[p] = h[p]; }
+            }
+        });
+    }
+}
+
+/**
+ * Estimate the price by following the learned exercise rule on paths independent of the training paths
+ * @note Paths are simulated forward in blocks, each with its own seed, and a path stops at its first exercise. Only
+ * the variates of one block per thread are held in memory
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @tparam Payoff Callable with the signature double(const double* S)
+ * @param payoff Exercise value
+ * @return The price estimate. Its standard error is available from error()
+ */
+template<typename RNG_>
+template<typename Payoff>
+double LSMCEngine<RNG_>::estimate(const Payoff &payoff) {
+
+    std::size_t N = dates.size(), m = spots.size(), n = paths, k = size();
+    if (coefficients.size() != N) { coefficients.assign(N, std::vector<double>()); }
+
+    std::vector<double> drift, diffusion, discount(N);
+    steps(drift, diffusion);
+    for (std::size_t t = 0; t < N; ++t) {
+        discount[t] = exp(-r * dates[t]);
+    }
+
+    std::size_t blocks = (n + block - 1) / block;
+    std::vector<double> sums(blocks, 0.0), squares(blocks, 0.0);
+
+    Parallel::forRange(blocks, [&](std::size_t, std::size_t first, std::size_t last) {
+        std::vector<double> z, s(m), phi(k);
+        for (std::size_t j = first; j < last; ++j) {
+            std::size_t p0 = j * block, p1 = std::min(n, p0 + block);
+
+            z.resize((p1 - p0) * N * m);
+            RNG_::MersenneTwister(z, seed + 2 * static_cast<unsigned int>(j) + 1);
+
+            double sum = 0.0, square = 0.0;
+            for (std::size_t p = p0; p < p1; ++p) {
+                std::copy(spots.begin(), spots.end(), s.begin());
+
+                double cash = 0.0;
+                for (std::size_t t = 0; t < N; ++t) {
+                    evolve(z.data() + ((p - p0) * N + t) * m, drift.data() + t * m, diffusion.data() + t * m,
+                           s.data());
+
+                    double exercise = payoff(s.data());
+                    if (exercise <= 0.0) { continue; }
+                    if (t + 1 < N) {
+                        const std::vector<double> &beta = coefficients[t];
+                        if (beta.empty()) { continue; }
+
+                        basis(s.data(), phi.data());
+                        double continuation = 0.0;
+                        for (std::size_t i = 0; i < k; ++i) {
+                            continuation += phi[i] * beta[i];
+                        }
+                        if (exercise <= continuation) { continue; }
+                    }
+
+                    cash = discount[t] * exercise;
+                    break;
+                }
+
+                sum += cash;
+                square += cash * cash;
+            }
+
+            sums[j] = sum;
+            squares[j] = square;
+        }
+    }, 1);
+
+    // Reduce in block order so that the estimate does not depend on the number of threads
+    double sum = 0.0, square = 0.0;
+    for (std::size_t j = 0; j < blocks; ++j) {
+        sum += sums[j];
+        square += squares[j];
+    }
+
+    value = sum / static_cast<double>(n);
+    double variance = std::max(square / static_cast<double>(n) - value * value, 0.0);
+    standardError = sqrt(variance / static_cast<double>(n));
+
+    return value;
+}
+
+/* ********************************************************************************************************************
+ * Helper functions
+ *********************************************************************************************************************/
+
+/*
+ * Log spot drift and diffusion of each asset between consecutive exercise dates
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @param drift Receives (b - sig^2 / 2) dt, one row of assets per date
+ * @param diffusion Receives sig sqrt(dt), one row of assets per date
+ */
+template<typename RNG_>
+void LSMCEngine<RNG_>::steps(std::vector<double> &drift, std::vector<double> &diffusion) const {
+
+    std::size_t N = dates.size(), m = spots.size();
+    drift.resize(N * m);
+    diffusion.resize(N * m);
+
+    for (std::size_t t = 0; t < N; ++t) {
+        double dt = dates[t] - (t == 0 ? 0.0 : dates[t - 1]);
+        for (std::size_t a = 0; a < m; ++a) {
+            drift[t * m + a] = (carries[a] - 0.5 * vols[a] * vols[a]) * dt;
+            diffusion[t * m + a] = vols[a] * sqrt(dt);
+        }
+    }
+}
+
+/*
+ * Move the spots of one path to the next exercise date
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @param z Independent standard normal variates, one per asset
+ * @param drift Log spot drift of each asset over the step
+ * @param diffusion Log spot diffusion of each asset over the step
+ * @param s Spots of the path, updated in place
+ */
+template<typename RNG_>
+void LSMCEngine<RNG_>::evolve(const double *z, const double *drift, const double *diffusion, double *s) const {
+    std::size_t m = spots.size();
+    for (std::size_t a = 0; a < m; ++a) {
+        double x = 0.0;
+        for (std::size_t v = 0; v <= a; ++v) {
+            x += cholesky[a][v] * z[v];
+        }
+        s[a] *= exp(drift[a] + diffusion[a] * x);
+    }
+}
+
+/*
+ * Regression basis at one set of spots
+ * @note The spots are scaled by today's spots. The basis is a constant, the powers 1 to degree of each asset, and the
+ * pairwise products of the assets when the degree is at least two
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @param s Spot of every asset
+ * @param phi Receives size() basis functions
+ */
+template<typename RNG_>
+void LSMCEngine<RNG_>::basis(const double *s, double *phi) const {
+
+    std::size_t m = spots.size(), i = 0;
+    phi[i++] = 1.0;
+
+    for (std::size_t a = 0; a < m; ++a) {
+        double x = s[a] / spots[a], power = 1.0;
+        for (std::size_t d = 0; d < degree; ++d) {
+            power *= x;
+            phi[i++] = power;
+        }
+    }
+
+    if (degree >= 2) {
+        for (std::size_t a = 0; a < m; ++a) {
+            for (std::size_t c = a + 1; c < m; ++c) {
+                phi[i++] = (s[a] / spots[a]) * (s[c] / spots[c]);
+            }
+        }
+    }
+}
+
+/* ********************************************************************************************************************
+ * Accessors
+ *********************************************************************************************************************/
+
+/**
+ * Number of assets
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @return The number of underlyings simulated on each path
+ */
+template<typename RNG_>
+std::size_t LSMCEngine<RNG_>::assets() const { return spots.size(); }
+
+/**
+ * Number of basis functions
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @return The number of regression coefficients of each exercise date
+ */
+template<typename RNG_>
+std::size_t LSMCEngine<RNG_>::size() const {
+    std::size_t m = spots.size();
+    return 1 + m * degree + (degree >= 2 ? m * (m - 1) / 2 : 0);
+}
+
+/**
+ * Standard error of the last price estimate
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @return The sample standard deviation of the discounted cash flows over the square root of the number of paths
+ */
+template<typename RNG_>
+double LSMCEngine<RNG_>::error() const { return standardError; }
+
+/**
+ * Learned exercise rule
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @return The continuation value coefficients of each exercise date. Empty rows never exercise before expiry
+ */
+template<typename RNG_>
+const std::vector<std::vector<double>>& LSMCEngine<RNG_>::exercise() const { return coefficients; }
+
+/**
+ * Exercise dates
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @return The exercise dates in years
+ */
+template<typename RNG_>
+const std::vector<double>& LSMCEngine<RNG_>::schedule() const { return dates; }
+
+/* ********************************************************************************************************************
+ * Mutators
+ *********************************************************************************************************************/
+
+/**
+ * Set the highest power of each asset in the regression basis
+ * @note The learned exercise rule is cleared because its coefficients no longer match the basis
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @param degree_ Highest power, at least one
+ */
+template<typename RNG_>
+void LSMCEngine<RNG_>::basis(std::size_t degree_) {
+    degree = std::max<std::size_t>(degree_, 1);
+    coefficients.clear();
+}
+
+/**
+ * Set the number of paths and the seed
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @param training_ Number of paths used to learn the exercise rule. Their spots at every date are held in memory
+ * @param paths_ Number of paths used to estimate the price
+ * @param block_ Number of paths simulated together. Memory of the estimate is bounded by one block per thread
+ * @param seed_ Seed of the first block of paths
+ */
+template<typename RNG_>
+void LSMCEngine<RNG_>::simulation(std::size_t training_, std::size_t paths_, std::size_t block_,
+                                  unsigned int seed_) {
+    training = training_;
+    paths = paths_;
+    block = std::max<std::size_t>(block_, 1);
+    seed = seed_;
+}
+
+#endif
@@ -0,0 +1,89 @@
+/**********************************************************************************************************************
+ * Longstaff-Schwartz least-squares Monte Carlo for Bermudan and American options on one or more correlated assets
+ *
+ * @note A host class for the RNG policy. The exercise rule is learned on a set of training paths stored time-major, so
+ * the spots of every path at one exercise date are contiguous and each regression streams through one slice. The
+ * continuation value is regressed on a polynomial basis by a Cholesky solve of the normal equations. Training holds
+ * the spots of every training path at every exercise date, N * m * training doubles, so its memory is not bounded by
+ * the block size. The price is then estimated on fresh paths that are simulated and exercised in fixed blocks, so the
+ * memory of pricing is bounded by the block size rather than the number of paths, and the estimate is free of the
+ * foresight bias of in-sample pricing. Simulation, regression, and pricing are partitioned across threads with one
+ * seed per block of paths, and sums are reduced in block order, so the result does not depend on the number of threads
+ *********************************************************************************************************************/
+
+#ifndef LSMCENGINE_HPP
+#define LSMCENGINE_HPP
+
+#include <cstddef>
+#include <vector>
+
+template<typename RNG_>
+class LSMCEngine {
+private:
+    // Market data of the underlyings
+    std::vector<double> spots;                   // Spot price of each asset
+    std::vector<double> vols;                    // Volatility of each asset
+    std::vector<double> carries;                 // Cost of carry of each asset
+    std::vector<std::vector<double>> cholesky;   // Lower Cholesky factor of the correlation matrix
+    double r;                                    // Risk-free interest rate
+    std::vector<double> dates;                   // Exercise dates in years, increasing. The last one is the expiry
+
+    // Simulation settings
+    std::size_t degree;                          // Highest power of each asset in the regression basis
+    std::size_t training;                        // Number of paths used to learn the exercise rule
+    std::size_t paths;                           // Number of paths used to estimate the price
+    std::size_t block;                           // Number of paths simulated together
+    unsigned int seed;                           // Seed of the first block of paths
+
+    // Results of the last run
+    std::vector<std::vector<double>> coefficients; // Continuation value regression of each exercise date
+    double value;                                // Price estimate
+    double standardError;                        // Standard error of the price estimate
+
+    // Helper functions
+    void steps(std::vector<double>& drift, std::vector<double>& diffusion) const;
+    void evolve(const double* z, const double* drift, const double* diffusion, double* s) const;
+    void basis(const double* s, double* phi) const;
+
+public:
+    // Constructors and destructors
+    LSMCEngine();
+    LSMCEngine(const LSMCEngine& source);
+    LSMCEngine(const std::vector<double>& spots_, const std::vector<double>& vols_,
+               const std::vector<double>& carries_, const std::vector<std::vector<double>>& correlation, double r_,
+               const std::vector<double>& dates_);
+    virtual ~LSMCEngine();
+
+    // Operator overloading
+    LSMCEngine& operator=(const LSMCEngine& source);
+
+    // Equally spaced exercise dates up to expiry. Many dates approximate an American option
+    static std::vector<double> schedule(double T_, std::size_t n);
+
+    // Learn the exercise rule, then estimate the price on independent paths
+    template<typename Payoff>
+    double price(const Payoff& payoff);
+
+    // The two stages of price, exposed so that one learned rule can be reused across pricing runs
+    template<typename Payoff>
+    void regress(const Payoff& payoff);
+    template<typename Payoff>
+    double estimate(const Payoff& payoff);
+
+    // Accessors
+    std::size_t assets() const;
+    std::size_t size() const;
+    double error() const;
+    const std::vector<std::vector<double>>& exercise() const;
+    const std::vector<double>& schedule() const;
+
+    // Mutators
+    void basis(std::size_t degree_);
+    void simulation(std::size_t training_, std::size_t paths_, std::size_t block_, unsigned int seed_);
+};
+
+#ifndef LSMCENGINE_CPP
+#include "LSMCEngine.cpp"
+
+#endif // LSMCENGINE_CPP
+#endif // LSMCENGINE_HPP
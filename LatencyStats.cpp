@@ -0,0 +1,149 @@
+/**********************************************************************************************************************
+ * Thread safe collector of latency samples that reports percentiles
+ *********************************************************************************************************************/
+
+#include <algorithm>
+
+#include "LatencyStats.hpp"
+
+/**
+ * Initialize a new LatencyStats with no samples that keeps up to 65536 of them
+ * @throws OutOfMemoryError Indicates insufficient memory for this new LatencyStats
+ */
+LatencyStats::LatencyStats() : LatencyStats(65536) {}
+
+/**
+ * Initialize a new LatencyStats with no samples
+ * @param capacity_ Largest number of samples kept. At least 1
+ * @throws OutOfMemoryError Indicates insufficient memory for this new LatencyStats
+ */
+LatencyStats::LatencyStats(std::size_t capacity_) : samples(), capacity(std::max<std::size_t>(capacity_, 1)), seen(0),
+engine(), lock() {}
+
+/**
+ * Initialize a deep copy of the source
+ * @param source A LatencyStats whose samples will be deeply copied
+ * @throws OutOfMemoryError Indicates insufficient memory for this new LatencyStats
+ */
+LatencyStats::LatencyStats(const LatencyStats &source) : samples(), capacity(1), seen(0), engine(), lock() {
+    std::lock_guard<std::mutex> guard(source.lock);
+    samples = source.samples;
+    capacity = source.capacity;
+    seen = source.seen;
+    engine = source.engine;
+}
+
+/**
+ * Destroy this LatencyStats
+ */
+LatencyStats::~LatencyStats() {}
+
+/**
+ * Deeply copy the source
+ * @param source A LatencyStats whose samples will be deeply copied
+ * @return This LatencyStats whose samples are now a deep copy of the source samples
+ */
+LatencyStats & LatencyStats::operator=(const LatencyStats &source) {
+    // Avoid self assign
+    if (this == &source) { return *this; }
+
+    LatencyStats copy(source);
+
+    std::lock_guard<std::mutex> guard(lock);
+    samples.swap(copy.samples);
+    capacity = copy.capacity;
+    seen = copy.seen;
+    engine = copy.engine;
+
+    return *this;
+}
+
+/*
+ * Keep a latency while the window has room, otherwise let it replace a kept sample with probability capacity / seen
+ * @param micros Latency in microseconds
+ */
+void LatencyStats::record(double micros) {
+    ++seen;
+    if (samples.size() < capacity) {
+        samples.push_back(micros);
+        return;
+    }
+
+    std::uint64_t slot = std::uniform_int_distribution<std::uint64_t>(0, seen - 1)(engine);
+    if (slot < capacity) { samples[static_cast<std::size_t>(slot)] = micros; }
+}
+
+/**
+ * Record a single sample
+ * @param micros Latency in microseconds
+ */
+void LatencyStats::add(double micros) {
+    std::lock_guard<std::mutex> guard(lock);
+    record(micros);
+}
+
+/**
+ * Record a group of samples under a single lock
+ * @param micros Latencies in microseconds
+ */
+void LatencyStats::add(const std::vector<double> &micros) {
+    std::lock_guard<std::mutex> guard(lock);
+    for (double sample : micros) {
+        record(sample);
+    }
+}
+
+/**
+ * Discard every sample and start a new window
+ */
+void LatencyStats::reset() {
+    std::lock_guard<std::mutex> guard(lock);
+    samples.clear();
+    seen = 0;
+}
+
+/**
+ * Number of samples recorded since the last reset, including those not kept
+ * @return The number of samples
+ */
+std::size_t LatencyStats::count() const {
+    std::lock_guard<std::mutex> guard(lock);
+    return static_cast<std::size_t>(seen);
+}
+
+/**
+ * A single percentile of the recorded samples
+ * @param q Percentile in [0, 1] (e.g. 0.99)
+ * @return The sample at the requested percentile, or 0 if there are no samples
+ */
+double LatencyStats::percentile(double q) const {
+    return percentiles({q})[0];
+}
+
+/**
+ * Several percentiles of the recorded samples
+ * @note Each percentile is found with std::nth_element on a copy of the kept samples rather than a full sort. Exact
+ * until the window exceeds the capacity and estimated from the uniform sample after that
+ * @param qs Percentiles in [0, 1]
+ * @return One sample per requested percentile. Every value is 0 if there are no samples
+ */
+std::vector<double> LatencyStats::percentiles(const std::vector<double> &qs) const {
+
+    std::vector<double> copy;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        copy = samples;
+    }
+
+    std::vector<double> result(qs.size(), 0.0);
+    if (copy.empty()) { return result; }
+
+    for (std::size_t i = 0; i < qs.size(); ++i) {
+        double q = std::min(std::max(qs[i], 0.0), 1.0);
+        auto k = copy.begin() + static_cast<std::ptrdiff_t>(q * (copy.size() - 1));
+        std::nth_element(copy.begin(), k, copy.end());
+        result[i] = *k;
+    }
+
+    return result;
+}
@@ -0,0 +1,49 @@
+/**********************************************************************************************************************
+ * Thread safe collector of latency samples that reports percentiles
+ *
+ * @note Memory is bounded. Once a window holds capacity samples, later samples replace earlier ones by reservoir
+ * sampling, so the kept samples stay a uniform random sample of the window and the percentiles become estimates
+ *********************************************************************************************************************/
+
+#ifndef LATENCYSTATS_HPP
+#define LATENCYSTATS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <vector>
+
+class LatencyStats {
+private:
+    std::vector<double> samples;                 // Uniform sample of the latencies in microseconds since the last reset
+    std::size_t capacity;                        // Largest number of samples kept
+    std::uint64_t seen;                          // Latencies recorded since the last reset
+    std::mt19937_64 engine;                      // Chooses the sample a latency replaces once the window is full
+    mutable std::mutex lock;                     // Guards every member above
+
+    // Helper function that records one latency with the lock held
+    void record(double micros);
+
+public:
+    // Constructors and destructors
+    LatencyStats();
+    explicit LatencyStats(std::size_t capacity_);
+    LatencyStats(const LatencyStats& source);
+    virtual ~LatencyStats();
+
+    // Operator overloading
+    LatencyStats& operator=(const LatencyStats& source);
+
+    // Record samples
+    void add(double micros);
+    void add(const std::vector<double>& micros);
+    void reset();
+
+    // Summary statistics
+    std::size_t count() const;
+    double percentile(double q) const;
+    std::vector<double> percentiles(const std::vector<double>& qs) const;
+};
+
+#endif // LATENCYSTATS_HPP
@@ -38,6 +38,29 @@ Matrix & Matrix::operator=(const Matrix &source) {
     return *this;
 }
 
+/**
+ * Identify the option parameter that a property string varies
+ * @note Accepts the same spellings as the matrix functions, so a host class can specialize on the varied parameter
+ * @param property The variate parameter, which should be represented by the variate symbol (e.g. T, sig, r, S, K, b)
+ * @return The parameter, or Unknown if the matrix functions would not recognize the property
+ */
+Matrix::Property Matrix::property(const std::string &property) {
+    if (property == "T" || property == "t" || property == "Expiry" || property == "expiry") {
+        return Property::Expiry;
+    } else if (property == "Sig" || property == "sig" || property == "Volatility" || property == "volatility" ) {
+        return Property::Volatility;
+    } else if (property == "R" || property == "r" || property == "Risk-free" || property == "risk-free" ) {
+        return Property::RiskFree;
+    } else if (property == "S" || property == "s" || property == "Spot" || property == "spot" ) {
+        return Property::Spot;
+    } else if (property == "K" || property == "k" || property == "Strike" || property == "strike" ) {
+        return Property::Strike;
+    } else if (property == "B" || property == "b" || property == "Beta" || property == "beta" ) {
+        return Property::Carry;
+    }
+    return Property::Unknown;
+}
+
 /**
  * Create a matrix of American options. Each row will variate one parameter by a monotonically increasing amount
  * @note American options do not require b=r
@@ -13,6 +13,9 @@
 class Matrix {
 private:
 public:
+    // Option parameter named by a property string
+    enum class Property { Expiry, Volatility, RiskFree, Spot, Strike, Carry, Unknown };
+
     Matrix();
     Matrix(const Matrix& source);
     virtual ~Matrix();
@@ -20,6 +23,9 @@ public:
     // Operator overloading
     Matrix& operator=(const Matrix& source);
 
+    // Parameter varied by the matrices for a property string (e.g. "S" or "spot")
+    static Property property(const std::string& property);
+
     // Generate matrices
     static std::vector<std::vector<double>>
     matrix(const std::vector<double>& mesh, const std::string &property, double sig, double r, double S,
@@ -0,0 +1,244 @@
+/**********************************************************************************************************************
+ * Structure-of-arrays container of option parameters (T, sig, r, S, K, b)
+ *********************************************************************************************************************/
+
+#ifndef OPTIONBATCH_CPP
+#define OPTIONBATCH_CPP
+
+#include "OptionBatch.hpp"
+
+/**
+ * Initialize a new empty OptionBatch
+ * @tparam Real_ Numeric type of the columns (double or float)
+ * @throws OutOfMemoryError Indicates insufficient memory for this new OptionBatch
+ */
+template<typename Real_>
+BasicOptionBatch<Real_>::BasicOptionBatch() : T(), sig(), r(), S(), K(), b() {}
+
+/**
+ * Initialize a deep copy of the source OptionBatch
+ * @tparam Real_ Numeric type of the columns (double or float)
+ * @param source An OptionBatch whose columns will be deeply copied
+ * @throws OutOfMemoryError Indicates insufficient memory for this new OptionBatch
+ */
+template<typename Real_>
+BasicOptionBatch<Real_>::BasicOptionBatch(const BasicOptionBatch<Real_> &source) : T(source.T), sig(source.sig),
+r(source.r), S(source.S), K(source.K), b(source.b) {}
+
+/**
+ * Initialize a new OptionBatch with n zero initialized rows
+ * @tparam Real_ Numeric type of the columns (double or float)
+ * @param n Number of rows
+ * @throws OutOfMemoryError Indicates insufficient memory for this new OptionBatch
+ */
+template<typename Real_>
+BasicOptionBatch<Real_>::BasicOptionBatch(std::size_t n) : T(n), sig(n), r(n), S(n), K(n), b(n) {}
+
+/**
+ * Initialize a new OptionBatch from a matrix of option parameters created by the Matrix policy
+ * @tparam Real_ Numeric type of the columns (double or float)
+ * @param matrix A matrix of option parameters where each row has T, sig, r, S, K, b
+ * @throws OutOfMemoryError Indicates insufficient memory for this new OptionBatch
+ */
+template<typename Real_>
+BasicOptionBatch<Real_>::BasicOptionBatch(const std::vector<std::vector<double>> &matrix) : BasicOptionBatch() {
+    reserve(matrix.size());
+    for (const auto &row : matrix) {
+        push_back(static_cast<Real_>(row[0]), static_cast<Real_>(row[1]), static_cast<Real_>(row[2]),
+                  static_cast<Real_>(row[3]), static_cast<Real_>(row[4]), static_cast<Real_>(row[5]));
+    }
+}
+
+/**
+ * Destroy this OptionBatch
+ * @tparam Real_ Numeric type of the columns (double or float)
+ */
+template<typename Real_>
+BasicOptionBatch<Real_>::~BasicOptionBatch() {}
+
+/**
+ * Deeply copy the source
+ * @tparam Real_ Numeric type of the columns (double or float)
+ * @param source An OptionBatch whose columns will be deeply copied
+ * @return This OptionBatch whose columns are now a deep copy of the source columns
+ */
+template<typename Real_>
+BasicOptionBatch<Real_>& BasicOptionBatch<Real_>::operator=(const BasicOptionBatch<Real_> &source) {
+    // Avoid self assign
+    if (this == &source) { return *this; }
+
+    T = source.T;
+    sig = source.sig;
+    r = source.r;
+    S = source.S;
+    K = source.K;
+    b = source.b;
+
+    return *this;
+}
+
+/**
+ * Number of rows in this OptionBatch
+ * @tparam Real_ Numeric type of the columns (double or float)
+ * @return The number of options
+ */
+template<typename Real_>
+std::size_t BasicOptionBatch<Real_>::size() const { return T.size(); }
+
+/**
+ * Reserve capacity for n rows in every column
+ * @tparam Real_ Numeric type of the columns (double or float)
+ * @param n Number of rows
+ */
+template<typename Real_>
+void BasicOptionBatch<Real_>::reserve(std::size_t n) {
+    T.reserve(n);
+    sig.reserve(n);
+    r.reserve(n);
+    S.reserve(n);
+    K.reserve(n);
+    b.reserve(n);
+}
+
+/**
+ * Resize every column to n rows
+ * @tparam Real_ Numeric type of the columns (double or float)
+ * @param n Number of rows
+ */
+template<typename Real_>
+void BasicOptionBatch<Real_>::resize(std::size_t n) {
+    T.resize(n);
+    sig.resize(n);
+    r.resize(n);
+    S.resize(n);
+    K.resize(n);
+    b.resize(n);
+}
+
+/**
+ * Remove every row from this OptionBatch. Capacity is retained
+ * @tparam Real_ Numeric type of the columns (double or float)
+ */
+template<typename Real_>
+void BasicOptionBatch<Real_>::clear() {
+    T.clear();
+    sig.clear();
+    r.clear();
+    S.clear();
+    K.clear();
+    b.clear();
+}
+
+/**
+ * Append a single row of option data
+ * @tparam Real_ Numeric type of the columns (double or float)
+ * @param T_ Expiry
+ * @param sig_ Volatility
+ * @param r_ Risk-free rate
+ * @param S_ Spot price
+ * @param K_ Strike price
+ * @param b_ Cost of carry
+ */
+template<typename Real_>
+void BasicOptionBatch<Real_>::push_back(Real_ T_, Real_ sig_, Real_ r_, Real_ S_, Real_ K_, Real_ b_) {
+    T.push_back(T_);
+    sig.push_back(sig_);
+    r.push_back(r_);
+    S.push_back(S_);
+    K.push_back(K_);
+    b.push_back(b_);
+}
+
+/* ********************************************************************************************************************
+ * Accessors
+ *********************************************************************************************************************/
+
+/**
+ * @tparam Real_ Numeric type of the columns (double or float)
+ * @return The column of Expiries
+ */
+template<typename Real_>
+const std::vector<Real_>& BasicOptionBatch<Real_>::expiry() const { return T; }
+
+/**
+ * @tparam Real_ Numeric type of the columns (double or float)
+ * @return The column of Volatilities
+ */
+template<typename Real_>
+const std::vector<Real_>& BasicOptionBatch<Real_>::vol() const { return sig; }
+
+/**
+ * @tparam Real_ Numeric type of the columns (double or float)
+ * @return The column of Risk-Free Rates
+ */
+template<typename Real_>
+const std::vector<Real_>& BasicOptionBatch<Real_>::riskFree() const { return r; }
+
+/**
+ * @tparam Real_ Numeric type of the columns (double or float)
+ * @return The column of Spot prices
+ */
+template<typename Real_>
+const std::vector<Real_>& BasicOptionBatch<Real_>::spot() const { return S; }
+
+/**
+ * @tparam Real_ Numeric type of the columns (double or float)
+ * @return The column of Strike prices
+ */
+template<typename Real_>
+const std::vector<Real_>& BasicOptionBatch<Real_>::strike() const { return K; }
+
+/**
+ * @tparam Real_ Numeric type of the columns (double or float)
+ * @return The column of Costs of Carry
+ */
+template<typename Real_>
+const std::vector<Real_>& BasicOptionBatch<Real_>::carry() const { return b; }
+
+/* ********************************************************************************************************************
+ * Mutators
+ *********************************************************************************************************************/
+
+/**
+ * @tparam Real_ Numeric type of the columns (double or float)
+ * @return A mutable reference to the column of Expiries
+ */
+template<typename Real_>
+std::vector<Real_>& BasicOptionBatch<Real_>::expiry() { return T; }
+
+/**
+ * @tparam Real_ Numeric type of the columns (double or float)
+ * @return A mutable reference to the column of Volatilities
+ */
+template<typename Real_>
+std::vector<Real_>& BasicOptionBatch<Real_>::vol() { return sig; }
+
+/**
+ * @tparam Real_ Numeric type of the columns (double or float)
+ * @return A mutable reference to the column of Risk-Free Rates
+ */
+template<typename Real_>
+std::vector<Real_>& BasicOptionBatch<Real_>::riskFree() { return r; }
+
+/**
+ * @tparam Real_ Numeric type of the columns (double or float)
+ * @return A mutable reference to the column of Spot prices
+ */
+template<typename Real_>
+std::vector<Real_>& BasicOptionBatch<Real_>::spot() { return S; }
+
+/**
+ * @tparam Real_ Numeric type of the columns (double or float)
+ * @return A mutable reference to the column of Strike prices
+ */
+template<typename Real_>
+std::vector<Real_>& BasicOptionBatch<Real_>::strike() { return K; }
+
+/**
+ * @tparam Real_ Numeric type of the columns (double or float)
+ * @return A mutable reference to the column of Costs of Carry
+ */
+template<typename Real_>
+std::vector<Real_>& BasicOptionBatch<Real_>::carry() { return b; }
+
+#endif
@@ -0,0 +1,71 @@
+/**********************************************************************************************************************
+ * Structure-of-arrays container of option parameters (T, sig, r, S, K, b)
+ *
+ * @note Each column is stored contiguously so the batch pricing functions can stream through a single parameter. The
+ * numeric type of the columns is a template parameter so that batches can be priced in single precision
+ *********************************************************************************************************************/
+
+#ifndef OPTIONBATCH_HPP
+#define OPTIONBATCH_HPP
+
+#include <cstddef>
+#include <vector>
+
+template<typename Real_>
+class BasicOptionBatch {
+private:
+    std::vector<Real_> T;                       // Expiry time/maturity
+    std::vector<Real_> sig;                     // Volatility
+    std::vector<Real_> r;                       // Risk-free interest rate
+    std::vector<Real_> S;                       // Spot price
+    std::vector<Real_> K;                       // Strike price
+    std::vector<Real_> b;                       // Cost of carry
+
+public:
+    // Constructors and destructors
+    BasicOptionBatch();
+    BasicOptionBatch(const BasicOptionBatch& source);
+    BasicOptionBatch(BasicOptionBatch&& source) = default;
+    explicit BasicOptionBatch(std::size_t n);
+    explicit BasicOptionBatch(const std::vector<std::vector<double>>& matrix);
+    virtual ~BasicOptionBatch();
+
+    // Operator overloading
+    BasicOptionBatch& operator=(const BasicOptionBatch& source);
+    BasicOptionBatch& operator=(BasicOptionBatch&& source) = default;
+
+    // Capacity
+    std::size_t size() const;
+    void reserve(std::size_t n);
+    void resize(std::size_t n);
+    void clear();
+
+    // Append a single row of option data
+    void push_back(Real_ T_, Real_ sig_, Real_ r_, Real_ S_, Real_ K_, Real_ b_);
+
+    // Column accessors
+    const std::vector<Real_>& expiry() const;
+    const std::vector<Real_>& vol() const;
+    const std::vector<Real_>& riskFree() const;
+    const std::vector<Real_>& spot() const;
+    const std::vector<Real_>& strike() const;
+    const std::vector<Real_>& carry() const;
+
+    // Column mutators
+    std::vector<Real_>& expiry();
+    std::vector<Real_>& vol();
+    std::vector<Real_>& riskFree();
+    std::vector<Real_>& spot();
+    std::vector<Real_>& strike();
+    std::vector<Real_>& carry();
+};
+
+// Double precision columns are the default. Single precision columns halve the memory traffic of screening runs
+typedef BasicOptionBatch<double> OptionBatch;
+typedef BasicOptionBatch<float> FloatOptionBatch;
+
+#ifndef OPTIONBATCH_CPP
+#include "OptionBatch.cpp"
+
+#endif // OPTIONBATCH_CPP
+#endif // OPTIONBATCH_HPP
@@ -4,13 +4,16 @@
  * Created by Michael Lewis on 8/9/20.
  *********************************************************************************************************************/
 
+#include <algorithm>
 #include <chrono>
+#include <cstdint>
 #include <fstream>
 #include <ios>
 #include <iostream>
 #include <iomanip>
 #include <sstream>
 
+#include "Input.hpp"
 #include "Output.hpp"
 
 /**
@@ -100,4 +103,75 @@ void Output::csv(const std::vector<double>& meshPoints, const std::vector<std::v
     } else {
         std::cout << "Unable to open the file. Check filepath permissions\n";
     }
-}
\ No newline at end of file
+}
+
+/**
+ * Send option data to a binary columnar file that can be memory mapped by Input::binary
+ * @param path Path to the output file
+ * @param batch Option data (T, sig, r, S, K, b). Each column is written contiguously after the header
+ * @return True if the file was written. Otherwise false and a message is written to the console
+ */
+bool Output::binary(const std::string& path, const OptionBatch &batch) {
+
+    std::ofstream outFile(path, std::ios::binary);
+    if (!outFile.is_open()) {
+        std::cout << "Unable to open the file. Check filepath permissions\n";
+        return false;
+    }
+
+    std::uint64_t n = batch.size();
+    outFile.write(Input::magic, sizeof(Input::magic));
+    outFile.write(reinterpret_cast<const char*>(&n), sizeof(n));
+
+    const std::vector<double>* columns[6] = {&batch.expiry(), &batch.vol(), &batch.riskFree(), &batch.spot(),
+                                             &batch.strike(), &batch.carry()};
+    for (const auto* column : columns) {
+        outFile.write(reinterpret_cast<const char*>(column->data()), static_cast<std::streamsize>(n * sizeof(double)));
+    }
+
+    return static_cast<bool>(outFile);
+}
+
+/**
+ * Send single precision option data to a binary columnar file that can be memory mapped by Input::binary
+ * @note Columns are widened to double as they are written so that there is one file format for both precisions
+ * @param path Path to the output file
+ * @param batch Option data (T, sig, r, S, K, b). Each column is written contiguously after the header
+ * @return True if the file was written. Otherwise false and a message is written to the console
+ */
+bool Output::binary(const std::string& path, const FloatOptionBatch &batch) {
+
+    OptionBatch wide(batch.size());
+    std::vector<double>* targets[6] = {&wide.expiry(), &wide.vol(), &wide.riskFree(), &wide.spot(), &wide.strike(),
+                                       &wide.carry()};
+    const std::vector<float>* columns[6] = {&batch.expiry(), &batch.vol(), &batch.riskFree(), &batch.spot(),
+                                            &batch.strike(), &batch.carry()};
+    for (std::size_t j = 0; j < 6; ++j) {
+        std::copy(columns[j]->begin(), columns[j]->end(), targets[j]->begin());
+    }
+
+    return binary(path, wide);
+}
+
+/**
+ * Send a book of compact contract records to a binary file that can be memory mapped by Input::binary
+ * @note The records are written as one block after the header, in the in-memory layout of Contract
+ * @param path Path to the output file
+ * @param contracts Option parameters, one record per contract
+ * @return True if the file was written. Otherwise false and a message is written to the console
+ */
+bool Output::binary(const std::string& path, const std::vector<Contract> &contracts) {
+
+    std::ofstream outFile(path, std::ios::binary);
+    if (!outFile.is_open()) {
+        std::cout << "Unable to open the file. Check filepath permissions\n";
+        return false;
+    }
+
+    std::uint64_t n = contracts.size();
+    outFile.write(Input::contractMagic, sizeof(Input::contractMagic));
+    outFile.write(reinterpret_cast<const char*>(&n), sizeof(n));
+    outFile.write(reinterpret_cast<const char*>(contracts.data()), static_cast<std::streamsize>(n * sizeof(Contract)));
+
+    return static_cast<bool>(outFile);
+}
@@ -10,6 +10,10 @@
 #include <vector>
 #include <iostream>
 #include <fstream>
+#include <string>
+
+#include "Contract.hpp"
+#include "OptionBatch.hpp"
 
 class Output {
 
@@ -28,6 +32,9 @@ public:
     static void csv(const std::vector<double>& meshPoints, const std::vector<std::vector<double>>& prices);
     static void csv(const std::vector<double>& meshPoints, const std::vector<std::vector<double>>& prices,
              const std::vector<std::vector<double>>& deltas, const std::vector<double>& gammas);
+    static bool binary(const std::string& path, const OptionBatch& batch);
+    static bool binary(const std::string& path, const FloatOptionBatch& batch);
+    static bool binary(const std::string& path, const std::vector<Contract>& contracts);
 
 };
 
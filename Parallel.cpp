@@ -0,0 +1,104 @@
+/**********************************************************************************************************************
+ * Utility class that partitions a range of rows across hardware threads
+ *********************************************************************************************************************/
+
+#ifndef PARALLEL_CPP
+#define PARALLEL_CPP
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#include "Parallel.hpp"
+#include "Scheduler.hpp"
+
+/**
+ * Number of worker threads used to partition a range
+ * @return The hardware concurrency of this machine, or 1 if it cannot be determined
+ */
+inline std::size_t Parallel::threads() {
+    std::size_t n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+}
+
+/**
+ * Split [0, n) into one contiguous chunk per worker and invoke f(worker, first, last) for each chunk
+ * @note Worker indices are dense in [0, threads()) so callers can index per-worker accumulation buffers. An exception
+ * thrown by f on any worker is captured, every worker is joined, and the exception of the lowest worker is rethrown
+ * on the calling thread
+ * @tparam Function Callable with the signature void(std::size_t worker, std::size_t first, std::size_t last)
+ * @param n Number of rows
+ * @param f The function applied to each chunk
+ * @param grain Minimum number of rows per chunk. Ranges smaller than this run on the calling thread
+ */
+template<typename Function>
+void Parallel::forRange(std::size_t n, Function f, std::size_t grain) {
+
+    if (n == 0) { return; }
+
+    std::size_t workers = std::min(threads(), (n + grain - 1) / std::max<std::size_t>(grain, 1));
+    if (workers <= 1) {
+        f(0, 0, n);
+        return;
+    }
+
+    std::size_t chunk = (n + workers - 1) / workers;
+
+    // Each worker keeps its own copy of f and records its exception instead of letting it end the program
+    std::vector<std::exception_ptr> errors(workers);
+    auto run = [&errors](Function g, std::size_t worker, std::size_t first, std::size_t last) {
+        try {
+            g(worker, first, last);
+        } catch (...) {
+            errors[worker] = std::current_exception();
+        }
+    };
+
+    // Joins every started worker on the way out, including when a later worker cannot be started, since each one still
+    // refers to errors on this stack frame
+    std::vector<std::thread> pool;
+    struct Joiner {
+        std::vector<std::thread> &threads;
+        ~Joiner() {
+            for (auto &thread : threads) {
+                if (thread.joinable()) { thread.join(); }
+            }
+        }
+    } joiner{pool};
+
+    // The calling thread takes the first chunk
+    pool.reserve(workers - 1);
+    for (std::size_t w = 1; w < workers; ++w) {
+        std::size_t first = std::min(n, w * chunk);
+        std::size_t last = std::min(n, first + chunk);
+        pool.emplace_back(run, f, w, first, last);
+    }
+    run(f, 0, 0, std::min(n, chunk));
+
+    for (auto &thread : pool) {
+        thread.join();
+    }
+
+    for (const auto &error : errors) {
+        if (error) { std::rethrow_exception(error); }
+    }
+}
+
+/**
+ * Invoke f(worker, first, last) over ranges that cover [0, n) exactly once, balancing the load by work stealing
+ * @note Use this rather than forRange when the cost per row varies, e.g. books that mix closed form European rows with
+ * numerical American or Monte Carlo rows, where a static partition leaves one thread with all of the expensive rows.
+ * Worker indices are dense in [0, threads()). Use a Scheduler directly to read its per-worker utilization
+ * @tparam Function Callable with the signature void(std::size_t worker, std::size_t first, std::size_t last)
+ * @param n Number of rows
+ * @param f The function applied to each range
+ * @param grain Minimum number of rows per task
+ */
+template<typename Function>
+void Parallel::forDynamic(std::size_t n, Function f, std::size_t grain) {
+    Scheduler scheduler(threads());
+    scheduler.forRange(n, f, grain);
+}
+
+#endif
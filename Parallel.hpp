@@ -0,0 +1,29 @@
+/**********************************************************************************************************************
+ * Utility class that partitions a range of rows across hardware threads
+ *********************************************************************************************************************/
+
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <cstddef>
+
+class Parallel {
+private:
+public:
+    // Number of worker threads used to partition a range
+    static std::size_t threads();
+
+    // Split [0, n) into one contiguous chunk per worker and invoke f(worker, first, last) for each chunk
+    template<typename Function>
+    static void forRange(std::size_t n, Function f, std::size_t grain = 1024);
+
+    // Invoke f(worker, first, last) over [0, n) with work stealing, for rows whose cost varies, e.g. mixed books
+    template<typename Function>
+    static void forDynamic(std::size_t n, Function f, std::size_t grain = 1);
+};
+
+#ifndef PARALLEL_CPP
+#include "Parallel.cpp"
+
+#endif // PARALLEL_CPP
+#endif // PARALLEL_HPP
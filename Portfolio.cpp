@@ -0,0 +1,171 @@
+/**********************************************************************************************************************
+ * A book of option positions stored as a structure of arrays
+ *********************************************************************************************************************/
+
+#include "Portfolio.hpp"
+
+/**
+ * Initialize a new empty Portfolio
+ * @throws OutOfMemoryError Indicates insufficient memory for this new Portfolio
+ */
+Portfolio::Portfolio() : contracts(), quantities(), types(), styles(), underlyingIds(), underlyingNames(),
+underlyingIndex() {}
+
+/**
+ * Initialize a deep copy of the source Portfolio
+ * @param source A Portfolio whose positions will be deeply copied
+ * @throws OutOfMemoryError Indicates insufficient memory for this new Portfolio
+ */
+Portfolio::Portfolio(const Portfolio &source) : contracts(source.contracts), quantities(source.quantities),
+types(source.types), styles(source.styles), underlyingIds(source.underlyingIds),
+underlyingNames(source.underlyingNames), underlyingIndex(source.underlyingIndex) {}
+
+/**
+ * Destroy this Portfolio
+ */
+Portfolio::~Portfolio() {}
+
+/**
+ * Deeply copy the source
+ * @param source A Portfolio whose positions will be deeply copied
+ * @return This Portfolio whose positions are now a deep copy of the source positions
+ */
+Portfolio & Portfolio::operator=(const Portfolio &source) {
+    // Avoid self assign
+    if (this == &source) { return *this; }
+
+    contracts = source.contracts;
+    quantities = source.quantities;
+    types = source.types;
+    styles = source.styles;
+    underlyingIds = source.underlyingIds;
+    underlyingNames = source.underlyingNames;
+    underlyingIndex = source.underlyingIndex;
+
+    return *this;
+}
+
+/**
+ * Number of positions in this Portfolio
+ * @return The number of positions
+ */
+std::size_t Portfolio::size() const { return quantities.size(); }
+
+/**
+ * Reserve capacity for n positions in every column
+ * @param n Number of positions
+ */
+void Portfolio::reserve(std::size_t n) {
+    contracts.reserve(n);
+    quantities.reserve(n);
+    types.reserve(n);
+    styles.reserve(n);
+    underlyingIds.reserve(n);
+}
+
+/**
+ * Remove every position and underlying from this Portfolio
+ */
+void Portfolio::clear() {
+    contracts.clear();
+    quantities.clear();
+    types.clear();
+    styles.clear();
+    underlyingIds.clear();
+    underlyingNames.clear();
+    underlyingIndex.clear();
+}
+
+/**
+ * Add a position to the book
+ * @param underlying Name of the underlying. New names are assigned the next underlying index
+ * @param T_ Expiry. Ignored for perpetual American options
+ * @param sig_ Volatility
+ * @param r_ Risk-free rate
+ * @param S_ Spot price
+ * @param K_ Strike price
+ * @param b_ Cost of carry
+ * @param quantity Signed number of contracts. Negative quantities are short positions
+ * @param type Call or Put
+ * @param style European or perpetual American
+ */
+void Portfolio::add(const std::string &underlying, double T_, double sig_, double r_, double S_, double K_,
+        double b_, double quantity, OptionType type, ExerciseStyle style) {
+    contracts.push_back(T_, sig_, r_, S_, K_, b_);
+    quantities.push_back(quantity);
+    types.push_back(type);
+    styles.push_back(style);
+    underlyingIds.push_back(this->underlying(underlying));
+}
+
+/**
+ * Number of distinct underlyings in this Portfolio
+ * @return The number of underlyings
+ */
+std::size_t Portfolio::underlyings() const { return underlyingNames.size(); }
+
+/**
+ * Find or register an underlying
+ * @param name Name of the underlying
+ * @return The index of the underlying
+ */
+std::size_t Portfolio::underlying(const std::string &name) {
+    auto it = underlyingIndex.find(name);
+    if (it != underlyingIndex.end()) { return it->second; }
+
+    std::size_t id = underlyingNames.size();
+    underlyingNames.push_back(name);
+    underlyingIndex.emplace(name, id);
+
+    return id;
+}
+
+/**
+ * Name of an underlying
+ * @param id Index of the underlying
+ * @return The name the underlying was registered with
+ */
+const std::string& Portfolio::underlyingName(std::size_t id) const { return underlyingNames[id]; }
+
+/* ********************************************************************************************************************
+ * Accessors
+ *********************************************************************************************************************/
+
+/**
+ * @return The contract parameters of every position
+ */
+const OptionBatch& Portfolio::options() const { return contracts; }
+
+/**
+ * @return The column of signed quantities
+ */
+const std::vector<double>& Portfolio::quantity() const { return quantities; }
+
+/**
+ * @return The column of option types
+ */
+const std::vector<Portfolio::OptionType>& Portfolio::type() const { return types; }
+
+/**
+ * @return The column of exercise styles
+ */
+const std::vector<Portfolio::ExerciseStyle>& Portfolio::style() const { return styles; }
+
+/**
+ * @return The column of underlying indices
+ */
+const std::vector<std::size_t>& Portfolio::underlying() const { return underlyingIds; }
+
+/* ********************************************************************************************************************
+ * Mutators
+ *********************************************************************************************************************/
+
+/**
+ * @return A mutable reference to the contract parameters of every position
+ */
+OptionBatch& Portfolio::options() { return contracts; }
+
+/**
+ * @return A mutable reference to the column of signed quantities
+ */
+std::vector<double>& Portfolio::quantity() { return quantities; }
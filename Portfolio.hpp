@@ -0,0 +1,68 @@
+/**********************************************************************************************************************
+ * A book of option positions stored as a structure of arrays
+ *
+ * @note Contract parameters live in an OptionBatch. Quantity, option type, exercise style, and underlying are parallel
+ * columns so an engine can stream through one property for every position
+ *********************************************************************************************************************/
+
+#ifndef PORTFOLIO_HPP
+#define PORTFOLIO_HPP
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "OptionBatch.hpp"
+
+class Portfolio {
+public:
+    enum class OptionType : unsigned char { Call, Put };
+    enum class ExerciseStyle : unsigned char { European, American };
+
+private:
+    OptionBatch contracts;                                        // T, sig, r, S, K, b for every position
+    std::vector<double> quantities;                               // Signed number of contracts held
+    std::vector<OptionType> types;                                // Call or Put
+    std::vector<ExerciseStyle> styles;                            // European or perpetual American
+    std::vector<std::size_t> underlyingIds;                       // Index into underlyingNames
+
+    std::vector<std::string> underlyingNames;                     // Distinct underlyings in insertion order
+    std::unordered_map<std::string, std::size_t> underlyingIndex; // Name to index lookup
+
+public:
+    // Constructors and destructors
+    Portfolio();
+    Portfolio(const Portfolio& source);
+    virtual ~Portfolio();
+
+    // Operator overloading
+    Portfolio& operator=(const Portfolio& source);
+
+    // Capacity
+    std::size_t size() const;
+    void reserve(std::size_t n);
+    void clear();
+
+    // Add a position to the book
+    void add(const std::string& underlying, double T_, double sig_, double r_, double S_, double K_, double b_,
+             double quantity, OptionType type, ExerciseStyle style);
+
+    // Underlyings
+    std::size_t underlyings() const;
+    std::size_t underlying(const std::string& name);
+    const std::string& underlyingName(std::size_t id) const;
+
+    // Column accessors
+    const OptionBatch& options() const;
+    const std::vector<double>& quantity() const;
+    const std::vector<OptionType>& type() const;
+    const std::vector<ExerciseStyle>& style() const;
+    const std::vector<std::size_t>& underlying() const;
+
+    // Column mutators
+    OptionBatch& options();
+    std::vector<double>& quantity();
+};
+
+#endif // PORTFOLIO_HPP
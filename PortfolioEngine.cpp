@@ -0,0 +1,264 @@
+/**********************************************************************************************************************
+ * Prices a Portfolio and aggregates PV, Delta, Gamma, and Vega by underlying
+ *********************************************************************************************************************/
+
+#ifndef PORTFOLIOENGINE_CPP
+#define PORTFOLIOENGINE_CPP
+
+#include "PortfolioEngine.hpp"
+#include "Parallel.hpp"
+
+/**
+ * Initialize a new PortfolioEngine with default difference parameters for American Greeks
+ * @tparam European_ Pricing engine for European positions (e.g. EuropeanOption<Mesher, Matrix, RNG, Output>)
+ * @tparam American_ Pricing engine for perpetual American positions (e.g. AmericanOption<Mesher, Matrix, Output>)
+ * @throws OutOfMemoryError Indicates insufficient memory for this new PortfolioEngine
+ */
+template<typename European_, typename American_>
+PortfolioEngine<European_, American_>::PortfolioEngine() : h(0.01), hSig(0.0001) {}
+
+/**
+ * Initialize a new PortfolioEngine whose data members are a deep copy of the source
+ * @tparam European_ Pricing engine for European positions (e.g. EuropeanOption<Mesher, Matrix, RNG, Output>)
+ * @tparam American_ Pricing engine for perpetual American positions (e.g. AmericanOption<Mesher, Matrix, Output>)
+ * @param source A PortfolioEngine whose data members will be deeply copied
+ * @throws OutOfMemoryError Indicates insufficient memory for this new PortfolioEngine
+ */
+template<typename European_, typename American_>
+PortfolioEngine<European_, American_>::PortfolioEngine(const PortfolioEngine<European_, American_> &source) :
+h(source.h), hSig(source.hSig) {}
+
+/**
+ * Initialize a new PortfolioEngine with the specified difference parameters for American Greeks
+ * @tparam European_ Pricing engine for European positions (e.g. EuropeanOption<Mesher, Matrix, RNG, Output>)
+ * @tparam American_ Pricing engine for perpetual American positions (e.g. AmericanOption<Mesher, Matrix, Output>)
+ * @param h_ Spot difference parameter
+ * @param hSig_ Volatility difference parameter
+ * @throws OutOfMemoryError Indicates insufficient memory for this new PortfolioEngine
+ */
+template<typename European_, typename American_>
+PortfolioEngine<European_, American_>::PortfolioEngine(double h_, double hSig_) : h(h_), hSig(hSig_) {}
+
+/**
+ * Destroy this PortfolioEngine
+ * @tparam European_ Pricing engine for European positions
+ * @tparam American_ Pricing engine for perpetual American positions
+ */
+template<typename European_, typename American_>
+PortfolioEngine<European_, American_>::~PortfolioEngine() {}
+
+/**
+ * Deeply copy the source data members into this PortfolioEngine
+ * @tparam European_ Pricing engine for European positions
+ * @tparam American_ Pricing engine for perpetual American positions
+ * @param source A PortfolioEngine whose data members will be deeply copied
+ * @return This PortfolioEngine whose data members are a deep copy of the source data members
+ */
+template<typename European_, typename American_>
+PortfolioEngine<European_, American_>&
+PortfolioEngine<European_, American_>::operator=(const PortfolioEngine<European_, American_> &source) {
+    // Avoid self assign
+    if (this == &source) { return *this; }
+
+    h = source.h;
+    hSig = source.hSig;
+
+    return *this;
+}
+
+/* ********************************************************************************************************************
+ * Core risk functions
+ *********************************************************************************************************************/
+
+/**
+ * Unit PV, Delta, Gamma, and Vega of a single position
+ * @note European Greeks use the closed form solutions. Perpetual American Greeks use divided differences because the
+ * American engine only provides prices
+ * @tparam European_ Pricing engine for European positions
+ * @tparam American_ Pricing engine for perpetual American positions
+ * @param portfolio The book that holds the position
+ * @param i Index of the position
+ * @param h_ Spot difference parameter for American Greeks
+ * @param hSig_ Volatility difference parameter for American Vega
+ * @param pv Receives the price of one contract
+ * @param delta Receives the Delta of one contract
+ * @param gamma Receives the Gamma of one contract
+ * @param vega Receives the Vega of one contract
+ */
+template<typename European_, typename American_>
+void PortfolioEngine<European_, American_>::risk(const Portfolio &portfolio, std::size_t i, double h_, double hSig_,
+        double &pv, double &delta, double &gamma, double &vega) {
+
+    const OptionBatch &options = portfolio.options();
+    double T = options.expiry()[i], sig = options.vol()[i], r = options.riskFree()[i];
+    double S = options.spot()[i], K = options.strike()[i], b = options.carry()[i];
+    bool isCall = portfolio.type()[i] == Portfolio::OptionType::Call;
+
+    double call, put;
+    if (portfolio.style()[i] == Portfolio::ExerciseStyle::European) {
+        double callDelta, putDelta;
+        European_::price(T, sig, r, S, K, b, call, put);
+        European_::delta(T, sig, r, S, K, b, callDelta, putDelta);
+
+        pv = isCall ? call : put;
+        delta = isCall ? callDelta : putDelta;
+        gamma = European_::gamma(T, sig, r, S, K, b);
+        vega = European_::vega(T, sig, r, S, K, b);
+    } else {
+        double upCall, upPut, downCall, downPut;
+        American_::price(sig, r, S, K, b, call, put);
+        American_::price(sig, r, S + h_, K, b, upCall, upPut);
+        American_::price(sig, r, S - h_, K, b, downCall, downPut);
+
+        double up = isCall ? upCall : upPut;
+        double down = isCall ? downCall : downPut;
+        pv = isCall ? call : put;
+
+        // Divided differences method
+        delta = (up - down) / (2 * h_);
+        gamma = (up - 2 * pv + down) / (h_ * h_);
+
+        American_::price(sig + hSig_, r, S, K, b, upCall, upPut);
+        American_::price(sig - hSig_, r, S, K, b, downCall, downPut);
+        vega = isCall ? (upCall - downCall) / (2 * hSig_) : (upPut - downPut) / (2 * hSig_);
+    }
+}
+
+/**
+ * Quantity weighted PV, Delta, Gamma, and Vega by underlying
+ * @note Each call runs on its own Scheduler, so concurrent calls on one engine share no state
+ * @tparam European_ Pricing engine for European positions
+ * @tparam American_ Pricing engine for perpetual American positions
+ * @param portfolio The book to price
+ * @return A matrix with one row per underlying. Each row has PV, Delta, Gamma, and Vega
+ */
+template<typename European_, typename American_>
+std::vector<std::vector<double>>
+PortfolioEngine<European_, American_>::risk(const Portfolio &portfolio) const {
+    Scheduler scheduler(Parallel::threads());
+    return risk(portfolio, scheduler);
+}
+
+/**
+ * Quantity weighted PV, Delta, Gamma, and Vega by underlying on a caller's Scheduler
+ * @note Positions are shared across threads by work stealing, so a cluster of American positions does not leave one
+ * thread with the long tail. Each thread accumulates into its own buffer and the buffers are combined once every
+ * thread has finished. The Scheduler is left holding the utilization of this run
+ * @tparam European_ Pricing engine for European positions
+ * @tparam American_ Pricing engine for perpetual American positions
+ * @param portfolio The book to price
+ * @param scheduler Work-stealing scheduler that runs the positions. Receives the tasks, steals, rows, and busy time
+ * of every worker
+ * @return A matrix with one row per underlying. Each row has PV, Delta, Gamma, and Vega
+ */
+template<typename European_, typename American_>
+std::vector<std::vector<double>>
+PortfolioEngine<European_, American_>::risk(const Portfolio &portfolio, Scheduler &scheduler) const {
+
+    std::size_t m = portfolio.underlyings();
+    std::size_t workers = scheduler.threads();
+
+    // One accumulation buffer per worker. Each underlying has four consecutive slots. The stride is rounded up to whole
+    // cache lines plus one spare line, so the buffers of two workers never share a line whatever the base alignment
+    const std::size_t line = 64 / sizeof(double);
+    std::size_t stride = (4 * m + line - 1) / line * line + line;
+    std::vector<double> partials(workers * stride, 0.0);
+
+    const std::vector<double> &quantity = portfolio.quantity();
+    const std::vector<std::size_t> &underlying = portfolio.underlying();
+    double h_ = h, hSig_ = hSig;
+
+    scheduler.forRange(portfolio.size(), [&](std::size_t worker, std::size_t first, std::size_t last) {
+        double *acc = partials.data() + worker * stride;
+        double pv, delta, gamma, vega;
+        for (std::size_t i = first; i < last; ++i) {
+            risk(portfolio, i, h_, hSig_, pv, delta, gamma, vega);
+
+            double q = quantity[i];
+            double *slot = acc + 4 * underlying[i];
+            slot[0] += q * pv;
+            slot[1] += q * delta;
+            slot[2] += q * gamma;
+            slot[3] += q * vega;
+        }
+    });
+
+    // Combine the per-worker buffers into one row per underlying
+    std::vector<std::vector<double>> result(m, std::vector<double>(4, 0.0));
+    for (std::size_t w = 0; w < workers; ++w) {
+        const double *partial = partials.data() + w * stride;
+        for (std::size_t u = 0; u < m; ++u) {
+            for (std::size_t k = 0; k < 4; ++k) {
+                result[u][k] += partial[4 * u + k];
+            }
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Quantity weighted PV, Delta, Gamma, and Vega across the whole book
+ * @tparam European_ Pricing engine for European positions
+ * @tparam American_ Pricing engine for perpetual American positions
+ * @param portfolio The book to price
+ * @return PV, Delta, Gamma, and Vega summed over every underlying
+ */
+template<typename European_, typename American_>
+std::vector<double> PortfolioEngine<European_, American_>::total(const Portfolio &portfolio) const {
+
+    std::vector<double> result(4, 0.0);
+    for (const auto &row : risk(portfolio)) {
+        for (std::size_t k = 0; k < 4; ++k) {
+            result[k] += row[k];
+        }
+    }
+
+    return result;
+}
+
+/* ********************************************************************************************************************
+ * Accessors
+ *********************************************************************************************************************/
+
+/**
+ * Accessor that retrieves the spot difference parameter used for American Greeks
+ * @tparam European_ Pricing engine for European positions
+ * @tparam American_ Pricing engine for perpetual American positions
+ * @return Spot difference parameter
+ */
+template<typename European_, typename American_>
+double PortfolioEngine<European_, American_>::spotDifference() const { return h; }
+
+/**
+ * Accessor that retrieves the volatility difference parameter used for American Vega
+ * @tparam European_ Pricing engine for European positions
+ * @tparam American_ Pricing engine for perpetual American positions
+ * @return Volatility difference parameter
+ */
+template<typename European_, typename American_>
+double PortfolioEngine<European_, American_>::volDifference() const { return hSig; }
+
+/* ********************************************************************************************************************
+ * Mutators
+ *********************************************************************************************************************/
+
+/**
+ * Mutator that sets the spot difference parameter used for American Greeks
+ * @tparam European_ Pricing engine for European positions
+ * @tparam American_ Pricing engine for perpetual American positions
+ * @param h_ Spot difference parameter
+ */
+template<typename European_, typename American_>
+void PortfolioEngine<European_, American_>::spotDifference(double h_) { h = h_; }
+
+/**
+ * Mutator that sets the volatility difference parameter used for American Vega
+ * @tparam European_ Pricing engine for European positions
+ * @tparam American_ Pricing engine for perpetual American positions
+ * @param hSig_ Volatility difference parameter
+ */
+template<typename European_, typename American_>
+void PortfolioEngine<European_, American_>::volDifference(double hSig_) { hSig = hSig_; }
+
+#endif
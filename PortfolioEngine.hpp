@@ -0,0 +1,58 @@
+/**********************************************************************************************************************
+ * Prices a Portfolio and aggregates PV, Delta, Gamma, and Vega by underlying
+ *
+ * @note A host class for the European and American pricing engines. Positions are shared across threads by a
+ * work-stealing Scheduler, since American positions cost several prices each, and each thread reduces into its own
+ * accumulation buffer before the buffers are combined
+ *********************************************************************************************************************/
+
+#ifndef PORTFOLIOENGINE_HPP
+#define PORTFOLIOENGINE_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "Portfolio.hpp"
+#include "Scheduler.hpp"
+
+template<typename European_, typename American_>
+class PortfolioEngine {
+private:
+    double h;                                    // Spot difference parameter for American Greeks
+    double hSig;                                 // Volatility difference parameter for American Vega
+
+public:
+    // Constructors and destructors
+    PortfolioEngine();
+    PortfolioEngine(const PortfolioEngine& source);
+    PortfolioEngine(double h_, double hSig_);
+    virtual ~PortfolioEngine();
+
+    // Operator overloading
+    PortfolioEngine& operator=(const PortfolioEngine& source);
+
+    // Unit PV, Delta, Gamma, and Vega of a single position
+    static void risk(const Portfolio& portfolio, std::size_t i, double h_, double hSig_, double& pv, double& delta,
+                     double& gamma, double& vega);
+
+    // Quantity weighted PV, Delta, Gamma, and Vega by underlying. One row per underlying
+    std::vector<std::vector<double>> risk(const Portfolio& portfolio) const;
+    std::vector<std::vector<double>> risk(const Portfolio& portfolio, Scheduler& scheduler) const;
+
+    // Quantity weighted PV, Delta, Gamma, and Vega across the whole book
+    std::vector<double> total(const Portfolio& portfolio) const;
+
+    // Accessors
+    double spotDifference() const;
+    double volDifference() const;
+
+    // Mutators
+    void spotDifference(double h_);
+    void volDifference(double hSig_);
+};
+
+#ifndef PORTFOLIOENGINE_CPP
+#include "PortfolioEngine.cpp"
+
+#endif // PORTFOLIOENGINE_CPP
+#endif // PORTFOLIOENGINE_HPP
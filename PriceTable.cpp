@@ -0,0 +1,420 @@
+/**********************************************************************************************************************
+ * Precomputed spot by volatility table of European prices and Greeks with bicubic Hermite interpolation
+ *********************************************************************************************************************/
+
+#ifndef PRICETABLE_CPP
+#define PRICETABLE_CPP
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "PriceTable.hpp"
+
+namespace {
+    // Monomial coefficients of the cubic Hermite basis h00, h10, h01, h11 on [0, 1]
+    const double hermiteBasis[4][4] = {{1.0, 0.0, -3.0, 2.0},
+                                       {0.0, 1.0, -2.0, 1.0},
+                                       {0.0, 0.0, 3.0, -2.0},
+                                       {0.0, 0.0, -1.0, 1.0}};
+
+    // A term c z^k / tau^m of a derivative of the Call price, where z = d1 and tau = sig sqrt(T)
+    struct Term {
+        double c;
+        int k;
+        int m;
+    };
+
+    // d4C/dS4 = carry n(d1) / S^3 * sum
+    const Term spot4[] = {{2.0, 0, 1}, {3.0, 1, 2}, {-1.0, 0, 3}, {1.0, 2, 3}};
+
+    // d4C/dtau4 = carry S n(d1) * sum
+    const Term vol4[] = {{3.0, 1, 0}, {-1.0, 3, 0}, {3.0, 0, 1}, {-12.0, 2, 1}, {3.0, 4, 1}, {-12.0, 1, 2},
+                         {18.0, 3, 2}, {-3.0, 5, 2}, {12.0, 2, 3}, {-9.0, 4, 3}, {1.0, 6, 3}};
+
+    // d5C/dS dtau4 = carry n(d1) * sum
+    const Term cross4[] = {{3.0, 1, 0}, {-1.0, 3, 0}, {6.0, 0, 1}, {-18.0, 2, 1}, {4.0, 4, 1}, {-39.0, 1, 2},
+                           {42.0, 3, 2}, {-6.0, 5, 2}, {-12.0, 0, 3}, {78.0, 2, 3}, {-42.0, 4, 3}, {4.0, 6, 3},
+                           {24.0, 1, 4}, {-48.0, 3, 4}, {15.0, 5, 4}, {-1.0, 7, 4}};
+
+    /*
+     * Largest value of n(z) |z|^k for z in [zLo, zHi]. The function peaks at |z| = sqrt(k) and falls away from it
+     */
+    double peak(int k, double zLo, double zHi) {
+        auto f = [k](double z) { return std::exp(-0.5 * z * z) * std::pow(std::abs(z), k) * 0.3989422804014327; };
+
+        double result = std::max(f(zLo), f(zHi));
+        double top = std::sqrt(static_cast<double>(k));
+        if (zLo <= top && top <= zHi) { result = std::max(result, f(top)); }
+        if (zLo <= -top && -top <= zHi) { result = std::max(result, f(-top)); }
+        return result;
+    }
+
+    /*
+     * Bound |n(z) sum of c z^k / tau^m| over z in [zLo, zHi] and tau >= tauLo term by term
+     */
+    template<std::size_t n>
+    double sup(const Term (&terms)[n], double zLo, double zHi, double tauLo) {
+        double result = 0.0;
+        for (const Term &term : terms) {
+            result += std::abs(term.c) * peak(term.k, zLo, zHi) / std::pow(tauLo, term.m);
+        }
+        return result;
+    }
+}
+
+/**
+ * Initialize an empty PriceTable. Every lookup falls back to the exact pricer
+ * @tparam European_ Pricing engine (e.g. EuropeanOption<Mesher, Matrix, RNG, Output>)
+ * @throws OutOfMemoryError Indicates insufficient memory for this new PriceTable
+ */
+template<typename European_>
+PriceTable<European_>::PriceTable() : T(0.25), r(0.08), K(65.0), b(0.08), S0(0.0), hS(1.0), invHS(1.0), sig0(0.0),
+hSig(1.0), invHSig(1.0), nS(0), nSig(0), carry(1.0), discount(0.0), coefficients(), maxError(0.0) {}
+
+/**
+ * Initialize a new PriceTable whose data members are a deep copy of the source
+ * @tparam European_ Pricing engine (e.g. EuropeanOption<Mesher, Matrix, RNG, Output>)
+ * @param source A PriceTable whose data members will be deeply copied
+ * @throws OutOfMemoryError Indicates insufficient memory for this new PriceTable
+ */
+template<typename European_>
+PriceTable<European_>::PriceTable(const PriceTable<European_> &source) : T(source.T), r(source.r), K(source.K),
+b(source.b), S0(source.S0), hS(source.hS), invHS(source.invHS), sig0(source.sig0), hSig(source.hSig),
+invHSig(source.invHSig), nS(source.nS), nSig(source.nSig), carry(source.carry), discount(source.discount),
+coefficients(source.coefficients), maxError(source.maxError) {}
+
+/**
+ * Initialize a new PriceTable and precompute every cell on a spot by volatility mesh
+ * @tparam European_ Pricing engine (e.g. EuropeanOption<Mesher, Matrix, RNG, Output>)
+ * @param T_ Expiry
+ * @param r_ Risk-free interest rate
+ * @param K_ Strike price
+ * @param b_ Cost of carry
+ * @param sStart First spot node
+ * @param sStop Last spot node
+ * @param sStep Spot step
+ * @param sigStart First volatility node
+ * @param sigStop Last volatility node
+ * @param sigStep Volatility step
+ * @throws OutOfMemoryError Indicates insufficient memory for this new PriceTable
+ */
+template<typename European_>
+PriceTable<European_>::PriceTable(double T_, double r_, double K_, double b_, double sStart, double sStop,
+        double sStep, double sigStart, double sigStop, double sigStep) : T(T_), r(r_), K(K_), b(b_), S0(0.0),
+        hS(1.0), invHS(1.0), sig0(0.0), hSig(1.0), invHSig(1.0), nS(0), nSig(0), carry(std::exp((b_ - r_) * T_)),
+        discount(K_ * std::exp(-r_ * T_)), coefficients(), maxError(0.0) {
+    European_ engine;
+    build(engine.xarr(sStart, sStop, sStep), engine.xarr(sigStart, sigStop, sigStep), sStep, sigStep);
+}
+
+/**
+ * Destroy this PriceTable
+ * @tparam European_ Pricing engine
+ */
+template<typename European_>
+PriceTable<European_>::~PriceTable() {}
+
+/**
+ * Deeply copy the source data members into this PriceTable
+ * @tparam European_ Pricing engine
+ * @param source A PriceTable whose data members will be deeply copied
+ * @return This PriceTable whose data members are a deep copy of the source data members
+ */
+template<typename European_>
+PriceTable<European_>& PriceTable<European_>::operator=(const PriceTable<European_> &source) {
+    // Avoid self assign
+    if (this == &source) { return *this; }
+
+    T = source.T;
+    r = source.r;
+    K = source.K;
+    b = source.b;
+    S0 = source.S0;
+    hS = source.hS;
+    invHS = source.invHS;
+    sig0 = source.sig0;
+    hSig = source.hSig;
+    invHSig = source.invHSig;
+    nS = source.nS;
+    nSig = source.nSig;
+    carry = source.carry;
+    discount = source.discount;
+    coefficients = source.coefficients;
+    maxError = source.maxError;
+
+    return *this;
+}
+
+/* ********************************************************************************************************************
+ * Construction
+ *********************************************************************************************************************/
+
+/*
+ * Precompute the bicubic Hermite coefficients of every cell
+ * @note Each node holds the exact Call price, Delta, Vega, and the cross derivative d(Delta)/d(sig), which is
+ * -carry n(d1) d2 / sig. Exact node data is what lets bound() turn the Hermite remainder into a guarantee. The node data
+ * is scaled to unit cell coordinates and converted to monomial coefficients once, here, so lookups never touch the
+ * Hermite basis. The meshes fix the first node and the number of nodes on each axis. Node i sits at S0 + i hS, the
+ * position a lookup assumes, rather than at the mesh point, which carries the rounding accumulated by the Mesher
+ * @tparam European_ Pricing engine
+ * @param spots Uniform spot mesh
+ * @param vols Uniform volatility mesh
+ * @param sStep Spacing of the spot mesh
+ * @param sigStep Spacing of the volatility mesh
+ */
+template<typename European_>
+void PriceTable<European_>::build(const std::vector<double> &spots, const std::vector<double> &vols, double sStep,
+                                  double sigStep) {
+
+    nS = spots.size();
+    nSig = vols.size();
+    coefficients.clear();
+    maxError = 0.0;
+    if (nS < 2 || nSig < 2) { return; }
+
+    S0 = spots.front();
+    hS = sStep;
+    invHS = 1.0 / hS;
+    sig0 = vols.front();
+    hSig = sigStep;
+    invHSig = 1.0 / hSig;
+
+    // Node data in unit cell coordinates: value, d/du, d/dv, d2/dudv
+    std::vector<double> value(nS * nSig), du(nS * nSig), dv(nS * nSig), duv(nS * nSig);
+    double rootT = std::sqrt(T);
+    for (std::size_t i = 0; i < nS; ++i) {
+        for (std::size_t j = 0; j < nSig; ++j) {
+            double S = S0 + static_cast<double>(i) * hS, sig = sig0 + static_cast<double>(j) * hSig;
+            double put, callDelta, putDelta;
+            std::size_t k = i * nSig + j;
+
+            European_::price(T, sig, r, S, K, b, value[k], put);
+            European_::delta(T, sig, r, S, K, b, callDelta, putDelta);
+
+            double d1 = (std::log(S / K) + (b + 0.5 * sig * sig) * T) / (sig * rootT), d2 = d1 - sig * rootT;
+            double vanna = -carry * std::exp(-0.5 * d1 * d1) * 0.3989422804014327 * d2 / sig;
+
+            du[k] = callDelta * hS;
+            dv[k] = European_::vega(T, sig, r, S, K, b) * hSig;
+            duv[k] = vanna * hS * hSig;
+        }
+    }
+
+    coefficients.resize(16 * (nS - 1) * (nSig - 1));
+    for (std::size_t i = 0; i + 1 < nS; ++i) {
+        for (std::size_t j = 0; j + 1 < nSig; ++j) {
+            std::size_t k00 = i * nSig + j, k01 = k00 + 1, k10 = k00 + nSig, k11 = k10 + 1;
+
+            // Rows follow the basis in u (value at 0, slope at 0, value at 1, slope at 1), columns the basis in v
+            double G[4][4] = {{value[k00], dv[k00], value[k01], dv[k01]},
+                              {du[k00], duv[k00], du[k01], duv[k01]},
+                              {value[k10], dv[k10], value[k11], dv[k11]},
+                              {du[k10], duv[k10], du[k11], duv[k11]}};
+
+            double *c = coefficients.data() + 16 * (i * (nSig - 1) + j);
+            for (int a = 0; a < 4; ++a) {
+                for (int e = 0; e < 4; ++e) {
+                    double sum = 0.0;
+                    for (int p = 0; p < 4; ++p) {
+                        for (int q = 0; q < 4; ++q) {
+                            sum += hermiteBasis[p][a] * hermiteBasis[q][e] * G[p][q];
+                        }
+                    }
+                    c[4 * a + e] = sum;
+                }
+            }
+        }
+    }
+
+    bound();
+}
+
+/*
+ * Bound the largest Call price error of the table over every cell
+ * @note With exact node data the cubic Hermite remainder along one axis is at most h^4 / 384 times the largest fourth
+ * derivative on the cell. Writing the bicubic error as E_S C + H_S E_sig C, and bounding the Hermite interpolant in S
+ * by the largest value plus h_S / 4 times the largest S derivative of what it interpolates, gives
+ *     h_S^4 / 384 max|d4C/dS4| + h_sig^4 / 384 (max|d4C/dsig4| + h_S / 4 max|d5C/dS dsig4|)
+ * Each derivative is n(d1) times a polynomial in d1 and 1 / (sig sqrt(T)), bounded term by term from the range of
+ * d1 on the cell. The result holds up to floating point rounding. Put errors are identical because Puts are derived
+ * by parity
+ * @tparam European_ Pricing engine
+ */
+template<typename European_>
+void PriceTable<European_>::bound() {
+
+    maxError = 0.0;
+    if (!(S0 > 0.0 && sig0 > 0.0 && T > 0.0)) {
+        maxError = std::numeric_limits<double>::infinity();
+        return;
+    }
+
+    double rootT = std::sqrt(T), bT = b * T;
+    double hS4 = hS * hS * hS * hS, hSig4 = hSig * hSig * hSig * hSig;
+
+    // d1 = a / tau + tau / 2 rises with S. In tau it is monotone or convex with its minimum at sqrt(2a)
+    auto d1 = [](double a, double tau) { return a / tau + 0.5 * tau; };
+
+    for (std::size_t i = 0; i + 1 < nS; ++i) {
+        double sLo = S0 + static_cast<double>(i) * hS, sHi = sLo + hS;
+        double aLo = std::log(sLo / K) + bT, aHi = std::log(sHi / K) + bT;
+
+        for (std::size_t j = 0; j + 1 < nSig; ++j) {
+            double tauLo = (sig0 + static_cast<double>(j) * hSig) * rootT, tauHi = tauLo + hSig * rootT;
+
+            double zHi = std::max(d1(aHi, tauLo), d1(aHi, tauHi));
+            double zLo = std::min(d1(aLo, tauLo), d1(aLo, tauHi));
+            if (aLo > 0.0 && tauLo * tauLo < 2.0 * aLo && 2.0 * aLo < tauHi * tauHi) {
+                zLo = std::min(zLo, d1(aLo, std::sqrt(2.0 * aLo)));
+            }
+
+            double spot = carry / (sLo * sLo * sLo) * sup(spot4, zLo, zHi, tauLo);
+            double vol = T * T * carry * sHi * sup(vol4, zLo, zHi, tauLo);
+            double cross = T * T * carry * sup(cross4, zLo, zHi, tauLo);
+
+            double cell = (hS4 * spot + hSig4 * (vol + 0.25 * hS * cross)) / 384.0;
+            maxError = std::max(maxError, cell);
+        }
+    }
+}
+
+/**
+ * Halve the spot and volatility steps and rebuild the table until the error bound is within tolerance
+ * @tparam European_ Pricing engine
+ * @param tolerance Largest acceptable absolute Call price error anywhere in the table
+ * @param maxRefinements Largest number of times the grid is halved
+ * @return True if the error bound is within tolerance. Otherwise false and the finest table is kept
+ */
+template<typename European_>
+bool PriceTable<European_>::refine(double tolerance, int maxRefinements) {
+
+    if (nS < 2 || nSig < 2) { return false; }
+
+    European_ engine;
+    for (int n = 0; maxError > tolerance && n < maxRefinements; ++n) {
+        double sStop = S0 + static_cast<double>(nS - 1) * hS;
+        double sigStop = sig0 + static_cast<double>(nSig - 1) * hSig;
+        build(engine.xarr(S0, sStop, 0.5 * hS), engine.xarr(sig0, sigStop, 0.5 * hSig), 0.5 * hS, 0.5 * hSig);
+    }
+
+    return maxError <= tolerance;
+}
+
+/* ********************************************************************************************************************
+ * Lookups
+ *********************************************************************************************************************/
+
+/*
+ * Evaluate the Call patch that contains a point together with its first and second spot derivatives
+ * @tparam European_ Pricing engine
+ * @param S Spot price inside the table
+ * @param sig Volatility inside the table
+ * @param value Interpolated Call price
+ * @param slope Interpolated Call Delta
+ * @param curvature Interpolated Gamma
+ */
+template<typename European_>
+void PriceTable<European_>::evaluate(double S, double sig, double &value, double &slope, double &curvature) const {
+
+    double x = (S - S0) * invHS, y = (sig - sig0) * invHSig;
+    std::size_t i = std::min(static_cast<std::size_t>(x), nS - 2);
+    std::size_t j = std::min(static_cast<std::size_t>(y), nSig - 2);
+    double u = x - static_cast<double>(i), v = y - static_cast<double>(j);
+
+    // Collapse each row to a polynomial in u with Horner's rule in v
+    const double *c = coefficients.data() + 16 * (i * (nSig - 1) + j);
+    double p[4];
+    for (int a = 0; a < 4; ++a) {
+        const double *row = c + 4 * a;
+        p[a] = ((row[3] * v + row[2]) * v + row[1]) * v + row[0];
+    }
+
+    value = ((p[3] * u + p[2]) * u + p[1]) * u + p[0];
+    slope = ((3.0 * p[3] * u + 2.0 * p[2]) * u + p[1]) * invHS;
+    curvature = (6.0 * p[3] * u + 2.0 * p[2]) * invHS * invHS;
+}
+
+/**
+ * Test whether a point can be answered from the table
+ * @tparam European_ Pricing engine
+ * @param S Spot price
+ * @param sig Volatility
+ * @return True if the point lies inside the grid
+ */
+template<typename European_>
+bool PriceTable<European_>::contains(double S, double sig) const {
+    if (nS < 2 || nSig < 2) { return false; }
+
+    double x = (S - S0) * invHS, y = (sig - sig0) * invHSig;
+    return x >= 0.0 && x <= static_cast<double>(nS - 1) && y >= 0.0 && y <= static_cast<double>(nSig - 1);
+}
+
+/**
+ * Call and Put prices from the table, or from the exact pricer outside the table
+ * @tparam European_ Pricing engine
+ * @param S Spot price
+ * @param sig Volatility
+ * @param call Call price
+ * @param put Put price
+ */
+template<typename European_>
+void PriceTable<European_>::price(double S, double sig, double &call, double &put) const {
+    if (!contains(S, sig)) {
+        European_::price(T, sig, r, S, K, b, call, put);
+        return;
+    }
+
+    double slope, curvature;
+    evaluate(S, sig, call, slope, curvature);
+    put = call - S * carry + discount;
+}
+
+/**
+ * Call and Put prices, Deltas, and Gamma from the table, or from the exact formulas outside the table
+ * @note Table Gamma is the second derivative of the cubic patch and is less accurate than the prices
+ * @tparam European_ Pricing engine
+ * @param S Spot price
+ * @param sig Volatility
+ * @param call Call price
+ * @param put Put price
+ * @param callDelta Call Delta
+ * @param putDelta Put Delta
+ * @param gamma Gamma of both legs
+ */
+template<typename European_>
+void PriceTable<European_>::greeks(double S, double sig, double &call, double &put, double &callDelta,
+                                   double &putDelta, double &gamma) const {
+    if (!contains(S, sig)) {
+        European_::price(T, sig, r, S, K, b, call, put);
+        European_::delta(T, sig, r, S, K, b, callDelta, putDelta);
+        gamma = European_::gamma(T, sig, r, S, K, b);
+        return;
+    }
+
+    evaluate(S, sig, call, callDelta, gamma);
+    put = call - S * carry + discount;
+    putDelta = callDelta - carry;
+}
+
+/* ********************************************************************************************************************
+ * Accessors
+ *********************************************************************************************************************/
+
+/**
+ * Bound on the Call (and Put) price error anywhere in the table, computed when the table was built
+ * @tparam European_ Pricing engine
+ * @return The error bound. Infinite if the grid reaches a non-positive spot or volatility
+ */
+template<typename European_>
+double PriceTable<European_>::errorBound() const { return maxError; }
+
+/**
+ * Number of grid nodes
+ * @tparam European_ Pricing engine
+ * @return The number of nodes
+ */
+template<typename European_>
+std::size_t PriceTable<European_>::nodes() const { return nS * nSig; }
+
+#endif
@@ -0,0 +1,71 @@
+/**********************************************************************************************************************
+ * Precomputed spot by volatility table of European prices and Greeks with bicubic Hermite interpolation
+ *
+ * @note A host class for the European pricing engine. The grid is created by the Mesher policy of the engine. Each
+ * cell stores the 16 monomial coefficients of a bicubic Hermite patch built from exact prices, Deltas, Vegas, and
+ * cross derivatives, so a lookup is an index computation and one polynomial evaluation. Put values follow from
+ * Put-Call parity, which is exact. The price error is bounded on every cell from closed forms of the fourth derivatives.
+ * Queries outside the table fall back to the exact pricer
+ *********************************************************************************************************************/
+
+#ifndef PRICETABLE_HPP
+#define PRICETABLE_HPP
+
+#include <cstddef>
+#include <vector>
+
+template<typename European_>
+class PriceTable {
+private:
+    // Contract data shared by every grid point
+    double T;                                    // Expiry
+    double r;                                    // Risk-free interest rate
+    double K;                                    // Strike price
+    double b;                                    // Cost of carry
+
+    // Uniform grid
+    double S0, hS, invHS;                        // First spot node and spot step
+    double sig0, hSig, invHSig;                  // First volatility node and volatility step
+    std::size_t nS, nSig;                        // Number of nodes on each axis
+
+    double carry;                                // exp((b - r) * T) used by Put-Call parity
+    double discount;                             // K * exp(-r * T) used by Put-Call parity
+
+    std::vector<double> coefficients;            // 16 coefficients per cell, cells stored spot-major
+    double maxError;                             // Bound on the Call price error over every cell
+
+    // Helper functions to build the table and bound its error
+    void build(const std::vector<double>& spots, const std::vector<double>& vols, double sStep, double sigStep);
+    void bound();
+    void evaluate(double S, double sig, double& value, double& slope, double& curvature) const;
+
+public:
+    // Constructors and destructors
+    PriceTable();
+    PriceTable(const PriceTable& source);
+    PriceTable(double T_, double r_, double K_, double b_, double sStart, double sStop, double sStep,
+               double sigStart, double sigStop, double sigStep);
+    virtual ~PriceTable();
+
+    // Operator overloading
+    PriceTable& operator=(const PriceTable& source);
+
+    // Halve the grid steps until the error bound is within tolerance
+    bool refine(double tolerance, int maxRefinements = 6);
+
+    // Lookups
+    bool contains(double S, double sig) const;
+    void price(double S, double sig, double& call, double& put) const;
+    void greeks(double S, double sig, double& call, double& put, double& callDelta, double& putDelta,
+                double& gamma) const;
+
+    // Accessors
+    double errorBound() const;
+    std::size_t nodes() const;
+};
+
+#ifndef PRICETABLE_CPP
+#include "PriceTable.cpp"
+
+#endif // PRICETABLE_CPP
+#endif // PRICETABLE_HPP
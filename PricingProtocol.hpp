@@ -0,0 +1,35 @@
+/**********************************************************************************************************************
+ * Binary wire format shared by the pricing server and its clients
+ *
+ * @note A request is a RequestHeader followed by count rows of T, sig, r, S, K, b as native doubles. A response is a
+ * ResponseHeader followed by count rows of Call and Put prices as native doubles. Both ends run on the same machine so
+ * native byte order is used
+ *********************************************************************************************************************/
+
+#ifndef PRICINGPROTOCOL_HPP
+#define PRICINGPROTOCOL_HPP
+
+#include <cstdint>
+
+namespace PricingProtocol {
+
+    // Exercise style of every row in a request
+    enum Style : std::uint32_t { European = 0, American = 1 };
+
+    // Largest number of rows accepted in a single request
+    const std::uint32_t maxRows = 1u << 20;
+
+    struct RequestHeader {
+        std::uint32_t id;                        // Echoed in the response so clients can pipeline requests
+        std::uint32_t count;                     // Number of option rows that follow
+        std::uint32_t style;                     // European or American
+        std::uint32_t reserved;                  // Keeps the header a multiple of 8 bytes
+    };
+
+    struct ResponseHeader {
+        std::uint32_t id;                        // Id of the request being answered
+        std::uint32_t count;                     // Number of Call and Put rows that follow
+    };
+}
+
+#endif // PRICINGPROTOCOL_HPP
@@ -0,0 +1,323 @@
+/**********************************************************************************************************************
+ * Local pricing daemon that serves binary pricing requests over a Unix domain socket or loopback TCP
+ *********************************************************************************************************************/
+
+#ifndef PRICINGSERVER_CPP
+#define PRICINGSERVER_CPP
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+
+#include "PricingServer.hpp"
+#include "PricingProtocol.hpp"
+#include "OptionBatch.hpp"
+#include "Socket.hpp"
+
+/**
+ * Take ownership of a connected socket
+ * @tparam European_ Pricing engine for European requests (e.g. EuropeanOption<Mesher, Matrix, RNG, Output>)
+ * @tparam American_ Pricing engine for perpetual American requests (e.g. AmericanOption<Mesher, Matrix, Output>)
+ * @param fd_ A connected file descriptor
+ */
+template<typename European_, typename American_>
+PricingServer<European_, American_>::Connection::Connection(int fd_) : fd(fd_), writeLock() {}
+
+/**
+ * Close the socket once the reader thread and every queued request have released the connection
+ * @tparam European_ Pricing engine for European requests
+ * @tparam American_ Pricing engine for perpetual American requests
+ */
+template<typename European_, typename American_>
+PricingServer<European_, American_>::Connection::~Connection() { Socket::close(fd); }
+
+/**
+ * Initialize a new PricingServer. The server does not accept connections until it is started
+ * @tparam European_ Pricing engine for European requests (e.g. EuropeanOption<Mesher, Matrix, RNG, Output>)
+ * @tparam American_ Pricing engine for perpetual American requests (e.g. AmericanOption<Mesher, Matrix, Output>)
+ * @param address_ "unix:<path>" for a Unix domain socket or "tcp:<port>" for loopback TCP
+ * @param maxBatch_ Number of queued rows that triggers a batch before the delay expires
+ * @param maxDelayMicros Longest time in microseconds the first queued request waits for other requests to join it
+ * @throws OutOfMemoryError Indicates insufficient memory for this new PricingServer
+ */
+template<typename European_, typename American_>
+PricingServer<European_, American_>::PricingServer(const std::string &address_, std::size_t maxBatch_,
+        std::size_t maxDelayMicros) : address(address_), maxBatch(maxBatch_), maxDelay(maxDelayMicros), listener(-1),
+        running(false), acceptor(), batcher(), connections(), readers(0), connectionLock(), readersDone(), queue(),
+        queuedRows(0), queueLock(), ready(), latency(), requestCount(0), batchCount(0) {}
+
+/**
+ * Stop this PricingServer and destroy it
+ * @tparam European_ Pricing engine for European requests
+ * @tparam American_ Pricing engine for perpetual American requests
+ */
+template<typename European_, typename American_>
+PricingServer<European_, American_>::~PricingServer() { stop(); }
+
+/* ********************************************************************************************************************
+ * Lifecycle
+ *********************************************************************************************************************/
+
+/**
+ * Bind the listening socket and start the acceptor and batching threads
+ * @tparam European_ Pricing engine for European requests
+ * @tparam American_ Pricing engine for perpetual American requests
+ * @return True if the server is listening. Otherwise false and a message is written to the console
+ */
+template<typename European_, typename American_>
+bool PricingServer<European_, American_>::start() {
+
+    if (running) { return true; }
+
+    listener = Socket::listen(address);
+    if (listener < 0) {
+        std::cout << "Unable to listen on " << address << "\n";
+        return false;
+    }
+
+    running = true;
+    batcher = std::thread(&PricingServer::batchLoop, this);
+    acceptor = std::thread(&PricingServer::acceptLoop, this);
+
+    return true;
+}
+
+/**
+ * Stop accepting connections, disconnect every client, and wait for every thread to finish
+ * @note Requests that were already queued are priced and answered before the batching thread exits
+ * @tparam European_ Pricing engine for European requests
+ * @tparam American_ Pricing engine for perpetual American requests
+ */
+template<typename European_, typename American_>
+void PricingServer<European_, American_>::stop() {
+
+    if (!running.exchange(false)) { return; }
+
+    // Wake the acceptor
+    Socket::shutdown(listener);
+    if (acceptor.joinable()) { acceptor.join(); }
+    Socket::close(listener);
+    listener = -1;
+
+    // Wake every reader and wait for them to release their connections
+    {
+        std::unique_lock<std::mutex> lock(connectionLock);
+        for (auto &connection : connections) {
+            Socket::shutdown(connection->fd);
+        }
+        readersDone.wait(lock, [this] { return readers == 0; });
+    }
+
+    // Drain the queue
+    ready.notify_all();
+    if (batcher.joinable()) { batcher.join(); }
+}
+
+/* ********************************************************************************************************************
+ * Thread bodies
+ *********************************************************************************************************************/
+
+/*
+ * Accept connections and start a reader thread for each of them
+ * @tparam European_ Pricing engine for European requests
+ * @tparam American_ Pricing engine for perpetual American requests
+ */
+template<typename European_, typename American_>
+void PricingServer<European_, American_>::acceptLoop() {
+
+    bool starved = false;
+    while (running) {
+        int fd = Socket::accept(listener);
+        if (fd < 0) {
+            // Out of descriptors or kernel memory. The pending connection stays queued, so back off until a reader
+            // releases its descriptor instead of spinning on the same error
+            if (running && (errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM)) {
+                if (!starved) { std::cout << "accept failed: " << std::strerror(errno) << ". Backing off\n"; }
+                starved = true;
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            }
+            continue;
+        }
+        starved = false;
+
+        std::lock_guard<std::mutex> lock(connectionLock);
+        if (!running) {
+            Socket::close(fd);
+            break;
+        }
+
+        auto it = connections.insert(connections.end(), std::make_shared<Connection>(fd));
+        ++readers;
+        std::thread(&PricingServer::readLoop, this, it).detach();
+    }
+}
+
+/*
+ * Read requests from a single connection and queue them for the batching thread
+ * @tparam European_ Pricing engine for European requests
+ * @tparam American_ Pricing engine for perpetual American requests
+ * @param connection Position of the connection in the list of open connections
+ */
+template<typename European_, typename American_>
+void PricingServer<European_, American_>::readLoop(
+        typename std::list<std::shared_ptr<Connection>>::iterator connection) {
+
+    std::shared_ptr<Connection> self = *connection;
+    PricingProtocol::RequestHeader header{};
+
+    while (running && Socket::read(self->fd, &header, sizeof(header))) {
+        if (header.count > PricingProtocol::maxRows) { break; }
+
+        Job job;
+        job.connection = self;
+        job.id = header.id;
+        job.style = header.style;
+        job.rows.resize(6 * static_cast<std::size_t>(header.count));
+        if (!Socket::read(self->fd, job.rows.data(), job.rows.size() * sizeof(double))) { break; }
+        job.received = std::chrono::steady_clock::now();
+
+        {
+            std::lock_guard<std::mutex> lock(queueLock);
+            queuedRows += header.count;
+            queue.push_back(std::move(job));
+        }
+        ready.notify_one();
+    }
+
+    // Queued requests keep the connection alive until they have been answered
+    std::lock_guard<std::mutex> lock(connectionLock);
+    connections.erase(connection);
+    --readers;
+    readersDone.notify_all();
+}
+
+/*
+ * Coalesce queued requests into micro-batches, price them, and answer every request in the batch
+ * @note A batch is dispatched when the number of queued rows reaches maxBatch or when the oldest queued request has
+ * waited maxDelay. European and American rows are gathered into separate OptionBatch columns that are reused across
+ * batches, so the steady state does not allocate
+ * @tparam European_ Pricing engine for European requests
+ * @tparam American_ Pricing engine for perpetual American requests
+ */
+template<typename European_, typename American_>
+void PricingServer<European_, American_>::batchLoop() {
+
+    std::vector<Job> jobs;
+    OptionBatch european, american;
+    std::vector<double> europeanCalls, europeanPuts, americanCalls, americanPuts;
+    std::vector<double> response, samples;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(queueLock);
+            ready.wait(lock, [this] { return !queue.empty() || !running; });
+            if (queue.empty()) { break; }
+
+            // Give other requests a chance to join the batch
+            auto deadline = queue.front().received + maxDelay;
+            ready.wait_until(lock, deadline, [this] { return queuedRows >= maxBatch || !running; });
+
+            jobs.assign(std::make_move_iterator(queue.begin()), std::make_move_iterator(queue.end()));
+            queue.clear();
+            queuedRows = 0;
+        }
+
+        // Gather the rows of every request into contiguous columns
+        european.clear();
+        american.clear();
+        for (const Job &job : jobs) {
+            OptionBatch &batch = job.style == PricingProtocol::American ? american : european;
+            for (std::size_t k = 0; k < job.rows.size(); k += 6) {
+                const double *row = job.rows.data() + k;
+                batch.push_back(row[0], row[1], row[2], row[3], row[4], row[5]);
+            }
+        }
+
+        European_::price(european, europeanCalls, europeanPuts);
+        American_::price(american, americanCalls, americanPuts);
+
+        // Scatter the prices back to each request
+        std::size_t europeanOffset = 0, americanOffset = 0;
+        samples.clear();
+        for (Job &job : jobs) {
+            bool isAmerican = job.style == PricingProtocol::American;
+            std::size_t &offset = isAmerican ? americanOffset : europeanOffset;
+            const std::vector<double> &calls = isAmerican ? americanCalls : europeanCalls;
+            const std::vector<double> &puts = isAmerican ? americanPuts : europeanPuts;
+
+            PricingProtocol::ResponseHeader header{job.id, static_cast<std::uint32_t>(job.rows.size() / 6)};
+            response.resize(2 * header.count);
+            for (std::size_t i = 0; i < header.count; ++i) {
+                response[2 * i] = calls[offset + i];
+                response[2 * i + 1] = puts[offset + i];
+            }
+            offset += header.count;
+
+            {
+                // A failed write means the client has gone away. Its reader thread will release the connection
+                std::lock_guard<std::mutex> lock(job.connection->writeLock);
+                if (Socket::write(job.connection->fd, &header, sizeof(header))) {
+                    Socket::write(job.connection->fd, response.data(), response.size() * sizeof(double));
+                }
+            }
+
+            std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - job.received;
+            samples.push_back(elapsed.count());
+        }
+
+        latency.add(samples);
+        requestCount += jobs.size();
+        ++batchCount;
+        jobs.clear();
+    }
+}
+
+/* ********************************************************************************************************************
+ * Statistics
+ *********************************************************************************************************************/
+
+/**
+ * Number of requests answered since the server started
+ * @tparam European_ Pricing engine for European requests
+ * @tparam American_ Pricing engine for perpetual American requests
+ * @return The number of requests
+ */
+template<typename European_, typename American_>
+std::uint64_t PricingServer<European_, American_>::requests() const { return requestCount; }
+
+/**
+ * Number of micro-batches priced since the server started
+ * @tparam European_ Pricing engine for European requests
+ * @tparam American_ Pricing engine for perpetual American requests
+ * @return The number of batches
+ */
+template<typename European_, typename American_>
+std::uint64_t PricingServer<European_, American_>::batches() const { return batchCount; }
+
+/**
+ * Receipt to response latency percentiles since the last report
+ * @tparam European_ Pricing engine for European requests
+ * @tparam American_ Pricing engine for perpetual American requests
+ * @return The p50 and p99 latencies in microseconds
+ */
+template<typename European_, typename American_>
+std::vector<double> PricingServer<European_, American_>::percentiles() const {
+    return latency.percentiles({0.50, 0.99});
+}
+
+/**
+ * Write the request count, batch count, and p50/p99 latency to a stream and start a new latency window
+ * @tparam European_ Pricing engine for European requests
+ * @tparam American_ Pricing engine for perpetual American requests
+ * @param out The stream that receives the report
+ */
+template<typename European_, typename American_>
+void PricingServer<European_, American_>::report(std::ostream &out) {
+    std::vector<double> p = percentiles();
+    out << "requests: " << requests() << ", batches: " << batches() << ", window: " << latency.count()
+        << ", p50: " << p[0] << "us, p99: " << p[1] << "us" << std::endl;
+    latency.reset();
+}
+
+#endif
@@ -0,0 +1,102 @@
+/**********************************************************************************************************************
+ * Local pricing daemon that serves binary pricing requests over a Unix domain socket or loopback TCP
+ *
+ * @note A host class for the European and American pricing engines. Each connection has a reader thread that queues
+ * requests. A single batching thread coalesces the queued requests into micro-batches, prices each batch with the
+ * batch pricing functions, and writes the responses back to their connections
+ *********************************************************************************************************************/
+
+#ifndef PRICINGSERVER_HPP
+#define PRICINGSERVER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "LatencyStats.hpp"
+
+template<typename European_, typename American_>
+class PricingServer {
+private:
+    // A client connection shared by its reader thread and every queued request
+    struct Connection {
+        int fd;
+        std::mutex writeLock;
+
+        explicit Connection(int fd_);
+        ~Connection();
+    };
+
+    // A request waiting to be batched
+    struct Job {
+        std::shared_ptr<Connection> connection;
+        std::uint32_t id;
+        std::uint32_t style;
+        std::vector<double> rows;
+        std::chrono::steady_clock::time_point received;
+    };
+
+    std::string address;                         // unix:<path> or tcp:<port>
+    std::size_t maxBatch;                        // Rows that trigger a batch before the delay expires
+    std::chrono::microseconds maxDelay;          // Longest time the first queued request waits for company
+
+    int listener;
+    std::atomic<bool> running;
+    std::thread acceptor;
+    std::thread batcher;
+
+    std::list<std::shared_ptr<Connection>> connections;  // Open connections. Guarded by connectionLock
+    std::size_t readers;                                 // Live reader threads. Guarded by connectionLock
+    std::mutex connectionLock;
+    std::condition_variable readersDone;
+
+    std::deque<Job> queue;                       // Requests waiting to be batched. Guarded by queueLock
+    std::size_t queuedRows;
+    std::mutex queueLock;
+    std::condition_variable ready;
+
+    LatencyStats latency;                        // Receipt to response latency of every request
+    std::atomic<std::uint64_t> requestCount;
+    std::atomic<std::uint64_t> batchCount;
+
+    // Thread bodies
+    void acceptLoop();
+    void readLoop(typename std::list<std::shared_ptr<Connection>>::iterator connection);
+    void batchLoop();
+
+public:
+    // Constructors and destructors
+    explicit PricingServer(const std::string& address_, std::size_t maxBatch_ = 4096,
+                           std::size_t maxDelayMicros = 50);
+    PricingServer(const PricingServer& source) = delete;
+    virtual ~PricingServer();
+
+    // Operator overloading
+    PricingServer& operator=(const PricingServer& source) = delete;
+
+    // Lifecycle
+    bool start();
+    void stop();
+
+    // Statistics
+    std::uint64_t requests() const;
+    std::uint64_t batches() const;
+    std::vector<double> percentiles() const;
+    void report(std::ostream& out);
+};
+
+#ifndef PRICINGSERVER_CPP
+#include "PricingServer.cpp"
+
+#endif // PRICINGSERVER_CPP
+#endif // PRICINGSERVER_HPP
@@ -68,3 +68,20 @@ double RNG::MersenneTwister() {
     boost::normal_distribution<double> N(0, 1);
     return N(rng);
 }
+
+/**
+ * Fill a container with standard normal variates drawn from a single Mersenne Twister stream
+ * @note The generator is seeded once per call, so every variate in the container is independent. Use distinct seeds to
+ * generate independent streams on different threads
+ * @param variates Container to fill. Its size determines the number of variates
+ * @param seed Seed for the Mersenne Twister
+ */
+void RNG::MersenneTwister(std::vector<double>& variates, unsigned int seed) {
+    boost::random::mt19937 rng(seed);
+
+    // A normal distribution with a mean of 0 and standard deviation of 1 is known as the Standard Normal Distribution
+    boost::normal_distribution<double> N(0, 1);
+    for (double &z : variates) {
+        z = N(rng);
+    }
+}
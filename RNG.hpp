@@ -8,6 +8,7 @@
 #define RNG_HPP
 
 #include <string>
+#include <vector>
 #include <ctime>
 
 #include "boost/random.hpp"
@@ -28,6 +29,7 @@ public:
 
     // Core functionality
     static double MersenneTwister();             // Generate a standard normal distribution using Mersenne Twister
+    static void MersenneTwister(std::vector<double>& variates, unsigned int seed); // Fill with standard normals
     static double CDF(double x);                 // Cumulative normal distribution function
     static double PDF(double x);                 // Normal (Gaussian) probability density function
 };
@@ -0,0 +1,13 @@
+/**********************************************************************************************************************
+ * Regression tests - Main entry point
+ *
+ * Usage: RegressionMain
+ *     Prints one line per test and exits with the number of failed tests, so 0 means every test passed
+ *********************************************************************************************************************/
+
+#include "TestRegression.hpp"
+
+int main() {
+    TestRegression tests;
+    return static_cast<int>(tests.run());
+}
@@ -0,0 +1,114 @@
+/**********************************************************************************************************************
+ * Bounded lock-free queue for handing messages between threads, e.g. market data ticks from a feed handler
+ *********************************************************************************************************************/
+
+#ifndef RINGQUEUE_CPP
+#define RINGQUEUE_CPP
+
+#include "RingQueue.hpp"
+
+/**
+ * Initialize a new empty RingQueue
+ * @tparam T_ Message type. It must be default constructible and copy assignable
+ * @param capacity Number of slots, rounded up to a power of two
+ * @throws OutOfMemoryError Indicates insufficient memory for this new RingQueue
+ */
+template<typename T_>
+RingQueue<T_>::RingQueue(std::size_t capacity) : slots(), mask(0), head(0), tail(0) {
+    std::size_t n = 2;
+    while (n < capacity) { n <<= 1; }
+
+    slots.reset(new Slot[n]);
+    mask = n - 1;
+    for (std::size_t i = 0; i < n; ++i) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * Destroy this RingQueue
+ * @tparam T_ Message type
+ */
+template<typename T_>
+RingQueue<T_>::~RingQueue() {}
+
+/**
+ * Append a message
+ * @note A slot is free for position p when its sequence equals p. The producer claims p by advancing the head, writes
+ * the message, and publishes it by setting the sequence to p + 1
+ * @tparam T_ Message type
+ * @param value The message
+ * @return False if the queue is full
+ */
+template<typename T_>
+bool RingQueue<T_>::push(const T_ &value) {
+    std::size_t position = head.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot &slot = slots[position & mask];
+        std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+        if (difference == 0) {
+            if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                slot.value = value;
+                slot.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (difference < 0) {
+            return false;
+        } else {
+            position = head.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * Remove the oldest message
+ * @note A slot holds the message of position p when its sequence equals p + 1. The consumer claims p by advancing the
+ * tail, reads the message, and frees the slot for position p + capacity
+ * @tparam T_ Message type
+ * @param value Receives the message
+ * @return False if the queue is empty
+ */
+template<typename T_>
+bool RingQueue<T_>::pop(T_ &value) {
+    std::size_t position = tail.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot &slot = slots[position & mask];
+        std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+
+        if (difference == 0) {
+            if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                value = slot.value;
+                slot.sequence.store(position + mask + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (difference < 0) {
+            return false;
+        } else {
+            position = tail.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * Number of slots
+ * @tparam T_ Message type
+ * @return The capacity of the ring
+ */
+template<typename T_>
+std::size_t RingQueue<T_>::capacity() const { return mask + 1; }
+
+/**
+ * Whether the queue looked empty when it was checked
+ * @note Another thread may push or pop at any time, so the answer is only a hint
+ * @tparam T_ Message type
+ * @return True if every pushed message had been popped
+ */
+template<typename T_>
+bool RingQueue<T_>::empty() const {
+    return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+}
+
+#endif
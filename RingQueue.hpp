@@ -0,0 +1,52 @@
+/**********************************************************************************************************************
+ * Bounded lock-free queue for handing messages between threads, e.g. market data ticks from a feed handler
+ *
+ * @note Every slot carries a sequence number that tells producers and consumers whose turn it is, so a push or a pop is
+ * one compare and swap on a shared cursor followed by a release store on the slot. The queue is safe for any number of
+ * producers and consumers and costs no more than a single producer single consumer ring when there is only one of each.
+ * The cursors live on separate cache lines so producers and consumers do not false share
+ *********************************************************************************************************************/
+
+#ifndef RINGQUEUE_HPP
+#define RINGQUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+template<typename T_>
+class RingQueue {
+private:
+    struct Slot {
+        std::atomic<std::size_t> sequence;       // Position that may use this slot next
+        T_ value;
+    };
+
+    std::unique_ptr<Slot[]> slots;               // Ring of slots
+    std::size_t mask;                            // Capacity - 1. The capacity is a power of two
+    alignas(64) std::atomic<std::size_t> head;   // Next position to push
+    alignas(64) std::atomic<std::size_t> tail;   // Next position to pop
+
+public:
+    // Constructors and destructors
+    explicit RingQueue(std::size_t capacity = 65536);
+    RingQueue(const RingQueue& source) = delete;
+    virtual ~RingQueue();
+
+    // Operator overloading
+    RingQueue& operator=(const RingQueue& source) = delete;
+
+    // Non-blocking push and pop. Both return false instead of waiting
+    bool push(const T_& value);
+    bool pop(T_& value);
+
+    // Accessors
+    std::size_t capacity() const;
+    bool empty() const;
+};
+
+#ifndef RINGQUEUE_CPP
+#include "RingQueue.cpp"
+
+#endif // RINGQUEUE_CPP
+#endif // RINGQUEUE_HPP
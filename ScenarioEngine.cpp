@@ -0,0 +1,275 @@
+/**********************************************************************************************************************
+ * Reprices a Portfolio under a set of spot, volatility, rate, and time decay shocks
+ *********************************************************************************************************************/
+
+#ifndef SCENARIOENGINE_CPP
+#define SCENARIOENGINE_CPP
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "ScenarioEngine.hpp"
+#include "Parallel.hpp"
+
+/**
+ * Initialize a new ScenarioEngine
+ * @tparam European_ Pricing engine for European positions (e.g. EuropeanOption<Mesher, Matrix, RNG, Output>)
+ * @tparam American_ Pricing engine for perpetual American positions (e.g. AmericanOption<Mesher, Matrix, Output>)
+ * @throws OutOfMemoryError Indicates insufficient memory for this new ScenarioEngine
+ */
+template<typename European_, typename American_>
+ScenarioEngine<European_, American_>::ScenarioEngine() {}
+
+/**
+ * Initialize a new ScenarioEngine whose data members are a deep copy of the source
+ * @tparam European_ Pricing engine for European positions
+ * @tparam American_ Pricing engine for perpetual American positions
+ * @param source A ScenarioEngine whose data members will be deeply copied
+ * @throws OutOfMemoryError Indicates insufficient memory for this new ScenarioEngine
+ */
+template<typename European_, typename American_>
+ScenarioEngine<European_, American_>::ScenarioEngine(const ScenarioEngine<European_, American_> &) {}
+
+/**
+ * Destroy this ScenarioEngine
+ * @tparam European_ Pricing engine for European positions
+ * @tparam American_ Pricing engine for perpetual American positions
+ */
+template<typename European_, typename American_>
+ScenarioEngine<European_, American_>::~ScenarioEngine() {}
+
+/**
+ * Deeply copy the source data members into this ScenarioEngine
+ * @tparam European_ Pricing engine for European positions
+ * @tparam American_ Pricing engine for perpetual American positions
+ * @param source A ScenarioEngine whose data members will be deeply copied
+ * @return This ScenarioEngine whose data members are a deep copy of the source data members
+ */
+template<typename European_, typename American_>
+ScenarioEngine<European_, American_>&
+ScenarioEngine<European_, American_>::operator=(const ScenarioEngine<European_, American_> &source) {
+    // Avoid self assign
+    if (this == &source) { return *this; }
+
+    return *this;
+}
+
+/* ********************************************************************************************************************
+ * Scenario generation
+ *********************************************************************************************************************/
+
+/**
+ * Create a spot by volatility shock ladder with no rate or time shock
+ * @note The Mesher policy can be used to create evenly spaced shocks, e.g. Mesher().xarr(-20, 20, 5)
+ * @tparam European_ Pricing engine for European positions
+ * @tparam American_ Pricing engine for perpetual American positions
+ * @param spotShocks Relative spot moves in percent (e.g. -10 is a 10% fall in spot)
+ * @param volShocks Absolute volatility moves in vol points (e.g. 5 adds 0.05 to sig)
+ * @return A matrix of scenarios where each row has the spot, vol, rate, and time shocks
+ */
+template<typename European_, typename American_>
+std::vector<std::vector<double>>
+ScenarioEngine<European_, American_>::ladder(const std::vector<double> &spotShocks,
+        const std::vector<double> &volShocks) {
+
+    std::vector<std::vector<double>> scenarios;
+    scenarios.reserve(spotShocks.size() * volShocks.size());
+
+    for (double dSig : volShocks) {
+        for (double dS : spotShocks) {
+            scenarios.push_back({dS, dSig, 0.0, 0.0});
+        }
+    }
+
+    return scenarios;
+}
+
+/*
+ * Helper function that groups scenarios by rate and time shock, then by volatility shock
+ * @tparam European_ Pricing engine for European positions
+ * @tparam American_ Pricing engine for perpetual American positions
+ * @param scenarios A matrix of scenarios where each row has the spot, vol, rate, and time shocks
+ * @return The grouped scenarios. Shocks are converted to decimal units
+ */
+template<typename European_, typename American_>
+std::vector<typename ScenarioEngine<European_, American_>::RateTimeGroup>
+ScenarioEngine<European_, American_>::group(const std::vector<std::vector<double>> &scenarios) {
+
+    // Order scenarios so that rows sharing a rate, time, and vol shock are adjacent
+    std::vector<std::size_t> order(scenarios.size());
+    for (std::size_t s = 0; s < order.size(); ++s) { order[s] = s; }
+
+    std::sort(order.begin(), order.end(), [&](std::size_t lhs, std::size_t rhs) {
+        const std::vector<double> &a = scenarios[lhs], &b = scenarios[rhs];
+        if (a[2] != b[2]) { return a[2] < b[2]; }
+        if (a[3] != b[3]) { return a[3] < b[3]; }
+        return a[1] < b[1];
+    });
+
+    std::vector<RateTimeGroup> groups;
+    for (std::size_t s : order) {
+        const std::vector<double> &row = scenarios[s];
+
+        // Rates are quoted in basis points, time decay in days, and volatility in vol points
+        double dR = row[2] / 10000.0;
+        double dT = row[3] / 365.0;
+        double dSig = row[1] / 100.0;
+
+        if (groups.empty() || groups.back().dR != dR || groups.back().dT != dT) {
+            groups.push_back({dR, dT, {}});
+        }
+
+        std::vector<VolGroup> &vols = groups.back().vols;
+        if (vols.empty() || vols.back().dSig != dSig) {
+            vols.push_back({dSig, {}});
+        }
+        vols.back().scenarios.push_back(s);
+    }
+
+    return groups;
+}
+
+/* ********************************************************************************************************************
+ * Core scenario functions
+ *********************************************************************************************************************/
+
+/**
+ * Reprice the portfolio under every scenario
+ * @note Rate shocks move r and b together, which preserves the dividend yield r - b. European positions whose expiry
+ * is consumed by the time shock are valued at intrinsic value. Perpetual American positions ignore the time shock
+ * @tparam European_ Pricing engine for European positions
+ * @tparam American_ Pricing engine for perpetual American positions
+ * @param portfolio The book to reprice
+ * @param scenarios A matrix of scenarios where each row has a spot shock in percent, a volatility shock in vol points,
+ * a rate shock in basis points, and a time decay in days
+ * @return A matrix with one row per scenario. Each row has the scenario PV and the PnL against the unshocked book
+ * @throws std::invalid_argument If a scenario has fewer than four shocks or a spot shock of -100% or less
+ */
+template<typename European_, typename American_>
+std::vector<std::vector<double>>
+ScenarioEngine<European_, American_>::run(const Portfolio &portfolio,
+        const std::vector<std::vector<double>> &scenarios) const {
+
+    for (const auto &row : scenarios) {
+        if (row.size() < 4) {
+            throw std::invalid_argument("Each scenario needs a spot, volatility, rate, and time shock");
+        }
+        if (!(row[0] > -100.0)) {
+            throw std::invalid_argument("Spot shocks must be above -100%");
+        }
+    }
+
+    // The unshocked book is priced as one extra scenario so that it shares the same groups
+    std::vector<std::vector<double>> shocks(scenarios);
+    shocks.push_back({0.0, 0.0, 0.0, 0.0});
+
+    std::size_t n = shocks.size();
+    std::size_t base = n - 1;
+    std::vector<RateTimeGroup> groups = group(shocks);
+
+    // Spot shocks only rescale S, so log(S' / K) = log(S / K) + log(growth)
+    std::vector<double> growth(n), logGrowth(n);
+    for (std::size_t s = 0; s < n; ++s) {
+        growth[s] = 1.0 + shocks[s][0] / 100.0;
+        logGrowth[s] = log(growth[s]);
+    }
+
+    // One accumulation buffer per worker with one slot per scenario
+    std::vector<std::vector<double>> partials(Parallel::threads(), std::vector<double>(n, 0.0));
+
+    const OptionBatch &options = portfolio.options();
+    const double *T_ = options.expiry().data(), *sig_ = options.vol().data(), *r_ = options.riskFree().data();
+    const double *S_ = options.spot().data(), *K_ = options.strike().data(), *b_ = options.carry().data();
+    const std::vector<double> &quantity = portfolio.quantity();
+
+    Parallel::forDynamic(portfolio.size(), [&](std::size_t worker, std::size_t first, std::size_t last) {
+        double *acc = partials[worker].data();
+
+        for (std::size_t i = first; i < last; ++i) {
+            double q = quantity[i];
+            double S = S_[i], K = K_[i];
+            bool isCall = portfolio.type()[i] == Portfolio::OptionType::Call;
+
+            if (portfolio.style()[i] == Portfolio::ExerciseStyle::European) {
+                double logSK = log(S / K);
+
+                for (const RateTimeGroup &g : groups) {
+                    double T = T_[i] - g.dT, r = r_[i] + g.dR, b = b_[i] + g.dR;
+
+                    // Expired positions are worth their intrinsic value
+                    if (T <= 0.0) {
+                        for (const VolGroup &v : g.vols) {
+                            for (std::size_t s : v.scenarios) {
+                                double spot = S * growth[s];
+                                acc[s] += q * (isCall ? std::max(spot - K, 0.0) : std::max(K - spot, 0.0));
+                            }
+                        }
+                        continue;
+                    }
+
+                    // Shared by every vol and spot shock in this group
+                    double sqrtT = sqrt(T);
+                    double carry = S * exp((b - r) * T);
+                    double discount = K * exp(-r * T);
+
+                    for (const VolGroup &v : g.vols) {
+                        double sig = std::max(sig_[i] + v.dSig, 1e-8);
+
+                        // Shared by every spot shock in this group
+                        double tmp = sig * sqrtT;
+                        double drift = (b + (sig * sig) * 0.5) * T;
+
+                        for (std::size_t s : v.scenarios) {
+                            double d1 = (logSK + logGrowth[s] + drift) / tmp;
+                            double d2 = d1 - tmp;
+
+                            double value = isCall
+                                    ? (carry * growth[s] * European_::CDF(d1)) - (discount * European_::CDF(d2))
+                                    : (discount * European_::CDF(-d2)) - (carry * growth[s] * European_::CDF(-d1));
+                            acc[s] += q * value;
+                        }
+                    }
+                }
+            } else {
+                for (const RateTimeGroup &g : groups) {
+                    double r = r_[i] + g.dR, b = b_[i] + g.dR;
+
+                    for (const VolGroup &v : g.vols) {
+                        double sig = std::max(sig_[i] + v.dSig, 1e-8);
+
+                        // The perpetual price scales with (S' / S)^y, so one pricing serves every spot shock
+                        double call, put, y1, y2;
+                        American_::price(sig, r, S, K, b, call, put);
+                        American_::exponents(sig, r, b, y1, y2);
+
+                        double value = isCall ? call : put;
+                        double y = isCall ? y1 : (0.0 == y2 ? 1.0 : y2);
+
+                        for (std::size_t s : v.scenarios) {
+                            acc[s] += q * value * pow(growth[s], y);
+                        }
+                    }
+                }
+            }
+        }
+    }, 256);
+
+    // Combine the per-worker buffers
+    std::vector<double> pv(n, 0.0);
+    for (const auto &partial : partials) {
+        for (std::size_t s = 0; s < n; ++s) {
+            pv[s] += partial[s];
+        }
+    }
+
+    std::vector<std::vector<double>> result;
+    result.reserve(n - 1);
+    for (std::size_t s = 0; s < base; ++s) {
+        result.push_back({pv[s], pv[s] - pv[base]});
+    }
+
+    return result;
+}
+
+#endif
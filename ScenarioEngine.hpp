@@ -0,0 +1,58 @@
+/**********************************************************************************************************************
+ * Reprices a Portfolio under a set of spot, volatility, rate, and time decay shocks
+ *
+ * @note A host class for the European and American pricing engines. Scenarios are grouped by rate and time shock, then
+ * by volatility shock, so that discount factors, sig * sqrt(T), and log(S / K) are computed once per group rather than
+ * once per scenario. Positions are shared across threads by work stealing and every thread accumulates all scenarios
+ *********************************************************************************************************************/
+
+#ifndef SCENARIOENGINE_HPP
+#define SCENARIOENGINE_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "Portfolio.hpp"
+
+template<typename European_, typename American_>
+class ScenarioEngine {
+private:
+    // Scenarios that share a volatility shock
+    struct VolGroup {
+        double dSig;
+        std::vector<std::size_t> scenarios;
+    };
+
+    // Scenarios that share a rate and time shock
+    struct RateTimeGroup {
+        double dR;
+        double dT;
+        std::vector<VolGroup> vols;
+    };
+
+    // Helper function that groups scenarios by the shocks that change the shared intermediates
+    static std::vector<RateTimeGroup> group(const std::vector<std::vector<double>>& scenarios);
+
+public:
+    // Constructors and destructors
+    ScenarioEngine();
+    ScenarioEngine(const ScenarioEngine& source);
+    virtual ~ScenarioEngine();
+
+    // Operator overloading
+    ScenarioEngine& operator=(const ScenarioEngine& source);
+
+    // Create a spot by volatility shock ladder
+    static std::vector<std::vector<double>> ladder(const std::vector<double>& spotShocks,
+                                                   const std::vector<double>& volShocks);
+
+    // Reprice the portfolio under every scenario. One row per scenario with PV and PnL
+    std::vector<std::vector<double>> run(const Portfolio& portfolio,
+                                         const std::vector<std::vector<double>>& scenarios) const;
+};
+
+#ifndef SCENARIOENGINE_CPP
+#include "ScenarioEngine.cpp"
+
+#endif // SCENARIOENGINE_CPP
+#endif // SCENARIOENGINE_HPP
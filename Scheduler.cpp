@@ -0,0 +1,317 @@
+/**********************************************************************************************************************
+ * Work-stealing scheduler for row ranges whose cost per row varies, e.g. books that mix closed form and numerical
+ * valuations
+ *********************************************************************************************************************/
+
+#ifndef SCHEDULER_CPP
+#define SCHEDULER_CPP
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <thread>
+
+#include "Scheduler.hpp"
+
+/* ********************************************************************************************************************
+ * Deque
+ *********************************************************************************************************************/
+
+/*
+ * Initialize an empty deque
+ */
+inline Scheduler::Deque::Deque() : top(0), bottom(0) {
+    for (Slot &slot : slots) {
+        slot.first.store(0, std::memory_order_relaxed);
+        slot.last.store(0, std::memory_order_relaxed);
+    }
+}
+
+/*
+ * Whether the owner should stop splitting
+ * @note Ranges are halved, so a deque holds at most one range per bit of the row count and never fills in practice. A
+ * full deque only makes the owner run a larger task
+ * @return True if one more push could wrap onto a slot that a thief may be reading
+ */
+inline bool Scheduler::Deque::full() const {
+    return bottom.load(std::memory_order_relaxed) - top.load(std::memory_order_acquire) >= capacity - 1;
+}
+
+/*
+ * Push a range onto the bottom. Only the owner may call this
+ * @param first First row of the range
+ * @param last One past the last row of the range
+ */
+inline void Scheduler::Deque::push(std::size_t first, std::size_t last) {
+    std::int64_t b = bottom.load(std::memory_order_relaxed);
+    Slot &slot = slots[b % capacity];
+    slot.first.store(first, std::memory_order_relaxed);
+    slot.last.store(last, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom.store(b + 1, std::memory_order_relaxed);
+}
+
+/*
+ * Pop the most recently pushed range. Only the owner may call this
+ * @note The last range is contended with thieves and is claimed with a compare and swap on the top
+ * @param first Receives the first row of the range
+ * @param last Receives one past the last row of the range
+ * @return False if the deque is empty
+ */
+inline bool Scheduler::Deque::pop(std::size_t &first, std::size_t &last) {
+    std::int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t t = top.load(std::memory_order_relaxed);
+
+    if (t > b) {
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return false;
+    }
+
+    const Slot &slot = slots[b % capacity];
+    first = slot.first.load(std::memory_order_relaxed);
+    last = slot.last.load(std::memory_order_relaxed);
+    if (t < b) { return true; }
+
+    bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    bottom.store(b + 1, std::memory_order_relaxed);
+    return won;
+}
+
+/*
+ * Steal the oldest range. Any worker may call this
+ * @param first Receives the first row of the range
+ * @param last Receives one past the last row of the range
+ * @return False if the deque is empty or another worker claimed the range first
+ */
+inline bool Scheduler::Deque::steal(std::size_t &first, std::size_t &last) {
+    std::int64_t t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t b = bottom.load(std::memory_order_acquire);
+    if (t >= b) { return false; }
+
+    const Slot &slot = slots[t % capacity];
+    first = slot.first.load(std::memory_order_relaxed);
+    last = slot.last.load(std::memory_order_relaxed);
+    return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+}
+
+/* ********************************************************************************************************************
+ * Scheduler
+ *********************************************************************************************************************/
+
+/**
+ * Initialize a new Scheduler with one worker per hardware thread
+ * @throws OutOfMemoryError Indicates insufficient memory for this new Scheduler
+ */
+inline Scheduler::Scheduler() : workers(std::max<std::size_t>(std::thread::hardware_concurrency(), 1)), target(50e-6),
+utilization(), elapsed(0.0) {}
+
+/**
+ * Initialize a new Scheduler whose data members are a copy of the source
+ * @param source A Scheduler whose data members will be copied
+ * @throws OutOfMemoryError Indicates insufficient memory for this new Scheduler
+ */
+inline Scheduler::Scheduler(const Scheduler &source) : workers(source.workers), target(source.target),
+utilization(source.utilization), elapsed(source.elapsed) {}
+
+/**
+ * Initialize a new Scheduler with the specified number of workers
+ * @param workers_ Number of worker threads, including the calling thread
+ * @param target_ Target seconds per task. Shorter tasks balance better and cost more scheduling overhead
+ * @throws OutOfMemoryError Indicates insufficient memory for this new Scheduler
+ */
+inline Scheduler::Scheduler(std::size_t workers_, double target_) : workers(std::max<std::size_t>(workers_, 1)),
+target(target_), utilization(), elapsed(0.0) {}
+
+/**
+ * Destroy this Scheduler
+ */
+inline Scheduler::~Scheduler() {}
+
+/**
+ * Copy the source data members into this Scheduler
+ * @param source A Scheduler whose data members will be copied
+ * @return This Scheduler whose data members are a copy of the source data members
+ */
+inline Scheduler& Scheduler::operator=(const Scheduler &source) {
+    // Avoid self assign
+    if (this == &source) { return *this; }
+
+    workers = source.workers;
+    target = source.target;
+    utilization = source.utilization;
+    elapsed = source.elapsed;
+
+    return *this;
+}
+
+/**
+ * Invoke f(worker, first, last) over ranges that cover [0, n) exactly once
+ * @note Worker indices are dense in [0, threads()) so callers can index per-worker accumulation buffers, as with
+ * Parallel::forRange. A worker measures the cost per row of every task it runs and sizes its next task to the target
+ * duration, never below the grain. Per-worker buffers are summed in an order that depends on the steals, so results
+ * may differ from a static partition in the last bits. An exception thrown by f is captured, the other workers stop
+ * at their next task, every worker is joined, and the exception of the lowest worker is rethrown on the calling thread
+ * @tparam Function Callable with the signature void(std::size_t worker, std::size_t first, std::size_t last)
+ * @param n Number of rows
+ * @param f The function applied to each range
+ * @param grain Minimum number of rows per task
+ */
+template<typename Function>
+void Scheduler::forRange(std::size_t n, Function f, std::size_t grain) {
+
+    typedef std::chrono::steady_clock Clock;
+    auto start = Clock::now();
+
+    grain = std::max<std::size_t>(grain, 1);
+    std::size_t active = std::max<std::size_t>(std::min(workers, (n + grain - 1) / grain), 1);
+    utilization.assign(active, Utilization{0, 0, 0, 0.0});
+
+    if (n == 0) {
+        elapsed = 0.0;
+        return;
+    }
+
+    std::vector<Deque> deques(active);
+    std::atomic<std::size_t> remaining(n);
+    std::atomic<bool> aborted(false);
+    std::vector<std::exception_ptr> errors(active);
+    std::size_t chunk = (n + active - 1) / active;
+
+    auto work = [&](std::size_t w) {
+        Utilization &stats = utilization[w];
+        Deque &own = deques[w];
+
+        // Start from the static share of this worker
+        std::size_t first = std::min(n, w * chunk), last = std::min(n, first + chunk);
+        double cost = 0.0;
+
+        // The rows of a failed task are never counted off, so the other workers stop on the abort flag instead
+        try {
+            while (remaining.load(std::memory_order_acquire) > 0 && !aborted.load(std::memory_order_acquire)) {
+                if (first == last && !own.pop(first, last)) {
+                    bool stolen = false;
+                    for (std::size_t k = 1; k < active && !stolen; ++k) {
+                        stolen = deques[(w + k) % active].steal(first, last);
+                    }
+                    if (!stolen) {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    ++stats.steals;
+                }
+
+                // Split down to the task size and leave the upper halves for this worker or a thief
+                std::size_t size = cost > 0.0 ? std::max(grain, static_cast<std::size_t>(target / cost)) : grain;
+                while (last - first > size && !own.full()) {
+                    std::size_t middle = first + (last - first) / 2;
+                    own.push(middle, last);
+                    last = middle;
+                }
+
+                auto t0 = Clock::now();
+                f(w, first, last);
+                double seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+
+                double perRow = seconds / static_cast<double>(last - first);
+                cost = cost > 0.0 ? 0.5 * (cost + perRow) : std::max(perRow, 1e-12);
+
+                ++stats.tasks;
+                stats.rows += last - first;
+                stats.busy += seconds;
+                remaining.fetch_sub(last - first, std::memory_order_acq_rel);
+                first = last;
+            }
+        } catch (...) {
+            errors[w] = std::current_exception();
+            aborted.store(true, std::memory_order_release);
+        }
+    };
+
+    // Joins every started worker on the way out, including when a later worker cannot be started
+    std::vector<std::thread> pool;
+    struct Joiner {
+        std::vector<std::thread> &threads;
+        ~Joiner() {
+            for (auto &thread : threads) {
+                if (thread.joinable()) { thread.join(); }
+            }
+        }
+    } joiner{pool};
+
+    // The calling thread is worker zero
+    pool.reserve(active - 1);
+    try {
+        for (std::size_t w = 1; w < active; ++w) {
+            pool.emplace_back(work, w);
+        }
+    } catch (...) {
+        aborted.store(true, std::memory_order_release);
+        throw;
+    }
+    work(0);
+
+    for (auto &thread : pool) {
+        thread.join();
+    }
+    elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+    for (const auto &error : errors) {
+        if (error) { std::rethrow_exception(error); }
+    }
+}
+
+/**
+ * Invoke f(worker, i) once for every i in [0, n)
+ * @note Each index is a task of its own until the measured cost shows that indices are cheap enough to be batched
+ * @tparam Function Callable with the signature void(std::size_t worker, std::size_t i)
+ * @param n Number of tasks
+ * @param f The function applied to each index
+ */
+template<typename Function>
+void Scheduler::forEach(std::size_t n, Function f) {
+    forRange(n, [&f](std::size_t worker, std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            f(worker, i);
+        }
+    }, 1);
+}
+
+/* ********************************************************************************************************************
+ * Accessors
+ *********************************************************************************************************************/
+
+/**
+ * Number of worker threads
+ * @return The number of workers, including the calling thread
+ */
+inline std::size_t Scheduler::threads() const { return workers; }
+
+/**
+ * Work done by each worker during the last run
+ * @return One entry per worker that took part, with its tasks, steals, rows, and busy seconds
+ */
+inline const std::vector<Scheduler::Utilization>& Scheduler::stats() const { return utilization; }
+
+/**
+ * Wall clock time of the last run
+ * @return Seconds from the start of the run until every worker had joined
+ */
+inline double Scheduler::wall() const { return elapsed; }
+
+/**
+ * Load balance of the last run
+ * @return The mean busy time of the workers over the largest, so 1 is a perfect balance
+ */
+inline double Scheduler::balance() const {
+    double total = 0.0, largest = 0.0;
+    for (const Utilization &u : utilization) {
+        total += u.busy;
+        largest = std::max(largest, u.busy);
+    }
+    return largest > 0.0 ? total / static_cast<double>(utilization.size()) / largest : 1.0;
+}
+
+#endif
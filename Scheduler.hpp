@@ -0,0 +1,88 @@
+/**********************************************************************************************************************
+ * Work-stealing scheduler for row ranges whose cost per row varies, e.g. books that mix closed form and numerical
+ * valuations
+ *
+ * @note Every worker owns a Chase-Lev deque of row ranges. A worker starts with its static share of the rows, splits its
+ * current range in halves down to a task size, pushes the upper halves onto the bottom of its deque, and runs the
+ * lower half. Idle workers steal from the top of other deques, which holds the largest halves, with a single compare
+ * and swap and no lock. The task size adapts to the measured cost per row of each worker, so cheap rows run in long
+ * tasks and expensive rows are split finely enough to be shared
+ *********************************************************************************************************************/
+
+#ifndef SCHEDULER_HPP
+#define SCHEDULER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Scheduler {
+public:
+    // Work done by one worker during the last run. Each entry fills a cache line, since every worker updates its own
+    struct alignas(64) Utilization {
+        std::size_t tasks;                       // Ranges run
+        std::size_t steals;                      // Ranges taken from other workers
+        std::size_t rows;                        // Rows run
+        double busy;                             // Seconds spent inside the range function
+    };
+
+private:
+    // Lock-free deque of row ranges. The owner pushes and pops at the bottom and thieves steal at the top
+    class Deque {
+    private:
+        static constexpr std::int64_t capacity = 128;
+
+        struct Slot {
+            std::atomic<std::size_t> first;
+            std::atomic<std::size_t> last;
+        };
+
+        Slot slots[capacity];
+        alignas(64) std::atomic<std::int64_t> top;
+        alignas(64) std::atomic<std::int64_t> bottom;
+
+    public:
+        Deque();
+
+        bool full() const;
+        void push(std::size_t first, std::size_t last);
+        bool pop(std::size_t& first, std::size_t& last);
+        bool steal(std::size_t& first, std::size_t& last);
+    };
+
+    std::size_t workers;                         // Number of worker threads
+    double target;                               // Target seconds per task
+    std::vector<Utilization> utilization;        // Work done by each worker during the last run
+    double elapsed;                              // Wall clock seconds of the last run
+
+public:
+    // Constructors and destructors
+    Scheduler();
+    Scheduler(const Scheduler& source);
+    explicit Scheduler(std::size_t workers_, double target_ = 50e-6);
+    virtual ~Scheduler();
+
+    // Operator overloading
+    Scheduler& operator=(const Scheduler& source);
+
+    // Invoke f(worker, first, last) over ranges that cover [0, n) exactly once, balancing the load by work stealing
+    template<typename Function>
+    void forRange(std::size_t n, Function f, std::size_t grain = 1);
+
+    // Invoke f(worker, i) once for every i in [0, n), e.g. one task per contract
+    template<typename Function>
+    void forEach(std::size_t n, Function f);
+
+    // Accessors
+    std::size_t threads() const;
+    const std::vector<Utilization>& stats() const;
+    double wall() const;
+    double balance() const;
+};
+
+#ifndef SCHEDULER_CPP
+#include "Scheduler.cpp"
+
+#endif // SCHEDULER_CPP
+#endif // SCHEDULER_HPP
@@ -0,0 +1,60 @@
+/**********************************************************************************************************************
+ * Local pricing daemon - Main entry point
+ *
+ * Usage: ServerMain [address] [maxBatch] [maxDelayMicros]
+ *     address         unix:<path> or tcp:<port>. Defaults to unix:/tmp/pricing-server.sock
+ *     maxBatch        Queued rows that trigger a batch before the delay expires. Defaults to 4096
+ *     maxDelayMicros  Longest time a request waits for other requests to join its batch. Defaults to 50
+ *********************************************************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "AmericanOption.hpp"
+#include "EuropeanOption.hpp"
+#include "Matrix.hpp"
+#include "Mesher.hpp"
+#include "Output.hpp"
+#include "PricingServer.hpp"
+#include "RNG.hpp"
+
+namespace {
+    std::atomic<bool> interrupted(false);
+
+    void onSignal(int) { interrupted = true; }
+}
+
+int main(int argc, char* argv[]) {
+
+    std::string address = argc > 1 ? argv[1] : "unix:/tmp/pricing-server.sock";
+    std::size_t maxBatch = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 4096;
+    std::size_t maxDelay = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 50;
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    PricingServer<EuropeanOption<Mesher, Matrix, RNG, Output>, AmericanOption<Mesher, Matrix, Output>>
+            server(address, maxBatch, maxDelay);
+    if (!server.start()) { return 1; }
+
+    std::cout << "Pricing server listening on " << address << std::endl;
+
+    // Report latency every five seconds until interrupted
+    auto next = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!interrupted) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        if (std::chrono::steady_clock::now() >= next) {
+            server.report(std::cout);
+            next += std::chrono::seconds(5);
+        }
+    }
+
+    server.stop();
+    server.report(std::cout);
+}
@@ -0,0 +1,279 @@
+/**********************************************************************************************************************
+ * Utility class for local stream sockets used by the pricing server and its clients
+ *********************************************************************************************************************/
+
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <iostream>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "Socket.hpp"
+
+namespace {
+
+    // Suppress SIGPIPE on writes to a peer that has disconnected
+#ifdef MSG_NOSIGNAL
+    const int sendFlags = MSG_NOSIGNAL;
+#else
+    const int sendFlags = 0;
+#endif
+
+    /*
+     * Split an address into its scheme ("unix" or "tcp") and location
+     */
+    bool parse(const std::string &address, std::string &scheme, std::string &location) {
+        std::size_t colon = address.find(':');
+        if (colon == std::string::npos) { return false; }
+
+        scheme = address.substr(0, colon);
+        location = address.substr(colon + 1);
+        return (scheme == "unix" || scheme == "tcp") && !location.empty();
+    }
+
+    /*
+     * Fill a Unix domain socket address
+     */
+    bool unixAddress(const std::string &path, sockaddr_un &addr) {
+        if (path.size() >= sizeof(addr.sun_path)) { return false; }
+
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+        return true;
+    }
+
+    /*
+     * Fill a loopback TCP socket address. The port must be a decimal number in [1, 65535] with nothing after it
+     */
+    bool tcpAddress(const std::string &port, sockaddr_in &addr) {
+        int number = 0;
+        const char *last = port.data() + port.size();
+        auto parsed = std::from_chars(port.data(), last, number);
+        if (parsed.ec != std::errc() || parsed.ptr != last || number < 1 || number > 65535) { return false; }
+
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = htons(static_cast<unsigned short>(number));
+        return true;
+    }
+
+    /*
+     * Remove a stale Unix domain socket file. Anything else at the path is left alone and fails the listen
+     */
+    bool unlinkSocket(const std::string &path) {
+        struct stat info{};
+        if (::lstat(path.c_str(), &info) != 0) { return errno == ENOENT; }
+        if (!S_ISSOCK(info.st_mode)) {
+            std::cout << path << " exists and is not a socket\n";
+            return false;
+        }
+        return ::unlink(path.c_str()) == 0 || errno == ENOENT;
+    }
+
+    /*
+     * Disable Nagle's algorithm so small responses are not delayed
+     */
+    void noDelay(int fd) {
+        int one = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+}
+
+/**
+ * Initialize a new Socket
+ * @throws OutOfMemoryError Indicates insufficient memory for this new Socket
+ */
+Socket::Socket() {}
+
+/**
+ * Initialize a new Socket
+ * @param source A Socket whose members will be used to initialize this new Socket
+ * @throws OutOfMemoryError Indicates insufficient memory for this new Socket
+ */
+Socket::Socket(const Socket &) {}
+
+/**
+ * Destroy this Socket
+ */
+Socket::~Socket() {}
+
+/**
+ * Deeply copy the source
+ * @param source A Socket whose members will be deeply copied into this Socket
+ * @return This Socket whose members are now a deep copy of the source members
+ */
+Socket & Socket::operator=(const Socket &source) {
+    // Avoid self assign
+    if (this == &source) { return *this; }
+
+    return *this;
+}
+
+/**
+ * Create a listening socket
+ * @note An existing Unix domain socket file at the same path is removed, but any other kind of file there fails the
+ * call. TCP ports must be in [1, 65535] and only bind to the loopback interface
+ * @param address "unix:<path>" or "tcp:<port>"
+ * @return A listening file descriptor, or -1 on failure
+ */
+int Socket::listen(const std::string &address) {
+
+    std::string scheme, location;
+    if (!parse(address, scheme, location)) {
+        std::cout << "Invalid address " << address << ". Expected unix:<path> or tcp:<port>\n";
+        return -1;
+    }
+
+    int fd = -1;
+    if (scheme == "unix") {
+        sockaddr_un addr{};
+        if (!unixAddress(location, addr) || !unlinkSocket(location)) { return -1; }
+
+        fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0 || ::bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0) {
+            close(fd);
+            return -1;
+        }
+    } else {
+        sockaddr_in addr{};
+        if (!tcpAddress(location, addr)) {
+            std::cout << "Invalid port " << location << ". Expected a number in [1, 65535]\n";
+            return -1;
+        }
+
+        fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        int one = 1;
+        ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        if (fd < 0 || ::bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0) {
+            close(fd);
+            return -1;
+        }
+    }
+
+    if (::listen(fd, SOMAXCONN) != 0) {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+/**
+ * Accept a connection on a listening socket
+ * @param listener A file descriptor created by Socket::listen
+ * @return A connected file descriptor, or -1 if the listener was shut down
+ */
+int Socket::accept(int listener) {
+    int fd;
+    do {
+        fd = ::accept(listener, nullptr, nullptr);
+    } while (fd < 0 && errno == EINTR);
+
+    if (fd >= 0) { noDelay(fd); }
+    return fd;
+}
+
+/**
+ * Connect to a listening socket
+ * @param address "unix:<path>" or "tcp:<port>"
+ * @return A connected file descriptor, or -1 on failure
+ */
+int Socket::connect(const std::string &address) {
+
+    std::string scheme, location;
+    if (!parse(address, scheme, location)) { return -1; }
+
+    int fd = -1;
+    if (scheme == "unix") {
+        sockaddr_un addr{};
+        if (!unixAddress(location, addr)) { return -1; }
+
+        fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0) {
+            close(fd);
+            return -1;
+        }
+    } else {
+        sockaddr_in addr{};
+        if (!tcpAddress(location, addr)) { return -1; }
+
+        fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0) {
+            close(fd);
+            return -1;
+        }
+        noDelay(fd);
+    }
+
+    return fd;
+}
+
+/**
+ * Shut down both directions of a socket without closing it. Blocked readers and acceptors on the socket return
+ * @param fd A file descriptor. Negative values are ignored
+ */
+void Socket::shutdown(int fd) {
+    if (fd < 0) { return; }
+
+    ::shutdown(fd, SHUT_RDWR);
+}
+
+/**
+ * Shut down and close a socket. Blocked readers and acceptors on the socket return
+ * @param fd A file descriptor. Negative values are ignored
+ */
+void Socket::close(int fd) {
+    if (fd < 0) { return; }
+
+    ::shutdown(fd, SHUT_RDWR);
+    ::close(fd);
+}
+
+/**
+ * Read exactly n bytes
+ * @param fd A connected file descriptor
+ * @param buffer Receives the bytes
+ * @param n Number of bytes to read
+ * @return True if every byte was read. False on error or end of stream
+ */
+bool Socket::read(int fd, void *buffer, std::size_t n) {
+    char *p = static_cast<char *>(buffer);
+    while (n > 0) {
+        ssize_t got = ::recv(fd, p, n, 0);
+        if (got < 0 && errno == EINTR) { continue; }
+        if (got <= 0) { return false; }
+
+        p += got;
+        n -= static_cast<std::size_t>(got);
+    }
+    return true;
+}
+
+/**
+ * Write exactly n bytes
+ * @param fd A connected file descriptor
+ * @param buffer The bytes to write
+ * @param n Number of bytes to write
+ * @return True if every byte was written. False on error
+ */
+bool Socket::write(int fd, const void *buffer, std::size_t n) {
+    const char *p = static_cast<const char *>(buffer);
+    while (n > 0) {
+        ssize_t sent = ::send(fd, p, n, sendFlags);
+        if (sent < 0 && errno == EINTR) { continue; }
+        if (sent <= 0) { return false; }
+
+        p += sent;
+        n -= static_cast<std::size_t>(sent);
+    }
+    return true;
+}
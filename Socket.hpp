@@ -0,0 +1,37 @@
+/**********************************************************************************************************************
+ * Utility class for local stream sockets used by the pricing server and its clients
+ *
+ * @note Addresses are either "unix:<path>" for a Unix domain socket or "tcp:<port>" for a socket bound to the
+ * loopback interface
+ *********************************************************************************************************************/
+
+#ifndef SOCKET_HPP
+#define SOCKET_HPP
+
+#include <cstddef>
+#include <string>
+
+class Socket {
+private:
+public:
+    // Constructors and destructors
+    Socket();
+    Socket(const Socket& source);
+    virtual ~Socket();
+
+    // Operator overloading
+    Socket& operator=(const Socket& source);
+
+    // Connection management. Each returns a file descriptor or -1 on failure
+    static int listen(const std::string& address);
+    static int accept(int listener);
+    static int connect(const std::string& address);
+    static void shutdown(int fd);
+    static void close(int fd);
+
+    // Blocking transfers that loop until every byte has been moved. Return false on error or end of stream
+    static bool read(int fd, void* buffer, std::size_t n);
+    static bool write(int fd, const void* buffer, std::size_t n);
+};
+
+#endif // SOCKET_HPP
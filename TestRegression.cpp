@@ -0,0 +1,323 @@
+/**********************************************************************************************************************
+ * Regression tests for the pricing engines
+ *********************************************************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "TestRegression.hpp"
+#include "ArbitrageScanner.hpp"
+#include "CarrMadan.hpp"
+#include "CharacteristicFunction.hpp"
+#include "COSPricer.hpp"
+#include "EuropeanOption.hpp"
+#include "HestonCalibrator.hpp"
+#include "LSMCEngine.hpp"
+#include "Matrix.hpp"
+#include "Mesher.hpp"
+#include "OptionBatch.hpp"
+#include "Output.hpp"
+#include "Portfolio.hpp"
+#include "RNG.hpp"
+
+namespace {
+    typedef EuropeanOption<Mesher, Matrix, RNG, Output> European;
+
+    /*
+     * Cox-Ross-Rubinstein binomial price of an American Put
+     * @param steps Number of time steps
+     * @return The American Put price
+     */
+    double binomialPut(double T, double sig, double r, double S, double K, double b, std::size_t steps) {
+        double dt = T / static_cast<double>(steps);
+        double up = std::exp(sig * std::sqrt(dt)), down = 1.0 / up;
+        double p = (std::exp(b * dt) - down) / (up - down);
+        double discount = std::exp(-r * dt);
+
+        std::vector<double> values(steps + 1);
+        for (std::size_t j = 0; j <= steps; ++j) {
+            double spot = S * std::pow(up, static_cast<double>(j)) * std::pow(down, static_cast<double>(steps - j));
+            values[j] = std::max(K - spot, 0.0);
+        }
+
+        for (std::size_t n = steps; n-- > 0;) {
+            for (std::size_t j = 0; j <= n; ++j) {
+                double spot = S * std::pow(up, static_cast<double>(j)) * std::pow(down, static_cast<double>(n - j));
+                double hold = discount * (p * values[j + 1] + (1.0 - p) * values[j]);
+                values[j] = std::max(hold, K - spot);
+            }
+        }
+
+        return values[0];
+    }
+
+    /*
+     * Largest difference between the cached prices and Greeks of an option and the static kernels
+     * @param option The option whose cache is checked
+     * @return 0 if every cached value matches its kernel bit for bit
+     */
+    double cacheError(const European &option) {
+        double T = option.expiry(), sig = option.vol(), r = option.riskFree();
+        double S = option.spot(), K = option.strike(), b = option.carry();
+
+        double call, put, callDelta, putDelta;
+        European::price(T, sig, r, S, K, b, call, put);
+        European::delta(T, sig, r, S, K, b, callDelta, putDelta);
+
+        std::vector<std::vector<double>> prices = option.price(), deltas = option.delta();
+        double error = 0.0;
+        error = std::max(error, std::abs(prices[0][0] - call));
+        error = std::max(error, std::abs(prices[0][1] - put));
+        error = std::max(error, std::abs(deltas[0][0] - callDelta));
+        error = std::max(error, std::abs(deltas[0][1] - putDelta));
+        error = std::max(error, std::abs(option.gamma() - European::gamma(T, sig, r, S, K, b)));
+        error = std::max(error, std::abs(option.vega() - European::vega(T, sig, r, S, K, b)));
+
+        return error;
+    }
+}
+
+/* ********************************************************************************************************************
+ * Constructors and destructors
+ *********************************************************************************************************************/
+
+/**
+ * Initialize a new TestRegression with no failures
+ */
+TestRegression::TestRegression() : failures(0) {}
+
+/**
+ * Destroy this TestRegression
+ */
+TestRegression::~TestRegression() {}
+
+/* ********************************************************************************************************************
+ * Tests
+ *********************************************************************************************************************/
+
+/*
+ * Print the result of a test and count it if it failed
+ * @param name Name of the test
+ * @param error Largest error of the test
+ * @param tolerance Largest error that passes
+ * @return True if the test passed
+ */
+bool TestRegression::report(const std::string &name, double error, double tolerance) {
+    bool passed = error <= tolerance;
+    if (!passed) {
+        ++failures;
+    }
+
+    std::cout << (passed ? "PASS " : "FAIL ") << name << ": error " << error << ", tolerance " << tolerance
+              << std::endl;
+    return passed;
+}
+
+/**
+ * Carr-Madan FFT Call prices of the Black-Scholes model against the closed form, on a strip from 50 to 200
+ * @return True if every price is within 1e-6
+ */
+bool TestRegression::carrMadan() {
+    double T = 0.5, sig = 0.25, r = 0.05, S = 100.0, b = 0.03;
+
+    CarrMadan<BlackScholesModel> engine{BlackScholesModel(sig)};
+    std::vector<double> strikes, prices;
+    engine.strip(T, r, S, b, 50.0, 200.0, strikes, prices);
+
+    double error = 0.0;
+    for (std::size_t i = 0; i < strikes.size(); ++i) {
+        double call, put;
+        European::price(T, sig, r, S, strikes[i], b, call, put);
+        error = std::max(error, std::abs(prices[i] - call));
+    }
+
+    return report("Carr-Madan vs Black-Scholes", error, 1e-6);
+}
+
+/**
+ * COS Call and Put prices of the Black-Scholes model against the closed form, from a week to five years
+ * @return True if every price is within 1e-8
+ */
+bool TestRegression::cos() {
+    double sig = 0.25, r = 0.05, S = 100.0, b = 0.03;
+
+    std::vector<double> strikes;
+    for (double K = 50.0; K <= 150.0; K += 0.5) {
+        strikes.push_back(K);
+    }
+
+    double error = 0.0;
+    for (double T : {0.02, 0.25, 1.0, 5.0}) {
+        COSPricer<BlackScholesModel, Mesher, Matrix, Output> engine(BlackScholesModel(sig), T, r, S, 100.0, b);
+        std::vector<double> calls, puts;
+        engine.price(T, r, S, b, strikes, calls, puts);
+
+        for (std::size_t i = 0; i < strikes.size(); ++i) {
+            double call, put;
+            European::price(T, sig, r, S, strikes[i], b, call, put);
+            error = std::max(error, std::max(std::abs(calls[i] - call), std::abs(puts[i] - put)));
+        }
+    }
+
+    return report("COS vs Black-Scholes", error, 1e-8);
+}
+
+/**
+ * Calibrate the Heston model to a surface priced from known parameters, starting from a distant guess
+ * @return True if every parameter is recovered within 1e-3
+ */
+bool TestRegression::hestonRoundTrip() {
+    double r = 0.03, S = 100.0, b = 0.01;
+    HestonModel truth(0.035, 2.0, 0.045, 0.55, -0.7);
+
+    OptionBatch surface;
+    std::vector<double> prices;
+    std::vector<Portfolio::OptionType> types;
+    COSPricer<HestonModel, Mesher, Matrix, Output> engine(truth, 1.0, r, S, 100.0, b, 256);
+
+    for (double T : {0.1, 0.25, 0.5, 1.0, 2.0, 3.0}) {
+        std::vector<double> strikes;
+        for (double K = 70.0; K <= 130.0; K += 5.0) {
+            strikes.push_back(K);
+        }
+
+        std::vector<double> calls, puts;
+        engine.price(T, r, S, b, strikes, calls, puts);
+        for (std::size_t i = 0; i < strikes.size(); ++i) {
+            bool call = strikes[i] >= S;
+            surface.push_back(T, 0.0, r, S, strikes[i], b);
+            prices.push_back(call ? calls[i] : puts[i]);
+            types.push_back(call ? Portfolio::OptionType::Call : Portfolio::OptionType::Put);
+        }
+    }
+
+    HestonCalibrator calibrator(surface, prices, types);
+    calibrator.calibrate(HestonModel(0.06, 1.0, 0.06, 0.3, -0.3));
+    const HestonModel &fitted = calibrator.fitted();
+
+    double error = 0.0;
+    error = std::max(error, std::abs(fitted.initialVariance() - truth.initialVariance()));
+    error = std::max(error, std::abs(fitted.reversion() - truth.reversion()));
+    error = std::max(error, std::abs(fitted.longRunVariance() - truth.longRunVariance()));
+    error = std::max(error, std::abs(fitted.volOfVol() - truth.volOfVol()));
+    error = std::max(error, std::abs(fitted.correlation() - truth.correlation()));
+
+    return report("Heston calibration round trip", error, 1e-3);
+}
+
+/**
+ * Longstaff-Schwartz American Put with 50 exercise dates against a 2000 step binomial tree, for spots in and out of
+ * the money
+ * @note The error is the distance from the tree beyond three standard errors. It may be up to 0.02, which covers the
+ * early exercise premium lost between exercise dates and the low bias of the regression
+ * @return True if every price is within tolerance
+ */
+bool TestRegression::lsmcAmericanPut() {
+    double sig = 0.2, r = 0.06, K = 40.0, T = 1.0;
+
+    double error = 0.0;
+    for (double S : {36.0, 40.0, 44.0}) {
+        LSMCEngine<RNG> engine({S}, {sig}, {r}, {{1.0}}, r, LSMCEngine<RNG>::schedule(T, 50));
+        engine.simulation(20000, 100000, 2048, 7);
+        double value = engine.price([K](const double *spots) { return std::max(K - spots[0], 0.0); });
+
+        double reference = binomialPut(T, sig, r, S, K, r, 2000);
+        error = std::max(error, std::abs(value - reference) - 3.0 * engine.error());
+    }
+
+    return report("LSMC vs binomial American Put", error, 0.02);
+}
+
+/**
+ * Cached prices and Greeks of an EuropeanOption against the static kernels after construction and after every mutator
+ * @return True if every cached value matches bit for bit
+ */
+bool TestRegression::europeanCache() {
+    European option(0.5, 0.3, 0.08, 60.0, 65.0, 0.08);
+    double error = cacheError(option);
+
+    option.expiry(1.25);
+    error = std::max(error, cacheError(option));
+    option.vol(0.22);
+    error = std::max(error, cacheError(option));
+    option.riskFree(0.03);
+    error = std::max(error, cacheError(option));
+    option.spot(70.0);
+    error = std::max(error, cacheError(option));
+    option.strike(55.0);
+    error = std::max(error, cacheError(option));
+    option.carry(0.01);
+    error = std::max(error, cacheError(option));
+    option.setOptionData(0.25, 0.35, 0.05, 100.0, 100.0, 0.0);
+    error = std::max(error, cacheError(option));
+
+    European copy(option);
+    error = std::max(error, cacheError(copy));
+
+    return report("EuropeanOption cache vs static kernels", error, 0.0);
+}
+
+/**
+ * Scan a Black-Scholes grid of 20 expiries and 200 strikes, which is free of static arbitrage, then plant a butterfly
+ * violation
+ * @return True if the grid has no violations and the planted one is found
+ */
+bool TestRegression::arbitrageFreeGrid() {
+    ArbitrageScanner::Quotes quotes;
+    quotes.S = 100.0;
+    quotes.r = 0.03;
+    quotes.b = 0.01;
+
+    for (std::size_t e = 0; e < 20; ++e) {
+        double T = 0.05 + 0.1 * static_cast<double>(e);
+        for (std::size_t k = 0; k < 200; ++k) {
+            double K = 50.0 + 0.5 * static_cast<double>(k);
+            double call, put;
+            European::price(T, 0.25, quotes.r, quotes.S, K, quotes.b, call, put);
+            quotes.T.push_back(T);
+            quotes.K.push_back(K);
+            quotes.call.push_back(call);
+            quotes.put.push_back(put);
+        }
+    }
+
+    ArbitrageScanner scanner(1e-8);
+    double found = static_cast<double>(scanner.scan(quotes));
+    bool clean = report("ArbitrageScanner on an arbitrage free grid", found, 0.0);
+
+    // Raise the Call at the middle strike of the sixth expiry above its neighbors
+    quotes.call[5 * 200 + 100] += 0.5;
+    scanner.scan(quotes);
+    double missed = scanner.count(ArbitrageScanner::Check::Butterfly) == 0 ? 1.0 : 0.0;
+    bool planted = report("ArbitrageScanner finds a planted butterfly", missed, 0.0);
+
+    return clean && planted;
+}
+
+/**
+ * Run every test
+ * @return The number of failed tests
+ */
+std::size_t TestRegression::run() {
+    carrMadan();
+    cos();
+    hestonRoundTrip();
+    lsmcAmericanPut();
+    europeanCache();
+    arbitrageFreeGrid();
+    return failures;
+}
+
+/* ********************************************************************************************************************
+ * Accessors
+ *********************************************************************************************************************/
+
+/**
+ * Accessor that retrieves the number of failed tests
+ * @return The number of failed tests so far
+ */
+std::size_t TestRegression::failed() const {
+    return failures;
+}
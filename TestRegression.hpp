@@ -0,0 +1,40 @@
+/**********************************************************************************************************************
+ * Regression tests for the pricing engines
+ *
+ * @note Each test compares an engine with an independent reference, prints one line with its largest error, and
+ * returns whether the error is within tolerance:
+ * - Carr-Madan FFT and COS strike strips of the Black-Scholes model against the closed form
+ * - Heston calibration recovering the parameters that generated a synthetic surface
+ * - Least-squares Monte Carlo American Put against a binomial tree
+ * - Cached EuropeanOption prices and Greeks against the static kernels, bit for bit, across every mutator
+ * - ArbitrageScanner finding nothing on a Black-Scholes grid, and finding a planted violation
+ *********************************************************************************************************************/
+
+#ifndef TESTREGRESSION_HPP
+#define TESTREGRESSION_HPP
+
+#include <cstddef>
+#include <string>
+
+class TestRegression {
+private:
+    std::size_t failures;                        // Number of failed tests
+
+    bool report(const std::string& name, double error, double tolerance);
+
+public:
+    TestRegression();
+    virtual ~TestRegression();
+
+    bool carrMadan();
+    bool cos();
+    bool hestonRoundTrip();
+    bool lsmcAmericanPut();
+    bool europeanCache();
+    bool arbitrageFreeGrid();
+
+    std::size_t run();
+    std::size_t failed() const;
+};
+
+#endif // TESTREGRESSION_HPP
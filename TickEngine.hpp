@@ -0,0 +1,127 @@
+/**********************************************************************************************************************
+ * Tick-driven incremental repricing of the European positions of a Portfolio, keyed by underlying
+ *
+ * @note Contracts are indexed by underlying and stored as a structure of arrays per underlying, together with every
+ * term that does not depend on the spot: K e^(-rT), e^((b-r)T), sig sqrt(T), and (b + sig^2 / 2) T - log K. A spot
+ * tick then costs one log for the underlying, and one exp and two erfc per dependent contract. An opt-in approximate
+ * loop vectorizes instead, with one exp per contract, since N(d2) reuses n(d1) through S e^((b-r)T) n(d1) =
+ * K e^(-rT) n(d2). A vol tick refreshes the volatility terms of its underlying only. Ticks arrive
+ * through a lock-free RingQueue from any number of feed handler threads. The pricing thread drains every queued tick
+ * before it reprices, so ticks that arrive while a repricing is in flight coalesce into one repricing per underlying
+ *********************************************************************************************************************/
+
+#ifndef TICKENGINE_HPP
+#define TICKENGINE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "LatencyStats.hpp"
+#include "Portfolio.hpp"
+#include "RingQueue.hpp"
+
+class TickEngine {
+public:
+    enum class Field : unsigned char { Spot, Vol };
+
+    // A market data update for one underlying
+    struct Tick {
+        std::uint32_t underlying;                // Underlying id in the Portfolio
+        Field field;                             // Spot price, or volatility shift from the subscribed volatilities
+        double value;                            // New spot, or absolute volatility shift
+        std::chrono::steady_clock::time_point received; // Time the feed handler saw the update
+    };
+
+    // Unit prices and Greeks of the contracts on one underlying, and their quantity weighted totals
+    struct Greeks {
+        std::vector<std::size_t> positions;      // Row of each contract in the Portfolio
+        std::vector<double> price;
+        std::vector<double> delta;
+        std::vector<double> gamma;
+        std::vector<double> vega;
+        double pv, totalDelta, totalGamma, totalVega;
+    };
+
+    typedef std::function<void(std::size_t underlying, const Greeks& greeks)> Listener;
+
+private:
+    // Contracts of one underlying with their spot independent terms
+    struct Book {
+        double S;                                // Last spot
+        double shift;                            // Last volatility shift
+        bool dirty;                              // A tick arrived since the last repricing
+        std::chrono::steady_clock::time_point oldest; // Receipt time of the oldest coalesced tick
+
+        std::vector<double> sig, sqrtT, b, logK; // Subscribed contract data
+        std::vector<double> discount;            // K e^(-rT)
+        std::vector<double> invDiscount;         // 1 / (K e^(-rT))
+        std::vector<double> carry;               // e^((b-r)T)
+        std::vector<double> vst;                 // sig sqrt(T)
+        std::vector<double> inverse;             // 1 / (sig sqrt(T))
+        std::vector<double> offset;              // (b + sig^2 / 2) T - log K
+        std::vector<double> isPut;               // 1 for Puts and 0 for Calls
+        std::vector<double> quantity;            // Signed number of contracts held
+
+        Greeks greeks;                           // Result of the last repricing
+    };
+
+    std::vector<Book> books;                     // One book per underlying id
+    RingQueue<Tick> queue;                       // Ticks from the feed handlers
+    Listener listener;                           // Called on the pricing thread after every repricing
+    bool fast;                                   // Reprice with the vectorized approximations of N and exp
+
+    std::atomic<bool> running;
+    std::thread pricer;
+
+    LatencyStats latency;                        // Oldest coalesced tick to published Greeks
+    std::vector<double> pending;                 // Latencies of the current poll, recorded under one lock
+    std::atomic<std::uint64_t> tickCount;
+    std::atomic<std::uint64_t> repriceCount;
+
+    // Helper functions
+    static void refresh(Book& book);
+    static void reprice(Book& book, bool fast);
+    void pricingLoop();
+
+public:
+    // Constructors and destructors
+    explicit TickEngine(std::size_t capacity = 65536);
+    TickEngine(const Portfolio& portfolio, std::size_t capacity = 65536);
+    TickEngine(const TickEngine& source) = delete;
+    virtual ~TickEngine();
+
+    // Operator overloading
+    TickEngine& operator=(const TickEngine& source) = delete;
+
+    // Index the European positions of a book by underlying and price them at their subscribed spots
+    void subscribe(const Portfolio& portfolio);
+    void listen(const Listener& listener_);
+    void approximate(bool fast_);
+
+    // Feed handler side. Safe from any number of threads. Returns false if the queue is full
+    bool publish(std::size_t underlying, Field field, double value);
+    bool publish(const Tick& tick);
+
+    // Pricing side. Either poll on a thread of your own or start the pricing thread
+    std::size_t poll();
+    void start();
+    void stop();
+
+    // Results. Only safe while the pricing thread is stopped, or from inside the listener
+    std::size_t underlyings() const;
+    const Greeks& greeks(std::size_t underlying) const;
+
+    // Statistics
+    std::uint64_t ticks() const;
+    std::uint64_t reprices() const;
+    std::vector<double> percentiles() const;
+    void report(std::ostream& out);
+};
+
+#endif // TICKENGINE_HPP
@@ -0,0 +1,401 @@
+/**********************************************************************************************************************
+ * Value at Risk and Expected Shortfall over a Portfolio using historical or Monte Carlo market scenarios
+ *********************************************************************************************************************/
+
+#ifndef VARENGINE_CPP
+#define VARENGINE_CPP
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include "VaREngine.hpp"
+#include "Cholesky.hpp"
+#include "Parallel.hpp"
+
+/**
+ * Initialize a new VaREngine that fully revalues the portfolio under every scenario
+ * @tparam European_ Pricing engine for European positions (e.g. EuropeanOption<Mesher, Matrix, RNG, Output>)
+ * @tparam American_ Pricing engine for perpetual American positions (e.g. AmericanOption<Mesher, Matrix, Output>)
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @throws OutOfMemoryError Indicates insufficient memory for this new VaREngine
+ */
+template<typename European_, typename American_, typename RNG_>
+VaREngine<European_, American_, RNG_>::VaREngine() : mode(Mode::FullRevaluation), greeks() {}
+
+/**
+ * Initialize a new VaREngine whose data members are a deep copy of the source
+ * @tparam European_ Pricing engine for European positions
+ * @tparam American_ Pricing engine for perpetual American positions
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @param source A VaREngine whose data members will be deeply copied
+ * @throws OutOfMemoryError Indicates insufficient memory for this new VaREngine
+ */
+template<typename European_, typename American_, typename RNG_>
+VaREngine<European_, American_, RNG_>::VaREngine(const VaREngine<European_, American_, RNG_> &source) :
+mode(source.mode), greeks(source.greeks) {}
+
+/**
+ * Initialize a new VaREngine with the specified revaluation mode
+ * @tparam European_ Pricing engine for European positions
+ * @tparam American_ Pricing engine for perpetual American positions
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @param mode_ Full revaluation or delta-gamma approximation
+ * @throws OutOfMemoryError Indicates insufficient memory for this new VaREngine
+ */
+template<typename European_, typename American_, typename RNG_>
+VaREngine<European_, American_, RNG_>::VaREngine(Mode mode_) : mode(mode_), greeks() {}
+
+/**
+ * Destroy this VaREngine
+ * @tparam European_ Pricing engine for European positions
+ * @tparam American_ Pricing engine for perpetual American positions
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ */
+template<typename European_, typename American_, typename RNG_>
+VaREngine<European_, American_, RNG_>::~VaREngine() {}
+
+/**
+ * Deeply copy the source data members into this VaREngine
+ * @tparam European_ Pricing engine for European positions
+ * @tparam American_ Pricing engine for perpetual American positions
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @param source A VaREngine whose data members will be deeply copied
+ * @return This VaREngine whose data members are a deep copy of the source data members
+ */
+template<typename European_, typename American_, typename RNG_>
+VaREngine<European_, American_, RNG_>&
+VaREngine<European_, American_, RNG_>::operator=(const VaREngine<European_, American_, RNG_> &source) {
+    // Avoid self assign
+    if (this == &source) { return *this; }
+
+    mode = source.mode;
+    greeks = source.greeks;
+
+    return *this;
+}
+
+/* ********************************************************************************************************************
+ * Scenario generation
+ *********************************************************************************************************************/
+
+/**
+ * Simulate correlated one period spot returns for every underlying
+ * @note Variates are generated in fixed blocks of scenarios, each with its own seed, so the result does not depend on
+ * the number of threads
+ * @tparam European_ Pricing engine for European positions
+ * @tparam American_ Pricing engine for perpetual American positions
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @param n Number of scenarios
+ * @param vols Volatility of the return of each underlying over the VaR horizon
+ * @param correlation Correlation matrix of the underlyings
+ * @param seed Seed for the Mersenne Twister
+ * @return A matrix with one row per scenario and one relative spot return per underlying
+ * @throws std::invalid_argument If the correlation matrix is not m x m or is not positive definite
+ */
+template<typename European_, typename American_, typename RNG_>
+std::vector<std::vector<double>>
+VaREngine<European_, American_, RNG_>::simulate(std::size_t n, const std::vector<double> &vols,
+        const std::vector<std::vector<double>> &correlation, unsigned int seed) {
+
+    std::size_t m = vols.size();
+    if (correlation.size() != m) {
+        throw std::invalid_argument("The correlation matrix must have one row per volatility");
+    }
+    for (const std::vector<double> &row : correlation) {
+        if (row.size() != m) {
+            throw std::invalid_argument("The correlation matrix must have one column per volatility");
+        }
+    }
+
+    // Cholesky factor of the correlation matrix
+    std::vector<std::vector<double>> L = Cholesky::factor(correlation);
+
+    std::vector<std::vector<double>> returns(n, std::vector<double>(m, 0.0));
+
+    const std::size_t block = 4096;
+    std::size_t blocks = (n + block - 1) / block;
+
+    Parallel::forRange(blocks, [&](std::size_t, std::size_t first, std::size_t last) {
+        std::vector<double> z;
+        for (std::size_t k = first; k < last; ++k) {
+            std::size_t s0 = k * block, s1 = std::min(n, s0 + block);
+
+            z.resize((s1 - s0) * m);
+            RNG_::MersenneTwister(z, seed + static_cast<unsigned int>(k));
+
+            for (std::size_t s = s0; s < s1; ++s) {
+                const double *zs = z.data() + (s - s0) * m;
+                for (std::size_t u = 0; u < m; ++u) {
+                    double x = 0.0;
+                    for (std::size_t v = 0; v <= u; ++v) {
+                        x += L[u][v] * zs[v];
+                    }
+                    returns[s][u] = vols[u] * x;
+                }
+            }
+        }
+    }, 1);
+
+    return returns;
+}
+
+/* ********************************************************************************************************************
+ * Core risk functions
+ *********************************************************************************************************************/
+
+/**
+ * Portfolio PnL under every scenario using the revaluation mode of this VaREngine
+ * @tparam European_ Pricing engine for European positions
+ * @tparam American_ Pricing engine for perpetual American positions
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @param portfolio The book to revalue
+ * @param returns A matrix with one row per scenario and one relative spot return per underlying
+ * @param volChanges A matrix with one row per scenario and one absolute volatility change per underlying. May be empty
+ * @return One PnL per scenario
+ * @throws std::invalid_argument If a scenario has fewer columns than the portfolio has underlyings, or if volChanges
+ * is neither empty nor one row per scenario
+ */
+template<typename European_, typename American_, typename RNG_>
+std::vector<double>
+VaREngine<European_, American_, RNG_>::pnl(const Portfolio &portfolio, const std::vector<std::vector<double>> &returns,
+        const std::vector<std::vector<double>> &volChanges) const {
+    std::size_t m = portfolio.underlyings();
+    if (!volChanges.empty() && volChanges.size() != returns.size()) {
+        throw std::invalid_argument("Volatility changes must be empty or have one row per scenario");
+    }
+    for (std::size_t s = 0; s < returns.size(); ++s) {
+        if (returns[s].size() < m || (!volChanges.empty() && volChanges[s].size() < m)) {
+            throw std::invalid_argument("Each scenario needs one column per underlying in the portfolio");
+        }
+    }
+
+    return mode == Mode::DeltaGamma ? deltaGamma(portfolio, returns, volChanges)
+                                    : fullRevaluation(portfolio, returns, volChanges);
+}
+
+/*
+ * Helper function that fully reprices every position under every scenario
+ * @note Each thread owns a contiguous range of scenarios and walks it in small blocks. The positions are streamed once
+ * per block and the PnL of the block is accumulated in a per-thread buffer
+ * @tparam European_ Pricing engine for European positions
+ * @tparam American_ Pricing engine for perpetual American positions
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @param portfolio The book to revalue
+ * @param returns A matrix with one row per scenario and one relative spot return per underlying
+ * @param volChanges A matrix with one row per scenario and one absolute volatility change per underlying. May be empty
+ * @return One PnL per scenario
+ */
+template<typename European_, typename American_, typename RNG_>
+std::vector<double>
+VaREngine<European_, American_, RNG_>::fullRevaluation(const Portfolio &portfolio,
+        const std::vector<std::vector<double>> &returns, const std::vector<std::vector<double>> &volChanges) const {
+
+    std::size_t n = returns.size();
+    std::size_t positions = portfolio.size();
+
+    const OptionBatch &options = portfolio.options();
+    const double *T_ = options.expiry().data(), *sig_ = options.vol().data(), *r_ = options.riskFree().data();
+    const double *S_ = options.spot().data(), *K_ = options.strike().data(), *b_ = options.carry().data();
+    const std::vector<double> &quantity = portfolio.quantity();
+    const std::vector<std::size_t> &underlying = portfolio.underlying();
+
+    // Unit value of every position in the unshocked market
+    std::vector<double> base(positions);
+    Parallel::forDynamic(positions, [&](std::size_t, std::size_t first, std::size_t last) {
+        double call, put;
+        for (std::size_t i = first; i < last; ++i) {
+            if (portfolio.style()[i] == Portfolio::ExerciseStyle::European) {
+                European_::price(T_[i], sig_[i], r_[i], S_[i], K_[i], b_[i], call, put);
+            } else {
+                American_::price(sig_[i], r_[i], S_[i], K_[i], b_[i], call, put);
+            }
+            base[i] = portfolio.type()[i] == Portfolio::OptionType::Call ? call : put;
+        }
+    });
+
+    std::vector<double> result(n, 0.0);
+
+    Parallel::forRange(n, [&](std::size_t, std::size_t first, std::size_t last) {
+        const std::size_t block = 64;
+        double acc[block];
+
+        for (std::size_t s0 = first; s0 < last; s0 += block) {
+            std::size_t s1 = std::min(last, s0 + block);
+            std::fill(acc, acc + block, 0.0);
+
+            for (std::size_t i = 0; i < positions; ++i) {
+                std::size_t u = underlying[i];
+                bool isCall = portfolio.type()[i] == Portfolio::OptionType::Call;
+                bool isEuropean = portfolio.style()[i] == Portfolio::ExerciseStyle::European;
+                double q = quantity[i];
+
+                for (std::size_t s = s0; s < s1; ++s) {
+                    double S = S_[i] * (1.0 + returns[s][u]);
+                    double sig = volChanges.empty() ? sig_[i] : std::max(sig_[i] + volChanges[s][u], 1e-8);
+
+                    double call, put;
+                    if (isEuropean) {
+                        European_::price(T_[i], sig, r_[i], S, K_[i], b_[i], call, put);
+                    } else {
+                        American_::price(sig, r_[i], S, K_[i], b_[i], call, put);
+                    }
+                    acc[s - s0] += q * ((isCall ? call : put) - base[i]);
+                }
+            }
+
+            std::copy(acc, acc + (s1 - s0), result.begin() + s0);
+        }
+    }, 64);
+
+    return result;
+}
+
+/*
+ * Helper function that approximates the PnL of every scenario with a second order Taylor expansion in spot and a first
+ * order expansion in volatility
+ * @note Sensitivities are aggregated once per underlying as dollar delta (sum of q * Delta * S), dollar gamma (sum of
+ * q * Gamma * S^2), and vega. Each scenario then costs O(number of underlyings)
+ * @tparam European_ Pricing engine for European positions
+ * @tparam American_ Pricing engine for perpetual American positions
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @param portfolio The book to revalue
+ * @param returns A matrix with one row per scenario and one relative spot return per underlying
+ * @param volChanges A matrix with one row per scenario and one absolute volatility change per underlying. May be empty
+ * @return One PnL per scenario
+ */
+template<typename European_, typename American_, typename RNG_>
+std::vector<double>
+VaREngine<European_, American_, RNG_>::deltaGamma(const Portfolio &portfolio,
+        const std::vector<std::vector<double>> &returns, const std::vector<std::vector<double>> &volChanges) const {
+
+    std::size_t m = portfolio.underlyings();
+    std::size_t n = returns.size();
+
+    // One accumulation buffer per worker. Each underlying has three consecutive slots
+    std::vector<std::vector<double>> partials(Parallel::threads(), std::vector<double>(3 * m, 0.0));
+
+    const std::vector<double> &spot = portfolio.options().spot();
+    const std::vector<double> &quantity = portfolio.quantity();
+    const std::vector<std::size_t> &underlying = portfolio.underlying();
+    double h = greeks.spotDifference(), hSig = greeks.volDifference();
+
+    Parallel::forDynamic(portfolio.size(), [&](std::size_t worker, std::size_t first, std::size_t last) {
+        double *acc = partials[worker].data();
+        double pv, delta, gamma, vega;
+        for (std::size_t i = first; i < last; ++i) {
+            PortfolioEngine<European_, American_>::risk(portfolio, i, h, hSig, pv, delta, gamma, vega);
+
+            double q = quantity[i], S = spot[i];
+            double *slot = acc + 3 * underlying[i];
+            slot[0] += q * delta * S;
+            slot[1] += q * gamma * S * S;
+            slot[2] += q * vega;
+        }
+    });
+
+    std::vector<double> sensitivities(3 * m, 0.0);
+    for (const auto &partial : partials) {
+        for (std::size_t k = 0; k < 3 * m; ++k) {
+            sensitivities[k] += partial[k];
+        }
+    }
+
+    std::vector<double> result(n, 0.0);
+
+    Parallel::forRange(n, [&](std::size_t, std::size_t first, std::size_t last) {
+        for (std::size_t s = first; s < last; ++s) {
+            double value = 0.0;
+            for (std::size_t u = 0; u < m; ++u) {
+                double ret = returns[s][u];
+                double dSig = volChanges.empty() ? 0.0 : volChanges[s][u];
+                value += sensitivities[3 * u] * ret + 0.5 * sensitivities[3 * u + 1] * ret * ret
+                        + sensitivities[3 * u + 2] * dSig;
+            }
+            result[s] = value;
+        }
+    });
+
+    return result;
+}
+
+/**
+ * Value at Risk and Expected Shortfall of a PnL distribution
+ * @note The tail is located with std::nth_element, which runs in linear time on average
+ * @tparam European_ Pricing engine for European positions
+ * @tparam American_ Pricing engine for perpetual American positions
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @param pnl One PnL per scenario. Taken by value because the selection reorders it
+ * @param confidence Confidence level (e.g. 0.99)
+ * @return A vector with the VaR and the Expected Shortfall, both reported as positive losses
+ */
+template<typename European_, typename American_, typename RNG_>
+std::vector<double> VaREngine<European_, American_, RNG_>::measure(std::vector<double> pnl, double confidence) {
+
+    if (pnl.empty()) { return {0.0, 0.0}; }
+
+    // Number of scenarios in the loss tail
+    std::size_t tail = static_cast<std::size_t>(std::ceil((1.0 - confidence) * pnl.size()));
+    tail = std::min(std::max<std::size_t>(tail, 1), pnl.size());
+
+    auto k = pnl.begin() + (tail - 1);
+    std::nth_element(pnl.begin(), k, pnl.end());
+
+    // Every element before k is no greater than k, so the tail is [begin, k]
+    double sum = 0.0;
+    for (auto it = pnl.begin(); it <= k; ++it) {
+        sum += *it;
+    }
+
+    return {-*k, -sum / tail};
+}
+
+/**
+ * Value at Risk and Expected Shortfall of a Portfolio
+ * @tparam European_ Pricing engine for European positions
+ * @tparam American_ Pricing engine for perpetual American positions
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @param portfolio The book to revalue
+ * @param returns A matrix with one row per scenario and one relative spot return per underlying
+ * @param volChanges A matrix with one row per scenario and one absolute volatility change per underlying. May be empty
+ * @param confidence Confidence level (e.g. 0.99)
+ * @return A vector with the VaR and the Expected Shortfall, both reported as positive losses
+ * @throws std::invalid_argument If the scenarios do not cover every underlying in the portfolio
+ */
+template<typename European_, typename American_, typename RNG_>
+std::vector<double>
+VaREngine<European_, American_, RNG_>::run(const Portfolio &portfolio, const std::vector<std::vector<double>> &returns,
+        const std::vector<std::vector<double>> &volChanges, double confidence) const {
+    return measure(pnl(portfolio, returns, volChanges), confidence);
+}
+
+/* ********************************************************************************************************************
+ * Accessors
+ *********************************************************************************************************************/
+
+/**
+ * Accessor that retrieves the revaluation mode of this VaREngine
+ * @tparam European_ Pricing engine for European positions
+ * @tparam American_ Pricing engine for perpetual American positions
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @return Full revaluation or delta-gamma approximation
+ */
+template<typename European_, typename American_, typename RNG_>
+typename VaREngine<European_, American_, RNG_>::Mode VaREngine<European_, American_, RNG_>::revaluation() const {
+    return mode;
+}
+
+/* ********************************************************************************************************************
+ * Mutators
+ *********************************************************************************************************************/
+
+/**
+ * Mutator that sets the revaluation mode of this VaREngine
+ * @tparam European_ Pricing engine for European positions
+ * @tparam American_ Pricing engine for perpetual American positions
+ * @tparam RNG_ Provides access to the Boost Random library to generate Gaussian variates
+ * @param mode_ Full revaluation or delta-gamma approximation
+ */
+template<typename European_, typename American_, typename RNG_>
+void VaREngine<European_, American_, RNG_>::revaluation(Mode mode_) { mode = mode_; }
+
+#endif
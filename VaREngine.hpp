@@ -0,0 +1,69 @@
+/**********************************************************************************************************************
+ * Value at Risk and Expected Shortfall over a Portfolio using historical or Monte Carlo market scenarios
+ *
+ * @note A host class for the European and American pricing engines and the RNG policy. Scenarios are partitioned
+ * across threads and quantiles are found with a linear time selection rather than a full sort
+ *********************************************************************************************************************/
+
+#ifndef VARENGINE_HPP
+#define VARENGINE_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "Portfolio.hpp"
+#include "PortfolioEngine.hpp"
+
+template<typename European_, typename American_, typename RNG_>
+class VaREngine {
+public:
+    enum class Mode : unsigned char { FullRevaluation, DeltaGamma };
+
+private:
+    Mode mode;                                   // Full revaluation or delta-gamma approximation
+    PortfolioEngine<European_, American_> greeks; // Sensitivities for the delta-gamma approximation
+
+    // Helper functions for each revaluation mode
+    std::vector<double> fullRevaluation(const Portfolio& portfolio, const std::vector<std::vector<double>>& returns,
+                                        const std::vector<std::vector<double>>& volChanges) const;
+    std::vector<double> deltaGamma(const Portfolio& portfolio, const std::vector<std::vector<double>>& returns,
+                                   const std::vector<std::vector<double>>& volChanges) const;
+
+public:
+    // Constructors and destructors
+    VaREngine();
+    VaREngine(const VaREngine& source);
+    explicit VaREngine(Mode mode_);
+    virtual ~VaREngine();
+
+    // Operator overloading
+    VaREngine& operator=(const VaREngine& source);
+
+    // Simulate correlated spot returns for every underlying
+    static std::vector<std::vector<double>> simulate(std::size_t n, const std::vector<double>& vols,
+                                                     const std::vector<std::vector<double>>& correlation,
+                                                     unsigned int seed);
+
+    // Portfolio PnL under every scenario
+    std::vector<double> pnl(const Portfolio& portfolio, const std::vector<std::vector<double>>& returns,
+                            const std::vector<std::vector<double>>& volChanges) const;
+
+    // Value at Risk and Expected Shortfall of a PnL distribution
+    static std::vector<double> measure(std::vector<double> pnl, double confidence);
+
+    // Value at Risk and Expected Shortfall of a Portfolio
+    std::vector<double> run(const Portfolio& portfolio, const std::vector<std::vector<double>>& returns,
+                            const std::vector<std::vector<double>>& volChanges, double confidence) const;
+
+    // Accessors
+    Mode revaluation() const;
+
+    // Mutators
+    void revaluation(Mode mode_);
+};
+
+#ifndef VARENGINE_CPP
+#include "VaREngine.cpp"
+
+#endif // VARENGINE_CPP
+#endif // VARENGINE_HPP
@@ -0,0 +1,266 @@
+/**********************************************************************************************************************
+ * Implied volatility surface of SVI or grid slices with batch lookups that resolve the volatility column of an
+ * OptionBatch
+ *********************************************************************************************************************/
+
+#ifndef VOLSURFACE_CPP
+#define VOLSURFACE_CPP
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "VolSurface.hpp"
+
+/**
+ * Initialize a new VolSurface with no slices
+ * @throws OutOfMemoryError Indicates insufficient memory for this new VolSurface
+ */
+inline VolSurface::VolSurface() : slices(), knots(), intercepts(), slopes() {}
+
+/**
+ * Initialize a new VolSurface whose data members are a copy of the source
+ * @param source A VolSurface whose data members will be copied
+ * @throws OutOfMemoryError Indicates insufficient memory for this new VolSurface
+ */
+inline VolSurface::VolSurface(const VolSurface &source) : slices(source.slices), knots(source.knots),
+intercepts(source.intercepts), slopes(source.slopes) {}
+
+/**
+ * Destroy this VolSurface
+ */
+inline VolSurface::~VolSurface() {}
+
+/**
+ * Copy the source data members into this VolSurface
+ * @param source A VolSurface whose data members will be copied
+ * @return This VolSurface whose data members are a copy of the source data members
+ */
+inline VolSurface& VolSurface::operator=(const VolSurface &source) {
+    // Avoid self assign
+    if (this == &source) { return *this; }
+
+    slices = source.slices;
+    knots = source.knots;
+    intercepts = source.intercepts;
+    slopes = source.slopes;
+
+    return *this;
+}
+
+/* ********************************************************************************************************************
+ * Slices
+ *********************************************************************************************************************/
+
+/**
+ * Add a slice from raw SVI parameters
+ * @param T Expiry of the slice. Must be positive
+ * @param a Level of the total variance
+ * @param b Angle between the wings
+ * @param rho Rotation, in (-1, 1)
+ * @param m Translation in moneyness
+ * @param sigma Smoothness of the vertex. Must be positive
+ * @throws std::invalid_argument If the expiry or sigma is not positive, or rho is outside (-1, 1)
+ */
+inline void VolSurface::svi(double T, double a, double b, double rho, double m, double sigma) {
+    if (T <= 0.0 || sigma <= 0.0 || std::abs(rho) >= 1.0) {
+        throw std::invalid_argument("SVI slices need a positive expiry and sigma, and rho in (-1, 1)");
+    }
+    insert(Slice{T, true, a, b, rho, m, sigma, 0, 0});
+}
+
+/**
+ * Add a slice from the volatilities of a set of moneyness nodes
+ * @note The total variance of each segment between nodes is stored as an intercept and a slope in k, so a lookup is
+ * one multiply and add. The variance is flat outside the nodes
+ * @param T Expiry of the slice. Must be positive
+ * @param moneyness Log forward moneyness log(K / F) of each node, strictly increasing
+ * @param vols Implied volatility of each node
+ * @throws std::invalid_argument If the expiry is not positive, the nodes are empty or differ in size, or the moneyness
+ * is not strictly increasing
+ */
+inline void VolSurface::grid(double T, const std::vector<double> &moneyness, const std::vector<double> &vols) {
+    std::size_t n = moneyness.size();
+    if (T <= 0.0 || n == 0 || vols.size() != n) {
+        throw std::invalid_argument("Grid slices need a positive expiry and one volatility per node");
+    }
+    for (std::size_t i = 1; i < n; ++i) {
+        if (moneyness[i] <= moneyness[i - 1]) {
+            throw std::invalid_argument("Grid slice moneyness must be strictly increasing");
+        }
+    }
+
+    Slice slice{T, false, 0.0, 0.0, 0.0, 0.0, 0.0, knots.size(), knots.size() + n + 1};
+
+    // Flat below the first node
+    knots.push_back(-std::numeric_limits<double>::infinity());
+    intercepts.push_back(vols[0] * vols[0] * T);
+    slopes.push_back(0.0);
+
+    for (std::size_t i = 1; i < n; ++i) {
+        double lower = vols[i - 1] * vols[i - 1] * T, upper = vols[i] * vols[i] * T;
+        double slope = (upper - lower) / (moneyness[i] - moneyness[i - 1]);
+        knots.push_back(moneyness[i - 1]);
+        intercepts.push_back(lower - slope * moneyness[i - 1]);
+        slopes.push_back(slope);
+    }
+
+    // Flat above the last node
+    knots.push_back(moneyness[n - 1]);
+    intercepts.push_back(vols[n - 1] * vols[n - 1] * T);
+    slopes.push_back(0.0);
+
+    insert(slice);
+}
+
+/*
+ * Insert a slice in expiry order, replacing any slice of the same expiry
+ * @note The segments of a replaced grid slice stay in the segment arrays and are no longer referenced
+ * @param slice The new slice
+ */
+inline void VolSurface::insert(const Slice &slice) {
+    auto it = std::lower_bound(slices.begin(), slices.end(), slice.T, [](const Slice &s, double T) {
+        return s.T < T;
+    });
+    if (it != slices.end() && it->T == slice.T) {
+        *it = slice;
+    } else {
+        slices.insert(it, slice);
+    }
+}
+
+/* ********************************************************************************************************************
+ * Lookups
+ *********************************************************************************************************************/
+
+/*
+ * Find the slices that bracket an expiry and the weight of each
+ * @note Before the first slice and after the last, both slices are the nearest one and the variance is scaled by the
+ * ratio of the expiries, which holds its volatility
+ * @param T Expiry
+ * @return The slices and the interpolation weight and scale
+ */
+inline VolSurface::Bracket VolSurface::bracket(double T) const {
+    std::size_t n = slices.size();
+    if (T <= slices.front().T) { return Bracket{0, 0, 0.0, T / slices.front().T}; }
+    if (T >= slices.back().T) { return Bracket{n - 1, n - 1, 0.0, T / slices.back().T}; }
+
+    std::size_t upper = std::upper_bound(slices.begin(), slices.end(), T, [](double t, const Slice &s) {
+        return t < s.T;
+    }) - slices.begin();
+    std::size_t lower = upper - 1;
+    return Bracket{lower, upper, (T - slices[lower].T) / (slices[upper].T - slices[lower].T), 1.0};
+}
+
+/*
+ * Find the grid segment that contains a moneyness, starting from the segment of the previous lookup
+ * @param slice A grid slice
+ * @param k Log forward moneyness
+ * @param hint Segment of the previous lookup on this slice, or any other value to force a binary search
+ * @return The last segment of the slice whose lower moneyness is at most k
+ */
+inline std::size_t VolSurface::segment(const Slice &slice, double k, std::size_t hint) const {
+    // Sorted rows stay on the segment of the previous row or move to the next one
+    if (hint >= slice.first && hint < slice.last && knots[hint] <= k) {
+        if (hint + 1 == slice.last || k < knots[hint + 1]) { return hint; }
+        if (hint + 2 == slice.last || k < knots[hint + 2]) { return hint + 1; }
+    }
+
+    return std::upper_bound(knots.begin() + slice.first + 1, knots.begin() + slice.last, k) - knots.begin() - 1;
+}
+
+/*
+ * Total variance of one slice
+ * @param slice The slice
+ * @param k Log forward moneyness
+ * @param hint Segment of the previous lookup on this slice. Receives the segment of this lookup
+ * @return The total implied variance
+ */
+inline double VolSurface::variance(const Slice &slice, double k, std::size_t &hint) const {
+    if (slice.svi) {
+        double x = k - slice.m;
+        return slice.a + slice.b * (slice.rho * x + std::sqrt(x * x + slice.sigma * slice.sigma));
+    }
+
+    hint = segment(slice, k, hint);
+    return intercepts[hint] + slopes[hint] * k;
+}
+
+/**
+ * Total implied variance at an expiry and moneyness
+ * @param T Expiry
+ * @param k Log forward moneyness log(K / F)
+ * @return sig^2 T
+ * @throws std::invalid_argument If the surface has no slices
+ */
+inline double VolSurface::variance(double T, double k) const {
+    if (slices.empty()) { throw std::invalid_argument("The surface has no slices"); }
+
+    Bracket at = bracket(T);
+    std::size_t lower = knots.size(), upper = knots.size();
+    double w = variance(slices[at.lower], k, lower);
+    if (at.weight > 0.0) {
+        w += at.weight * (variance(slices[at.upper], k, upper) - w);
+    }
+    return w * at.scale;
+}
+
+/**
+ * Implied volatility at an expiry and moneyness
+ * @param T Expiry. Must be positive
+ * @param k Log forward moneyness log(K / F)
+ * @return sqrt(w / T)
+ * @throws std::invalid_argument If the surface has no slices
+ */
+inline double VolSurface::vol(double T, double k) const { return std::sqrt(variance(T, k) / T); }
+
+/**
+ * Overwrite the volatility column of a batch with the implied volatility of each row
+ * @note The moneyness of a row is log(K / S) - bT, so the cost of carry column should be resolved first. The slice
+ * pair is found again only when the expiry changes from the previous row, and each slice keeps its own segment hint,
+ * so a batch sorted by expiry and strike costs one log, one square root, and a few comparisons per row
+ * @tparam Real Numeric type of the batch columns (double or float)
+ * @param batch Contiguous columns of option parameters (T, sig, r, S, K, b)
+ * @throws std::invalid_argument If the surface has no slices
+ */
+template<typename Real>
+void VolSurface::resolve(BasicOptionBatch<Real> &batch) const {
+    if (slices.empty()) { throw std::invalid_argument("The surface has no slices"); }
+
+    std::size_t n = batch.size();
+    const Real *T_ = batch.expiry().data(), *S_ = batch.spot().data(), *K_ = batch.strike().data();
+    const Real *b_ = batch.carry().data();
+    Real *sig_ = batch.vol().data();
+
+    Bracket at{0, 0, 0.0, 1.0};
+    double previous = std::numeric_limits<double>::quiet_NaN();
+    std::size_t lower = knots.size(), upper = knots.size();
+
+    for (std::size_t i = 0; i < n; ++i) {
+        double T = static_cast<double>(T_[i]);
+        if (T != previous) {
+            at = bracket(T);
+            previous = T;
+        }
+
+        double k = std::log(static_cast<double>(K_[i]) / static_cast<double>(S_[i])) - static_cast<double>(b_[i]) * T;
+        double w = variance(slices[at.lower], k, lower);
+        if (at.weight > 0.0) {
+            w += at.weight * (variance(slices[at.upper], k, upper) - w);
+        }
+        sig_[i] = static_cast<Real>(std::sqrt(w * at.scale / T));
+    }
+}
+
+/* ********************************************************************************************************************
+ * Accessors
+ *********************************************************************************************************************/
+
+/**
+ * Number of slices
+ * @return The number of expiries with a slice
+ */
+inline std::size_t VolSurface::size() const { return slices.size(); }
+
+#endif
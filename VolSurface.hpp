@@ -0,0 +1,80 @@
+/**********************************************************************************************************************
+ * Implied volatility surface of SVI or grid slices with batch lookups that resolve the volatility column of an
+ * OptionBatch
+ *
+ * @note Every slice gives the total implied variance w = sig^2 T of one expiry as a function of the log forward
+ * moneyness k = log(K / F), with F = S e^(bT). An SVI slice holds the raw parameters a, b, rho, m, and sigma of
+ * w(k) = a + b (rho (k - m) + sqrt((k - m)^2 + sigma^2)). A grid slice holds the volatilities of a set of moneyness
+ * nodes, converted once to the intercept and slope of the total variance on each segment between nodes and held flat
+ * outside them. Between slices the total variance is interpolated linearly in the expiry at a fixed k, which keeps a
+ * calendar arbitrage free pair of slices arbitrage free. Outside the slices the volatility of the nearest slice holds.
+ * A batch lookup keeps the slice pair and the segments of the previous row. Rows sorted by expiry and strike then
+ * find the pair once per expiry and step through the segments, and other rows fall back to a binary search
+ *********************************************************************************************************************/
+
+#ifndef VOLSURFACE_HPP
+#define VOLSURFACE_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "OptionBatch.hpp"
+
+class VolSurface {
+private:
+    // Total variance of one expiry
+    struct Slice {
+        double T;                                // Expiry
+        bool svi;                                // SVI parameters, or grid segments
+        double a, b, rho, m, sigma;              // Raw SVI parameters
+        std::size_t first, last;                 // Grid segments of this slice
+    };
+
+    // Interpolation between the two slices that bracket an expiry
+    struct Bracket {
+        std::size_t lower, upper;                // Slices below and above the expiry
+        double weight;                           // Weight of the upper slice
+        double scale;                            // Factor applied to the interpolated variance outside the slices
+    };
+
+    std::vector<Slice> slices;                   // Sorted by expiry
+    std::vector<double> knots;                   // Lower moneyness of each grid segment
+    std::vector<double> intercepts;              // Total variance at k = 0 of each grid segment
+    std::vector<double> slopes;                  // Slope of the total variance in k of each grid segment
+
+    // Helper functions
+    void insert(const Slice& slice);
+    Bracket bracket(double T) const;
+    std::size_t segment(const Slice& slice, double k, std::size_t hint) const;
+    double variance(const Slice& slice, double k, std::size_t& hint) const;
+
+public:
+    // Constructors and destructors
+    VolSurface();
+    VolSurface(const VolSurface& source);
+    virtual ~VolSurface();
+
+    // Operator overloading
+    VolSurface& operator=(const VolSurface& source);
+
+    // Add a slice. A slice replaces any slice of the same expiry
+    void svi(double T, double a, double b, double rho, double m, double sigma);
+    void grid(double T, const std::vector<double>& moneyness, const std::vector<double>& vols);
+
+    // Single lookups
+    double variance(double T, double k) const;
+    double vol(double T, double k) const;
+
+    // Batch lookup of the volatility column of a batch from its T, S, K, and b columns
+    template<typename Real>
+    void resolve(BasicOptionBatch<Real>& batch) const;
+
+    // Accessors
+    std::size_t size() const;
+};
+
+#ifndef VOLSURFACE_CPP
+#include "VolSurface.cpp"
+
+#endif // VOLSURFACE_CPP
+#endif // VOLSURFACE_HPP
@@ -0,0 +1,185 @@
+/**********************************************************************************************************************
+ * Zero rate curve with batch lookups that resolve the rate columns of an OptionBatch
+ *********************************************************************************************************************/
+
+#ifndef YIELDCURVE_CPP
+#define YIELDCURVE_CPP
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "YieldCurve.hpp"
+
+/**
+ * Initialize a new YieldCurve whose zero rate is zero at every time
+ * @throws OutOfMemoryError Indicates insufficient memory for this new YieldCurve
+ */
+inline YieldCurve::YieldCurve() : knots(1, 0.0), forwards(1, 0.0), intercepts(1, 0.0) {}
+
+/**
+ * Initialize a new YieldCurve whose data members are a copy of the source
+ * @param source A YieldCurve whose data members will be copied
+ * @throws OutOfMemoryError Indicates insufficient memory for this new YieldCurve
+ */
+inline YieldCurve::YieldCurve(const YieldCurve &source) : knots(source.knots), forwards(source.forwards),
+intercepts(source.intercepts) {}
+
+/**
+ * Initialize a new YieldCurve from its nodes and precompute the coefficients of every segment
+ * @param times Times of the nodes in years. Must be positive and strictly increasing
+ * @param zeros Continuously compounded zero rate of each node
+ * @throws std::invalid_argument If the nodes are empty, differ in size, or are not strictly increasing
+ */
+inline YieldCurve::YieldCurve(const std::vector<double> &times, const std::vector<double> &zeros) : knots(),
+forwards(), intercepts() {
+
+    std::size_t n = times.size();
+    if (n == 0 || zeros.size() != n) { throw std::invalid_argument("A curve needs one zero rate per node"); }
+    for (std::size_t i = 0; i < n; ++i) {
+        if (times[i] <= (i == 0 ? 0.0 : times[i - 1])) {
+            throw std::invalid_argument("Curve node times must be positive and strictly increasing");
+        }
+    }
+
+    knots.reserve(n + 1);
+    forwards.reserve(n + 1);
+    intercepts.reserve(n + 1);
+
+    // Flat zero rate before the first node
+    knots.push_back(0.0);
+    forwards.push_back(zeros[0]);
+    intercepts.push_back(0.0);
+
+    for (std::size_t i = 1; i < n; ++i) {
+        double f = (zeros[i] * times[i] - zeros[i - 1] * times[i - 1]) / (times[i] - times[i - 1]);
+        knots.push_back(times[i - 1]);
+        forwards.push_back(f);
+        intercepts.push_back(zeros[i - 1] * times[i - 1] - f * times[i - 1]);
+    }
+
+    // The last forward rate continues after the last node
+    knots.push_back(times[n - 1]);
+    forwards.push_back(forwards.back());
+    intercepts.push_back(zeros[n - 1] * times[n - 1] - forwards.back() * times[n - 1]);
+}
+
+/**
+ * Destroy this YieldCurve
+ */
+inline YieldCurve::~YieldCurve() {}
+
+/**
+ * Copy the source data members into this YieldCurve
+ * @param source A YieldCurve whose data members will be copied
+ * @return This YieldCurve whose data members are a copy of the source data members
+ */
+inline YieldCurve& YieldCurve::operator=(const YieldCurve &source) {
+    // Avoid self assign
+    if (this == &source) { return *this; }
+
+    knots = source.knots;
+    forwards = source.forwards;
+    intercepts = source.intercepts;
+
+    return *this;
+}
+
+/* ********************************************************************************************************************
+ * Lookups
+ *********************************************************************************************************************/
+
+/*
+ * Find the segment that contains a time, starting from the segment of the previous lookup
+ * @param t Time in years
+ * @param hint Segment of the previous lookup, or any value past the last segment to force a binary search
+ * @return The last segment whose lower time is at most t, or the first segment for negative times
+ */
+inline std::size_t YieldCurve::segment(double t, std::size_t hint) const {
+    std::size_t n = knots.size();
+
+    // Sorted rows stay on the segment of the previous row or move to the next one
+    if (hint < n && knots[hint] <= t) {
+        if (hint + 1 == n || t < knots[hint + 1]) { return hint; }
+        if (hint + 2 == n || t < knots[hint + 2]) { return hint + 1; }
+    }
+
+    std::size_t above = std::upper_bound(knots.begin(), knots.end(), t) - knots.begin();
+    return above == 0 ? 0 : above - 1;
+}
+
+/**
+ * Zero rate at a time
+ * @param t Time in years
+ * @return The continuously compounded zero rate
+ */
+inline double YieldCurve::rate(double t) const {
+    std::size_t s = segment(t, knots.size());
+    return t > 0.0 ? intercepts[s] / t + forwards[s] : forwards[s];
+}
+
+/**
+ * Discount factor to a time
+ * @param t Time in years
+ * @return e^(-z(t) t)
+ */
+inline double YieldCurve::discount(double t) const {
+    std::size_t s = segment(t, knots.size());
+    return std::exp(-(intercepts[s] + forwards[s] * t));
+}
+
+/*
+ * Zero rates of a column of times
+ * @note Rows sorted by time walk the segments once. Rows of one expiry repeat the segment of the previous row
+ * @tparam Real Numeric type of the columns (double or float)
+ * @param T Times in years
+ * @param z Receives the zero rate of each time. Resized to the size of T
+ */
+template<typename Real>
+void YieldCurve::lookup(const std::vector<Real> &T, std::vector<Real> &z) const {
+    std::size_t n = T.size();
+    z.resize(n);
+
+    const double *c = intercepts.data(), *f = forwards.data();
+    std::size_t s = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        double t = static_cast<double>(T[i]);
+        s = segment(t, s);
+        z[i] = static_cast<Real>(t > 0.0 ? c[s] / t + f[s] : f[s]);
+    }
+}
+
+/**
+ * Zero rates of a column of times
+ * @param T Times in years, ideally sorted
+ * @param z Receives the zero rate of each time. Resized to the size of T
+ */
+inline void YieldCurve::rates(const std::vector<double> &T, std::vector<double> &z) const { lookup(T, z); }
+
+/**
+ * Overwrite the risk-free rate column of a batch with the zero rate of the expiry of each row
+ * @tparam Real Numeric type of the batch columns (double or float)
+ * @param batch Contiguous columns of option parameters (T, sig, r, S, K, b)
+ */
+template<typename Real>
+void YieldCurve::resolveRiskFree(BasicOptionBatch<Real> &batch) const { lookup(batch.expiry(), batch.riskFree()); }
+
+/**
+ * Overwrite the cost of carry column of a batch with the rate of this curve at the expiry of each row
+ * @tparam Real Numeric type of the batch columns (double or float)
+ * @param batch Contiguous columns of option parameters (T, sig, r, S, K, b)
+ */
+template<typename Real>
+void YieldCurve::resolveCarry(BasicOptionBatch<Real> &batch) const { lookup(batch.expiry(), batch.carry()); }
+
+/* ********************************************************************************************************************
+ * Accessors
+ *********************************************************************************************************************/
+
+/**
+ * Number of segments, including the flat segment before the first node and the segment after the last node
+ * @return The number of segments
+ */
+inline std::size_t YieldCurve::segments() const { return knots.size(); }
+
+#endif
@@ -0,0 +1,60 @@
+/**********************************************************************************************************************
+ * Zero rate curve with batch lookups that resolve the rate columns of an OptionBatch
+ *
+ * @note Zero rates z are continuously compounded and interpolated linearly in z t, which holds the forward rate
+ * constant between nodes. Each segment stores its forward rate f and intercept c, so a lookup is z(t) = c / t + f.
+ * Before the first node the zero rate is flat and after the last node the last forward rate continues. A batch lookup
+ * tries the segment of the previous row and the one after it, so rows sorted by expiry cost a comparison or two each
+ * and other rows fall back to a binary search. The same curve type serves cost of carry, e.g. r - q nodes for a
+ * dividend paying underlying
+ *********************************************************************************************************************/
+
+#ifndef YIELDCURVE_HPP
+#define YIELDCURVE_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "OptionBatch.hpp"
+
+class YieldCurve {
+private:
+    std::vector<double> knots;                   // Lower time of each segment. The first segment starts at zero
+    std::vector<double> forwards;                // Forward rate f of each segment
+    std::vector<double> intercepts;              // Intercept c of each segment, with z t = c + f t
+
+    // Helper functions
+    std::size_t segment(double t, std::size_t hint) const;
+    template<typename Real>
+    void lookup(const std::vector<Real>& T, std::vector<Real>& z) const;
+
+public:
+    // Constructors and destructors
+    YieldCurve();
+    YieldCurve(const YieldCurve& source);
+    YieldCurve(const std::vector<double>& times, const std::vector<double>& zeros);
+    virtual ~YieldCurve();
+
+    // Operator overloading
+    YieldCurve& operator=(const YieldCurve& source);
+
+    // Single lookups
+    double rate(double t) const;
+    double discount(double t) const;
+
+    // Batch lookups over an expiry column, and the risk-free rate or cost of carry column of a batch from its expiries
+    void rates(const std::vector<double>& T, std::vector<double>& z) const;
+    template<typename Real>
+    void resolveRiskFree(BasicOptionBatch<Real>& batch) const;
+    template<typename Real>
+    void resolveCarry(BasicOptionBatch<Real>& batch) const;
+
+    // Accessors
+    std::size_t segments() const;
+};
+
+#ifndef YIELDCURVE_CPP
+#include "YieldCurve.cpp"
+
+#endif // YIELDCURVE_CPP
+#endif // YIELDCURVE_HPP